@@ -5,39 +5,38 @@
 
 #include "about_scene.h"
 #include "scenes.h"
+#include "scene_views.h"
+
+/** @brief About screen text, kept in flash */
+static const char dht11_about_text[] =
+    "DHT11 Temperature & Humidity Sensor\n"
+    "Version: 1.0\n\n"
+    "PINOUT:\n"
+    "VCC  -> 3.3V (Pin 9)\n"
+    "DATA -> C0   (Pin 16)\n"
+    "GND  -> GND  (Pin 8/11)\n\n"
+    "SPECIFICATIONS:\n"
+    "Temperature: 0-50°C (±2°C)\n"
+    "Humidity: 20-90% (±5%)\n\n"
+    "USAGE:\n"
+    "1. Connect DHT11 sensor\n"
+    "2. Go to 'Read Sensor'\n"
+    "3. Press OK to read\n"
+    "4. View temperature/humidity\n\n"
+    "TROUBLESHOOTING:\n"
+    "- Check connections\n"
+    "- Ensure 3.3V power supply\n"
+    "- Verify C0 pin wiring\n"
+    "- Wait 1-2 seconds between reads\n"
+    "- Use debug mode for details\n\n"
+    "Built for Flipper Zero\n"
+    "Educational purposes";
 
 void dht11_scene_about_on_enter(void* context) {
     DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneAbout);
     
-    if(!app->about_text) {
-        app->about_text = malloc(2048);
-        snprintf(app->about_text, 2048,
-            "DHT11 Temperature & Humidity Sensor\n"
-            "Version: 1.0\n\n"
-            "PINOUT:\n"
-            "VCC  -> 3.3V (Pin 9)\n"
-            "DATA -> C0   (Pin 16)\n"
-            "GND  -> GND  (Pin 8/11)\n\n"
-            "SPECIFICATIONS:\n"
-            "Temperature: 0-50°C (±2°C)\n"
-            "Humidity: 20-90%% (±5%%)\n\n"
-            "USAGE:\n"
-            "1. Connect DHT11 sensor\n"
-            "2. Go to 'Read Sensor'\n"
-            "3. Press OK to read\n"
-            "4. View temperature/humidity\n\n"
-            "TROUBLESHOOTING:\n"
-            "- Check connections\n"
-            "- Ensure 3.3V power supply\n"
-            "- Verify C0 pin wiring\n"
-            "- Wait 1-2 seconds between reads\n"
-            "- Use debug mode for details\n\n"
-            "Built for Flipper Zero\n"
-            "Educational purposes"
-        );
-    }
-    
-    text_box_set_text(app->about_text_box, app->about_text);
+    text_box_set_text(app->about_text_box, dht11_about_text);
     text_box_set_font(app->about_text_box, TextBoxFontText);
     view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneAbout);
 }
@@ -57,4 +56,5 @@ bool dht11_scene_about_on_event(void* context, SceneManagerEvent event) {
 void dht11_scene_about_on_exit(void* context) {
     DHT11App* app = context;
     text_box_reset(app->about_text_box);
+    dht11_scene_view_release(app, DHT11SceneAbout);
 }
@@ -0,0 +1,262 @@
+/**
+ * @file acquisition.c
+ * @brief Background sensor acquisition thread implementation
+ */
+
+#include "acquisition.h"
+#include "sensor.h"
+
+/** @brief Room for the storage calls of alert events */
+#define DHT11_ACQUISITION_STACK_SIZE 2048
+
+/** @brief Worker thread flags */
+typedef enum {
+    DHT11AcquisitionFlagStop = (1 << 0),       /**< Exit the worker loop */
+    DHT11AcquisitionFlagTrigger = (1 << 1),    /**< Sample as soon as possible */
+} DHT11AcquisitionFlag;
+
+#define DHT11_ACQUISITION_FLAGS_ALL (DHT11AcquisitionFlagStop | DHT11AcquisitionFlagTrigger)
+
+/**
+ * @brief Publish the outcome of a sensor's last read and plan its next one
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param index Index of the sensor that was read
+ * @param tick Tick at which the read started
+ * @param reading Reading taken under the driver lock
+ */
+static void dht11_acquisition_publish(
+    DHT11Acquisition* acquisition,
+    uint8_t index,
+    uint32_t tick,
+    const DHT11Reading* reading) {
+    DHT11App* app = acquisition->app;
+    const DHT11Result* result = &reading->last;
+    DHT11Sample sample = {0};
+    
+    // Garbled reads are retried early, silent sensors backed off
+    uint32_t delay = dht11_retry_record(
+        &acquisition->retry[index],
+        result->status,
+        acquisition->scheduler.period,
+        acquisition->scheduler.min_interval[index]);
+    if(delay) {
+        dht11_scheduler_defer(&acquisition->scheduler, index, tick, delay);
+    } else {
+        dht11_scheduler_complete(&acquisition->scheduler, index, tick);
+    }
+    
+    bool ok = result->status == DHT11StatusOk;
+    sample.tick = tick;
+    sample.sensor = index;
+    sample.ok = ok;
+    sample.status = result->status;
+    sample.failed_bit = result->failed_bit;
+    sample.recovered_bits = result->recovered_bits;
+    if(ok) {
+        sample.temperature = reading->temperature;
+        sample.humidity = reading->humidity;
+        dht11_filter_apply(
+            &acquisition->filter[index],
+            &acquisition->filter_config,
+            tick,
+            &sample.temperature,
+            &sample.humidity);
+    }
+    
+    dht11_sample_buffer_push(&acquisition->samples, &sample);
+    dht11_history_add(app->history, &sample);
+    dht11_alert_evaluate(app->alerts, &sample);
+}
+
+/**
+ * @brief Read every due sensor and publish the results
+ * 
+ * A single due sensor is read on its own; several are read as one batch.
+ * Only sensors that actually went on the bus publish a sample and have
+ * their next read planned from the outcome. The others were turned away
+ * by the cache, whose interval runs from the tick the last transaction
+ * actually started on rather than from the scheduler's, and are tried
+ * again as soon as that interval has passed.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param due_mask Bit mask of sensors to read
+ * @param tick Tick at which the read started
+ */
+static void dht11_acquisition_sample(DHT11Acquisition* acquisition, uint8_t due_mask, uint32_t tick) {
+    DHT11App* app = acquisition->app;
+    
+    if((due_mask & (due_mask - 1)) == 0) {
+        uint8_t index = __builtin_ctz(due_mask);
+        DHT11Reading reading;
+        dht11_sensor_get_reading(app, &app->sensors[index], &reading);
+        if(reading.fresh) {
+            dht11_acquisition_publish(acquisition, index, tick, &reading);
+            due_mask = 0;
+        }
+    } else {
+        uint8_t read_mask = 0;
+        DHT11Reading readings[DHT11_MAX_SENSORS];
+        dht11_sensor_read_batch(app, due_mask, &read_mask, readings);
+        for(uint8_t i = 0; i < app->sensor_count; i++) {
+            if(read_mask & (1 << i)) {
+                dht11_acquisition_publish(acquisition, i, tick, &readings[i]);
+            }
+        }
+        due_mask &= ~read_mask;
+    }
+    
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        if(due_mask & (1 << i)) {
+            uint32_t wait = dht11_driver_wait_ticks(app->sensors[i].driver);
+            dht11_scheduler_postpone(&acquisition->scheduler, i, furi_get_tick(), wait);
+        }
+    }
+    
+    if(acquisition->callback) {
+        acquisition->callback(acquisition->callback_context);
+    }
+}
+
+/**
+ * @brief Worker thread body
+ * 
+ * Sleeps until the earliest sensor deadline or a trigger. The scheduler
+ * guarantees no sensor is read sooner than its family's minimum interval
+ * after its previous transaction.
+ * 
+ * @param context Pointer to the acquisition state
+ * @return Always returns 0
+ */
+static int32_t dht11_acquisition_worker(void* context) {
+    DHT11Acquisition* acquisition = context;
+    DHT11App* app = acquisition->app;
+    DHT11Scheduler* scheduler = &acquisition->scheduler;
+    uint32_t period = furi_ms_to_ticks(acquisition->period_ms);
+    uint32_t min_intervals[DHT11_MAX_SENSORS];
+    
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        min_intervals[i] = furi_ms_to_ticks(app->sensors[i].driver->protocol->min_interval_ms);
+    }
+    
+    dht11_scheduler_init(
+        scheduler,
+        app->sensor_count,
+        period,
+        min_intervals,
+        furi_get_tick(),
+        !acquisition->batch);
+    for(uint8_t i = 0; i < DHT11_SCHEDULER_MAX_SENSORS; i++) {
+        dht11_retry_reset(&acquisition->retry[i]);
+        dht11_filter_reset(&acquisition->filter[i]);
+    }
+    
+    while(app->sensor_count > 0) {
+        uint32_t due = 0;
+        uint8_t index = dht11_scheduler_next(scheduler, &due);
+        uint32_t now = furi_get_tick();
+        uint32_t wait = (int32_t)(due - now) > 0 ? due - now : 0;
+        
+        uint32_t flags = furi_thread_flags_wait(DHT11_ACQUISITION_FLAGS_ALL, FuriFlagWaitAny, wait);
+        if(!(flags & FuriFlagError)) {
+            if(flags & DHT11AcquisitionFlagStop) {
+                break;
+            }
+            if(flags & DHT11AcquisitionFlagTrigger) {
+                dht11_scheduler_trigger(scheduler, furi_get_tick());
+                continue;
+            }
+        }
+        
+        now = furi_get_tick();
+        if((int32_t)(due - now) > 0) {
+            continue;
+        }
+        
+        // Pick up period changes from other threads
+        if(furi_ms_to_ticks(acquisition->period_ms) != period) {
+            period = furi_ms_to_ticks(acquisition->period_ms);
+            dht11_scheduler_set_period(scheduler, period);
+        }
+        
+        // Batch mode sweeps up every sensor that is due alongside this one
+        uint8_t due_mask = acquisition->batch ? dht11_scheduler_due_mask(scheduler, now) :
+                                                (1 << index);
+        dht11_acquisition_sample(acquisition, due_mask, now);
+    }
+    
+    // No sensors configured: idle until asked to stop
+    if(app->sensor_count == 0) {
+        furi_thread_flags_wait(DHT11AcquisitionFlagStop, FuriFlagWaitAny, FuriWaitForever);
+    }
+    
+    return 0;
+}
+
+DHT11Acquisition* dht11_acquisition_alloc(void* app) {
+    DHT11Acquisition* acquisition = malloc(sizeof(DHT11Acquisition));
+    acquisition->app = app;
+    acquisition->period_ms = DHT11_ACQUISITION_PERIOD_MS;
+    acquisition->batch = DHT11_ACQUISITION_BATCH;
+    acquisition->callback = NULL;
+    dht11_filter_config_default(&acquisition->filter_config);
+    acquisition->callback_context = NULL;
+    dht11_sample_buffer_reset(&acquisition->samples);
+    
+    acquisition->thread = furi_thread_alloc_ex(
+        "Dht11Acquisition", DHT11_ACQUISITION_STACK_SIZE, dht11_acquisition_worker, acquisition);
+    
+    return acquisition;
+}
+
+void dht11_acquisition_free(DHT11Acquisition* acquisition) {
+    furi_assert(acquisition);
+    furi_thread_free(acquisition->thread);
+    free(acquisition);
+}
+
+void dht11_acquisition_set_callback(
+    DHT11Acquisition* acquisition,
+    DHT11AcquisitionCallback callback,
+    void* context) {
+    furi_assert(acquisition);
+    acquisition->callback = callback;
+    acquisition->callback_context = context;
+}
+
+void dht11_acquisition_start(DHT11Acquisition* acquisition) {
+    furi_assert(acquisition);
+    furi_thread_start(acquisition->thread);
+}
+
+void dht11_acquisition_stop(DHT11Acquisition* acquisition) {
+    furi_assert(acquisition);
+    furi_thread_flags_set(furi_thread_get_id(acquisition->thread), DHT11AcquisitionFlagStop);
+    furi_thread_join(acquisition->thread);
+}
+
+void dht11_acquisition_set_period(DHT11Acquisition* acquisition, uint32_t period_ms) {
+    furi_assert(acquisition);
+    acquisition->period_ms = MAX(period_ms, (uint32_t)DHT11_MIN_INTERVAL_MS);
+}
+
+void dht11_acquisition_set_batch(DHT11Acquisition* acquisition, bool batch) {
+    furi_assert(acquisition);
+    acquisition->batch = batch;
+}
+
+void dht11_acquisition_set_filter(DHT11Acquisition* acquisition, const DHT11FilterConfig* config) {
+    furi_assert(acquisition);
+    furi_assert(config);
+    acquisition->filter_config = *config;
+}
+
+void dht11_acquisition_trigger(DHT11Acquisition* acquisition) {
+    furi_assert(acquisition);
+    furi_thread_flags_set(furi_thread_get_id(acquisition->thread), DHT11AcquisitionFlagTrigger);
+}
+
+bool dht11_acquisition_latest(DHT11Acquisition* acquisition, uint8_t sensor, DHT11Sample* sample) {
+    furi_assert(acquisition);
+    return dht11_sample_buffer_latest_for(&acquisition->samples, sensor, sample);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file acquisition.h
+ * @brief Background sensor acquisition thread
+ * 
+ * Samples every attached sensor on a fixed period from a dedicated thread,
+ * independent of the GUI, and publishes every result into a sample ring
+ * buffer. Reads of different sensors are interleaved by the scheduler.
+ * Good readings pass through the filter chain on the way, so scenes, the
+ * logger and the beacon all see the filtered stream.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include "sample_buffer.h"
+#include "scheduler.h"
+#include "retry.h"
+#include "filter.h"
+#include "sensor_cache.h"
+
+/** @brief Default sampling period of each sensor */
+#define DHT11_ACQUISITION_PERIOD_MS 1000
+
+/** @brief Read all sensors as one batch by default */
+#define DHT11_ACQUISITION_BATCH false
+
+/**
+ * @brief Callback invoked from the acquisition thread after each sample
+ * 
+ * @param context User context
+ */
+typedef void (*DHT11AcquisitionCallback)(void* context);
+
+/**
+ * @brief Acquisition thread state
+ */
+typedef struct {
+    FuriThread* thread;                 /**< Worker thread */
+    void* app;                          /**< Application instance passed to the driver */
+    volatile uint32_t period_ms;        /**< Sampling period of each sensor */
+    bool batch;                         /**< Read all sensors together instead of interleaving */
+    DHT11Scheduler scheduler;           /**< Read order across sensors, worker thread only */
+    DHT11Retry retry[DHT11_SCHEDULER_MAX_SENSORS];  /**< Retry and backoff state of each sensor */
+    DHT11FilterConfig filter_config;    /**< Filter chain settings */
+    DHT11Filter filter[DHT11_SCHEDULER_MAX_SENSORS];    /**< Filter state of each sensor */
+    DHT11SampleBuffer samples;          /**< Published samples */
+    DHT11AcquisitionCallback callback;  /**< New sample notification */
+    void* callback_context;             /**< Context for the notification */
+} DHT11Acquisition;
+
+/**
+ * @brief Allocate the acquisition thread
+ * 
+ * @param app Pointer to the application instance (DHT11App*)
+ * @return Pointer to the allocated acquisition state
+ */
+DHT11Acquisition* dht11_acquisition_alloc(void* app);
+
+/**
+ * @brief Free the acquisition thread
+ * 
+ * The thread must be stopped first.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ */
+void dht11_acquisition_free(DHT11Acquisition* acquisition);
+
+/**
+ * @brief Set the function called after each new sample
+ * 
+ * The callback runs on the acquisition thread and must not block.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param callback Callback function, or NULL to disable
+ * @param context Context passed to the callback
+ */
+void dht11_acquisition_set_callback(
+    DHT11Acquisition* acquisition,
+    DHT11AcquisitionCallback callback,
+    void* context);
+
+/**
+ * @brief Start sampling
+ * 
+ * @param acquisition Pointer to the acquisition state
+ */
+void dht11_acquisition_start(DHT11Acquisition* acquisition);
+
+/**
+ * @brief Stop sampling and wait for the thread to exit
+ * 
+ * @param acquisition Pointer to the acquisition state
+ */
+void dht11_acquisition_stop(DHT11Acquisition* acquisition);
+
+/**
+ * @brief Change the sampling period
+ * 
+ * Takes effect after the next sample. Clamped to DHT11_MIN_INTERVAL_MS;
+ * sensors whose family needs a longer interval are read at most that often.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param period_ms New sampling period
+ */
+void dht11_acquisition_set_period(DHT11Acquisition* acquisition, uint32_t period_ms);
+
+/**
+ * @brief Choose between interleaved and batch reads
+ * 
+ * In batch mode all sensors are read together once per period with
+ * dht11_sensor_read_batch(). Must be called before the thread is started.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param batch true for batch reads, false to interleave single reads
+ */
+void dht11_acquisition_set_batch(DHT11Acquisition* acquisition, bool batch);
+
+/**
+ * @brief Change the filter chain settings
+ * 
+ * Takes effect from the next sample. The filter state of every sensor is
+ * cleared when the thread starts. Must be called while the thread is
+ * stopped.
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param config New filter settings
+ */
+void dht11_acquisition_set_filter(DHT11Acquisition* acquisition, const DHT11FilterConfig* config);
+
+/**
+ * @brief Request a sample of every sensor as soon as each one allows it
+ * 
+ * @param acquisition Pointer to the acquisition state
+ */
+void dht11_acquisition_trigger(DHT11Acquisition* acquisition);
+
+/**
+ * @brief Copy the most recent sample of a sensor
+ * 
+ * @param acquisition Pointer to the acquisition state
+ * @param sensor Index of the sensor
+ * @param sample Output for the newest sample of that sensor
+ * @return true if a sample was available
+ */
+bool dht11_acquisition_latest(DHT11Acquisition* acquisition, uint8_t sensor, DHT11Sample* sample);
@@ -0,0 +1,274 @@
+/**
+ * @file alert.c
+ * @brief Threshold alert engine implementation
+ */
+
+#include "alert.h"
+#include "psychro.h"
+#include "format.h"
+#include <furi_hal.h>
+
+/** @brief Longest event line */
+#define DHT11_ALERT_LINE_SIZE 64
+
+/** @brief Event file column names, written when the file is new */
+#define DHT11_ALERT_CSV_HEADER "timestamp,sensor,quantity,event,value,threshold\n"
+
+const DHT11AlertRule dht11_alert_default_rules[DHT11_ALERT_MAX_RULES] = {
+    {true, DHT11AlertQuantityTemperature, true, 300, 10, 60000},
+    {true, DHT11AlertQuantityTemperature, false, 20, 10, 60000},
+    {true, DHT11AlertQuantityHumidity, true, 800, 50, 60000},
+    {true, DHT11AlertQuantityHeatIndex, true, 320, 10, 60000},
+    {true, DHT11AlertQuantityRate, true, 20, 5, 0},
+};
+
+static const char* const dht11_alert_quantity_names[DHT11AlertQuantityCount] = {
+    "temperature",
+    "humidity",
+    "heat_index",
+    "rate",
+};
+
+DHT11AlertEngine* dht11_alert_alloc(void) {
+    DHT11AlertEngine* engine = malloc(sizeof(DHT11AlertEngine));
+    memset(engine, 0, sizeof(DHT11AlertEngine));
+    memcpy(engine->rules, dht11_alert_default_rules, sizeof(engine->rules));
+    engine->actions = DHT11_ALERT_DEFAULT_ACTIONS;
+    engine->notifications = furi_record_open(RECORD_NOTIFICATION);
+    engine->storage = furi_record_open(RECORD_STORAGE);
+    return engine;
+}
+
+void dht11_alert_free(DHT11AlertEngine* engine) {
+    furi_assert(engine);
+    furi_record_close(RECORD_STORAGE);
+    furi_record_close(RECORD_NOTIFICATION);
+    free(engine);
+}
+
+void dht11_alert_set_enabled(DHT11AlertEngine* engine, bool enabled) {
+    furi_assert(engine);
+    
+    if(enabled && !engine->enabled) {
+        memset(engine->state, 0, sizeof(engine->state));
+        memset(engine->rate, 0, sizeof(engine->rate));
+        engine->triggered = 0;
+    }
+    engine->enabled = enabled;
+}
+
+void dht11_alert_set_rule(DHT11AlertEngine* engine, uint8_t index, const DHT11AlertRule* rule) {
+    furi_assert(engine);
+    furi_check(index < DHT11_ALERT_MAX_RULES);
+    engine->rules[index] = *rule;
+}
+
+/**
+ * @brief Append one event line to the event file
+ * 
+ * Triggers are rare, so the file is opened for every event rather than
+ * kept open.
+ * 
+ * @param engine Pointer to the engine
+ * @param sample Sample that changed the rule state
+ * @param rule Rule that changed state
+ * @param active true when the rule triggered, false when it cleared
+ * @param value Value of the watched quantity, in tenths
+ */
+static void dht11_alert_log(
+    DHT11AlertEngine* engine,
+    const DHT11Sample* sample,
+    const DHT11AlertRule* rule,
+    bool active,
+    int32_t value) {
+    File* file = storage_file_alloc(engine->storage);
+    
+    if(storage_file_open(file, DHT11_ALERT_EVENTS_PATH, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        char line[DHT11_ALERT_LINE_SIZE];
+        char value_text[DHT11_FORMAT_FIXED_SIZE];
+        char threshold_text[DHT11_FORMAT_FIXED_SIZE];
+        bool ok = true;
+        
+        if(storage_file_size(file) == 0) {
+            size_t length = strlen(DHT11_ALERT_CSV_HEADER);
+            ok = storage_file_write(file, DHT11_ALERT_CSV_HEADER, length) == length;
+        }
+        
+        dht11_format_fixed(value_text, sizeof(value_text), value, 1);
+        dht11_format_fixed(threshold_text, sizeof(threshold_text), rule->threshold, 1);
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "%lu,%u,%s,%s,%s,%s\n",
+            (unsigned long)furi_hal_rtc_get_timestamp(),
+            sample->sensor,
+            dht11_alert_quantity_name(rule->quantity),
+            active ? "trigger" : "clear",
+            value_text,
+            threshold_text);
+        length = MIN((size_t)length, sizeof(line) - 1);
+        ok = ok && storage_file_write(file, line, length) == (size_t)length;
+        
+        if(!ok) {
+            engine->write_errors++;
+        }
+        storage_file_close(file);
+    } else {
+        engine->write_errors++;
+    }
+    
+    storage_file_free(file);
+}
+
+/**
+ * @brief Play the configured trigger sequences
+ * 
+ * notification_message() only queues the sequence, so this does not hold
+ * up the acquisition thread.
+ * 
+ * @param engine Pointer to the engine
+ */
+static void dht11_alert_notify(DHT11AlertEngine* engine) {
+    if(engine->actions & DHT11AlertActionVibrate) {
+        notification_message(engine->notifications, &sequence_double_vibro);
+    }
+    if(engine->actions & DHT11AlertActionLed) {
+        notification_message(engine->notifications, &sequence_blink_red_100);
+    }
+    if(engine->actions & DHT11AlertActionSound) {
+        notification_message(engine->notifications, &sequence_error);
+    }
+}
+
+/**
+ * @brief Update the rate of change measurement of a sensor
+ * 
+ * The rate is the change between the first readings of consecutive
+ * windows, which smooths out the one-count steps of the sensor.
+ * 
+ * @param rate Rate measurement of the sensor
+ * @param sample New good sample
+ */
+static void dht11_alert_update_rate(DHT11AlertRate* rate, const DHT11Sample* sample) {
+    uint32_t window = furi_ms_to_ticks(DHT11_ALERT_RATE_WINDOW_MS);
+    
+    if(!rate->primed) {
+        rate->primed = true;
+        rate->reference_temperature = sample->temperature;
+        rate->reference_tick = sample->tick;
+        return;
+    }
+    
+    uint32_t elapsed = sample->tick - rate->reference_tick;
+    if(elapsed < window) {
+        return;
+    }
+    
+    uint64_t ticks_per_minute = (uint64_t)furi_kernel_get_tick_frequency() * 60;
+    rate->rate = abs(sample->temperature - rate->reference_temperature) * ticks_per_minute / elapsed;
+    rate->valid = true;
+    rate->reference_temperature = sample->temperature;
+    rate->reference_tick = sample->tick;
+}
+
+/**
+ * @brief Get the value a rule watches from a sample
+ * 
+ * @param engine Pointer to the engine
+ * @param sample Good sample
+ * @param quantity Watched quantity
+ * @param value Output for the value, in tenths
+ * @return false if the value is unknown, e.g. outside the heat index table
+ */
+static bool dht11_alert_value(
+    const DHT11AlertEngine* engine,
+    const DHT11Sample* sample,
+    DHT11AlertQuantity quantity,
+    int32_t* value) {
+    switch(quantity) {
+    case DHT11AlertQuantityTemperature:
+        *value = sample->temperature;
+        return true;
+    case DHT11AlertQuantityHumidity:
+        *value = sample->humidity;
+        return true;
+    case DHT11AlertQuantityHeatIndex: {
+        DHT11Psychro psychro;
+        if(!dht11_psychro_lookup_tenths(sample->humidity, sample->temperature, &psychro)) {
+            return false;
+        }
+        *value = psychro.heat_index;
+        return true;
+    }
+    case DHT11AlertQuantityRate:
+        *value = engine->rate[sample->sensor].rate;
+        return engine->rate[sample->sensor].valid;
+    default:
+        return false;
+    }
+}
+
+void dht11_alert_evaluate(DHT11AlertEngine* engine, const DHT11Sample* sample) {
+    furi_assert(engine);
+    
+    if(!engine->enabled || !sample->ok || sample->sensor >= DHT11_ALERT_MAX_SENSORS) {
+        return;
+    }
+    
+    dht11_alert_update_rate(&engine->rate[sample->sensor], sample);
+    
+    for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+        const DHT11AlertRule* rule = &engine->rules[i];
+        DHT11AlertState* state = &engine->state[sample->sensor][i];
+        int32_t value;
+        
+        if(!rule->enabled || !dht11_alert_value(engine, sample, rule->quantity, &value)) {
+            continue;
+        }
+        
+        // Inactive rules wait for the threshold, active ones for the hysteresis band
+        bool change;
+        if(!state->active) {
+            change = rule->above ? value > rule->threshold : value < rule->threshold;
+        } else {
+            change = rule->above ? value < rule->threshold - rule->hysteresis :
+                                   value > rule->threshold + rule->hysteresis;
+        }
+        
+        if(!change) {
+            state->pending = false;
+            continue;
+        }
+        if(!state->pending) {
+            state->pending = true;
+            state->since = sample->tick;
+        }
+        if(sample->tick - state->since < furi_ms_to_ticks(rule->hold_ms)) {
+            continue;
+        }
+        
+        state->active = !state->active;
+        state->pending = false;
+        if(state->active) {
+            engine->triggered++;
+            dht11_alert_notify(engine);
+        }
+        dht11_alert_log(engine, sample, rule, state->active, value);
+    }
+}
+
+uint8_t dht11_alert_active_count(const DHT11AlertEngine* engine, uint8_t sensor) {
+    furi_assert(engine);
+    
+    uint8_t count = 0;
+    if(sensor < DHT11_ALERT_MAX_SENSORS) {
+        for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+            count += engine->state[sensor][i].active;
+        }
+    }
+    return count;
+}
+
+const char* dht11_alert_quantity_name(DHT11AlertQuantity quantity) {
+    return quantity < DHT11AlertQuantityCount ? dht11_alert_quantity_names[quantity] : "unknown";
+}
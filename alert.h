@@ -0,0 +1,169 @@
+/**
+ * @file alert.h
+ * @brief Threshold alerts evaluated on the acquisition thread
+ * 
+ * Every published sample is checked against a small set of rules on
+ * temperature, humidity, heat index or rate of temperature change. A rule
+ * only triggers once its condition has held for its minimum duration, and
+ * only clears once the value is back past the threshold by the hysteresis
+ * for as long again, so a reading hovering at the limit does not keep
+ * firing. Triggers play notification sequences and append an event line
+ * to a file on the SD card. Nothing here depends on the GUI, so alerts
+ * keep working with the screen off in low-power mode.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <notification/notification_messages.h>
+#include "sample_buffer.h"
+
+/** @brief Alert event file location */
+#define DHT11_ALERT_EVENTS_PATH APP_DATA_PATH("events.csv")
+
+/** @brief Number of rules */
+#define DHT11_ALERT_MAX_RULES 5
+
+/** @brief Number of sensors the engine keeps state for */
+#define DHT11_ALERT_MAX_SENSORS 8
+
+/** @brief Window over which the rate of change is measured */
+#define DHT11_ALERT_RATE_WINDOW_MS 60000
+
+/** @brief Actions used when alerts are switched on from the menu */
+#define DHT11_ALERT_DEFAULT_ACTIONS (DHT11AlertActionVibrate | DHT11AlertActionLed)
+
+/**
+ * @brief Quantity a rule watches
+ */
+typedef enum {
+    DHT11AlertQuantityTemperature,  /**< Temperature in Celsius */
+    DHT11AlertQuantityHumidity,     /**< Relative humidity in percent */
+    DHT11AlertQuantityHeatIndex,    /**< Heat index in Celsius */
+    DHT11AlertQuantityRate,         /**< Temperature change either way, Celsius per minute */
+    DHT11AlertQuantityCount,        /**< Number of quantities */
+} DHT11AlertQuantity;
+
+/**
+ * @brief What happens when a rule triggers, combined as a bit mask
+ */
+typedef enum {
+    DHT11AlertActionVibrate = (1 << 0), /**< Vibrate twice */
+    DHT11AlertActionLed = (1 << 1),     /**< Blink the LED red */
+    DHT11AlertActionSound = (1 << 2),   /**< Play the alert sound */
+} DHT11AlertAction;
+
+/**
+ * @brief One threshold rule, applied to every sensor
+ */
+typedef struct {
+    bool enabled;                   /**< Rule is evaluated */
+    DHT11AlertQuantity quantity;    /**< Watched quantity */
+    bool above;                     /**< Triggers above the threshold, else below */
+    int16_t threshold;              /**< Trigger level, in tenths */
+    uint16_t hysteresis;            /**< Distance past the threshold needed to clear, in tenths */
+    uint32_t hold_ms;               /**< Time the condition must hold to trigger or clear */
+} DHT11AlertRule;
+
+/**
+ * @brief State of one rule on one sensor
+ */
+typedef struct {
+    bool active;                    /**< Rule has triggered and not cleared */
+    bool pending;                   /**< Condition to change state is holding */
+    uint32_t since;                 /**< Tick at which the pending condition started */
+} DHT11AlertState;
+
+/**
+ * @brief Rate of change measurement of one sensor
+ */
+typedef struct {
+    bool primed;                    /**< reference_* hold a reading */
+    bool valid;                     /**< rate holds a measurement */
+    int16_t reference_temperature;  /**< Temperature at the start of the window, in tenths */
+    uint32_t reference_tick;        /**< Tick at the start of the window */
+    int32_t rate;                   /**< Change over the last full window, tenths per minute */
+} DHT11AlertRate;
+
+/**
+ * @brief Alert engine
+ */
+typedef struct {
+    volatile bool enabled;          /**< Samples are evaluated */
+    uint8_t actions;                /**< DHT11AlertAction mask */
+    DHT11AlertRule rules[DHT11_ALERT_MAX_RULES];    /**< Rules */
+    DHT11AlertState state[DHT11_ALERT_MAX_SENSORS][DHT11_ALERT_MAX_RULES];  /**< Rule state per sensor */
+    DHT11AlertRate rate[DHT11_ALERT_MAX_SENSORS];   /**< Rate measurement per sensor */
+    NotificationApp* notifications; /**< Notification service */
+    Storage* storage;               /**< Storage record */
+    volatile uint32_t triggered;    /**< Triggers since the engine was enabled */
+    volatile uint32_t write_errors; /**< Event lines that could not be written */
+} DHT11AlertEngine;
+
+/** @brief Rules in place until they are replaced */
+extern const DHT11AlertRule dht11_alert_default_rules[DHT11_ALERT_MAX_RULES];
+
+/**
+ * @brief Allocate the alert engine with the default rules, disabled
+ * 
+ * @return Pointer to the allocated engine
+ */
+DHT11AlertEngine* dht11_alert_alloc(void);
+
+/**
+ * @brief Free the alert engine
+ * 
+ * @param engine Pointer to the engine
+ */
+void dht11_alert_free(DHT11AlertEngine* engine);
+
+/**
+ * @brief Start or stop evaluating samples
+ * 
+ * Enabling clears the state of every rule, so conditions that already
+ * hold trigger again after their minimum duration.
+ * 
+ * @param engine Pointer to the engine
+ * @param enabled true to evaluate samples
+ */
+void dht11_alert_set_enabled(DHT11AlertEngine* engine, bool enabled);
+
+/**
+ * @brief Replace a rule
+ * 
+ * Must only be called while the engine is disabled.
+ * 
+ * @param engine Pointer to the engine
+ * @param index Rule index, below DHT11_ALERT_MAX_RULES
+ * @param rule New rule
+ */
+void dht11_alert_set_rule(DHT11AlertEngine* engine, uint8_t index, const DHT11AlertRule* rule);
+
+/**
+ * @brief Check a new sample against every rule
+ * 
+ * Called by the acquisition thread for every published sample; failed
+ * reads leave the rule state alone. Constant work per sample.
+ * 
+ * @param engine Pointer to the engine
+ * @param sample New sample
+ */
+void dht11_alert_evaluate(DHT11AlertEngine* engine, const DHT11Sample* sample);
+
+/**
+ * @brief Count the rules currently triggered on a sensor
+ * 
+ * @param engine Pointer to the engine
+ * @param sensor Sensor index
+ * @return Number of active rules
+ */
+uint8_t dht11_alert_active_count(const DHT11AlertEngine* engine, uint8_t sensor);
+
+/**
+ * @brief Get the display name of a quantity
+ * 
+ * @param quantity Quantity
+ * @return Short name
+ */
+const char* dht11_alert_quantity_name(DHT11AlertQuantity quantity);
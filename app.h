@@ -14,9 +14,30 @@
 #include <gui/scene_manager.h>
 #include <gui/modules/submenu.h>
 #include <gui/modules/text_box.h>
-#include <gui/modules/widget.h>
+#include <gui/modules/variable_item_list.h>
 #include <input/input.h>
 #include <notification/notification_messages.h>
+#include "decoder.h"
+#include "driver.h"
+#include "sensor_capture.h"
+#include "sensor_power.h"
+#include "calibration.h"
+#include "protocol.h"
+#include "sensor_cache.h"
+#include "acquisition.h"
+#include "trace_log.h"
+#include "usb_stream.h"
+#include "logger.h"
+#include "beacon.h"
+#include "alert.h"
+#include "settings.h"
+#include "stats.h"
+#include "benchmark.h"
+#include "sensor_view.h"
+#include "debug_log.h"
+#include "history.h"
+#include "graph_view.h"
+#include "low_power_view.h"
 
 /**
  * @brief Application scene enumeration
@@ -29,6 +50,11 @@ typedef enum {
     DHT11SceneReadSensor,   /**< Sensor reading scene */
     DHT11SceneAbout,        /**< About/help scene */
     DHT11SceneDebug,        /**< Debug output scene */
+    DHT11SceneStats,        /**< Read path statistics scene */
+    DHT11SceneGraph,        /**< History graph scene */
+    DHT11SceneLowPower,     /**< Low-power logging scene */
+    DHT11SceneSettings,     /**< Settings scene */
+    DHT11SceneBenchmark,    /**< Read parameter sweep scene */
     DHT11SceneCount,        /**< Total number of scenes */
 } DHT11Scene;
 
@@ -41,8 +67,57 @@ typedef enum {
     DHT11MainMenuIndexReadSensor,   /**< Read sensor menu item */
     DHT11MainMenuIndexAbout,        /**< About menu item */
     DHT11MainMenuIndexDebug,        /**< Debug menu item */
+    DHT11MainMenuIndexStats,        /**< Statistics menu item */
+    DHT11MainMenuIndexGraph,        /**< History graph menu item */
+    DHT11MainMenuIndexLowPower,     /**< Low-power logging menu item */
+    DHT11MainMenuIndexSettings,     /**< Settings menu item */
+    DHT11MainMenuIndexBenchmark,    /**< Benchmark menu item */
+    DHT11MainMenuIndexTrace,        /**< Edge trace recording toggle */
+    DHT11MainMenuIndexLog,          /**< SD sample logging toggle */
+    DHT11MainMenuIndexUsbStream,    /**< USB streaming mode selector */
+    DHT11MainMenuIndexBeacon,       /**< BLE beacon toggle */
+    DHT11MainMenuIndexAlerts,       /**< Threshold alert toggle */
 } DHT11MainMenuIndex;
 
+/**
+ * @brief Custom events sent to the scene manager
+ */
+typedef enum {
+    DHT11CustomEventRead = 1,       /**< READ button pressed */
+    DHT11CustomEventSampleReady,    /**< Acquisition thread published a sample */
+    DHT11CustomEventPreviousSensor, /**< Show the previous sensor */
+    DHT11CustomEventNextSensor,     /**< Show the next sensor */
+    DHT11CustomEventWake,           /**< Key pressed in low-power mode */
+    DHT11CustomEventBenchmarkProgress, /**< Benchmark thread finished a read */
+    DHT11CustomEventGraphLoad,      /**< Graph switched to a span of the SD archive */
+} DHT11CustomEvent;
+
+/**
+ * @brief Settings replaced while the low-power logging mode is active
+ */
+typedef struct {
+    uint32_t period_ms;                     /**< Sampling period to restore */
+    DHT11AcquisitionCallback callback;      /**< Sample notification to restore */
+    void* callback_context;                 /**< Context of the sample notification */
+    bool started_logger;                    /**< The mode started the logger and stops it again */
+    bool switched;                          /**< Sensor supply is switched */
+    uint32_t start_tick;                    /**< Tick at which the mode was entered */
+} DHT11LowPowerState;
+
+/** @brief Maximum number of sensors attached at the same time */
+#define DHT11_MAX_SENSORS 8
+
+/**
+ * @brief Per-sensor descriptor
+ * 
+ * One entry per sensor attached to the GPIO header; everything the read
+ * path needs lives in the driver handle.
+ */
+typedef struct {
+    const char* name;                   /**< Pin name as printed on the header */
+    DHT11Driver* driver;                /**< Driver handle of the sensor */
+} DHT11Sensor;
+
 /**
  * @brief Main application structure
  * 
@@ -53,20 +128,44 @@ typedef struct {
     ViewDispatcher* view_dispatcher;    /**< View dispatcher for scene management */
     SceneManager* scene_manager;        /**< Flipper's scene manager */
     
-    // GUI Views
+    // GUI Views, NULL until the scene is entered, see scene_views.h
+    uint32_t scene_views;               /**< Mask of scenes whose view is allocated */
     Submenu* submenu;                   /**< Main menu submenu */
-    Widget* sensor_widget;              /**< Sensor reading widget */
+    DHT11SensorView* sensor_view;       /**< Sensor reading view */
     TextBox* about_text_box;            /**< About screen text box */
     TextBox* debug_text_box;            /**< Debug output text box */
+    TextBox* stats_text_box;            /**< Statistics text box */
+    DHT11GraphView* graph_view;         /**< History graph view */
+    DHT11LowPowerView* low_power_view;  /**< Low-power logging status view */
+    VariableItemList* settings_list;    /**< Settings list */
+    TextBox* benchmark_text_box;        /**< Benchmark progress text box */
     
     NotificationApp* notifications;     /**< Notification service */
+    DHT11Settings settings;             /**< Settings, loaded once at startup */
+    
+    // Sensor driver state
+    FuriMutex* sensor_mutex;            /**< Serializes the driver hooks' shared state */
+    DHT11TraceLog* trace_log;           /**< Edge trace export, NULL when disabled */
+    DHT11UsbStream* usb_stream;         /**< USB frame stream, NULL when disabled */
+    DHT11SensorPower power;             /**< Sensor supply */
+    bool power_saving;                  /**< Supply switched off and LED quiet between transactions */
+    DHT11Stats stats;                   /**< Read path instrumentation */
+    DHT11Acquisition* acquisition;      /**< Background sampling thread */
+    DHT11History* history;              /**< Multi-resolution trend history */
+    DHT11Logger* logger;                /**< SD card sample logger */
+    DHT11Beacon* beacon;                /**< BTHome BLE broadcast */
+    DHT11AlertEngine* alerts;           /**< Threshold alerts, run by the acquisition thread */
+    DHT11LowPowerState low_power;       /**< Saved state of the low-power mode */
+    DHT11Benchmark* benchmark;          /**< Running parameter sweep, only while its scene is shown */
     
     // Sensor data
-    float temperature;                  /**< Last temperature reading in Celsius */
-    float humidity;                     /**< Last humidity reading in percentage */
-    bool sensor_ok;                     /**< Flag indicating last sensor read status */
-    char debug_log[2048];              /**< Buffer for debug output */
-    char* about_text;                   /**< About screen text content */
+    DHT11Sensor sensors[DHT11_MAX_SENSORS]; /**< Attached sensors */
+    uint8_t sensor_count;               /**< Number of valid entries in sensors */
+    uint8_t selected_sensor;            /**< Sensor shown by the read and debug scenes */
+    DHT11DebugLog* debug_events;        /**< Recorded debug transactions, NULL before the first */
+    FuriString* debug_text;             /**< Debug events rendered as text, only while shown */
+    char* stats_text;                   /**< Text of the statistics scene, only while shown */
+    char* benchmark_text;               /**< Text of the benchmark scene, only while shown */
 } DHT11App;
 
 // Function declarations  
@@ -0,0 +1,610 @@
+/**
+ * @file archive.c
+ * @brief Delta-compressed, time-indexed sample log implementation
+ */
+
+#include "archive.h"
+
+/** @brief Tag bits holding the sensor index */
+#define DHT11_ARCHIVE_TAG_SENSOR 0x07
+
+/** @brief Tag bit set when a time field follows */
+#define DHT11_ARCHIVE_TAG_TIME 0x08
+
+/** @brief Position of the temperature code in the tag */
+#define DHT11_ARCHIVE_TAG_TEMPERATURE_SHIFT 4
+
+/** @brief Position of the humidity code in the tag */
+#define DHT11_ARCHIVE_TAG_HUMIDITY_SHIFT 6
+
+/** @brief Bytes of a block left for encoded samples */
+#define DHT11_ARCHIVE_BLOCK_DATA (DHT11_ARCHIVE_BLOCK_SIZE - sizeof(DHT11ArchiveBlockHeader))
+
+/**
+ * @brief Codes of a reading in the tag byte
+ */
+typedef enum {
+    DHT11ArchiveDeltaSame,      /**< Unchanged */
+    DHT11ArchiveDeltaUp,        /**< One tenth higher */
+    DHT11ArchiveDeltaDown,      /**< One tenth lower */
+    DHT11ArchiveDeltaField,     /**< Zig-zag varint delta follows */
+} DHT11ArchiveDelta;
+
+/**
+ * @brief Map a signed value to an unsigned one, small magnitudes first
+ * 
+ * @param value Signed value
+ * @return 0, -1, 1, -2, ... as 0, 1, 2, 3, ...
+ */
+static inline uint32_t dht11_archive_zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+/**
+ * @brief Undo dht11_archive_zigzag()
+ * 
+ * @param value Zig-zag encoded value
+ * @return Signed value
+ */
+static inline int32_t dht11_archive_unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/**
+ * @brief Write a varint, seven bits per byte with the low bits first
+ * 
+ * @param out Output position
+ * @param value Value to write
+ * @return Position after the varint
+ */
+static uint8_t* dht11_archive_put_varint(uint8_t* out, uint64_t value) {
+    while(value >= 0x80) {
+        *out++ = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+/**
+ * @brief Read a varint
+ * 
+ * @param in Input position, advanced past the varint
+ * @param end End of the input
+ * @param value Output for the value
+ * @return false if the varint runs past the end or is too long
+ */
+static bool dht11_archive_get_varint(const uint8_t** in, const uint8_t* end, uint64_t* value) {
+    *value = 0;
+    for(uint8_t shift = 0; shift < 64 && *in < end; shift += 7) {
+        uint8_t byte = *(*in)++;
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Encode the change of a reading
+ * 
+ * @param out Output position, advanced past a delta field if one is needed
+ * @param delta Change in tenths
+ * @return Code for the tag byte
+ */
+static DHT11ArchiveDelta dht11_archive_put_delta(uint8_t** out, int32_t delta) {
+    if(delta == 0) {
+        return DHT11ArchiveDeltaSame;
+    } else if(delta == 1) {
+        return DHT11ArchiveDeltaUp;
+    } else if(delta == -1) {
+        return DHT11ArchiveDeltaDown;
+    }
+    *out = dht11_archive_put_varint(*out, dht11_archive_zigzag(delta));
+    return DHT11ArchiveDeltaField;
+}
+
+/**
+ * @brief Decode the change of a reading
+ * 
+ * @param code Code from the tag byte
+ * @param in Input position, advanced past a delta field
+ * @param end End of the input
+ * @param delta Output for the change in tenths
+ * @return false on malformed data
+ */
+static bool dht11_archive_get_delta(uint8_t code, const uint8_t** in, const uint8_t* end, int32_t* delta) {
+    uint64_t field = 0;
+    switch(code) {
+    case DHT11ArchiveDeltaSame:
+        *delta = 0;
+        return true;
+    case DHT11ArchiveDeltaUp:
+        *delta = 1;
+        return true;
+    case DHT11ArchiveDeltaDown:
+        *delta = -1;
+        return true;
+    default:
+        if(!dht11_archive_get_varint(in, end, &field) || field > UINT32_MAX) {
+            return false;
+        }
+        *delta = dht11_archive_unzigzag((uint32_t)field);
+        return true;
+    }
+}
+
+/**
+ * @brief Put every sensor back at the start of a block
+ * 
+ * @param tracks Per-sensor state
+ * @param timestamp Time base of the block
+ */
+static void dht11_archive_tracks_reset(DHT11ArchiveTrack* tracks, uint32_t timestamp) {
+    memset(tracks, 0, DHT11_ARCHIVE_SENSORS * sizeof(DHT11ArchiveTrack));
+    for(uint8_t i = 0; i < DHT11_ARCHIVE_SENSORS; i++) {
+        tracks[i].timestamp = timestamp;
+    }
+}
+
+void dht11_archive_encoder_reset(DHT11ArchiveEncoder* encoder) {
+    furi_assert(encoder);
+    memset(encoder, 0, sizeof(DHT11ArchiveEncoder));
+}
+
+bool dht11_archive_encoder_add(DHT11ArchiveEncoder* encoder, const DHT11ArchiveSample* sample) {
+    furi_assert(encoder);
+    furi_assert(sample->sensor < DHT11_ARCHIVE_SENSORS);
+    
+    if((size_t)encoder->length + DHT11_ARCHIVE_SAMPLE_MAX > DHT11_ARCHIVE_BLOCK_DATA) {
+        return false;
+    }
+    
+    // The first sample sets the time base of the block
+    if(encoder->count == 0) {
+        DHT11ArchiveBlockHeader header = {.timestamp = sample->timestamp};
+        memcpy(encoder->block, &header, sizeof(header));
+        dht11_archive_tracks_reset(encoder->tracks, sample->timestamp);
+        encoder->span.first = sample->timestamp;
+        encoder->span.last = sample->timestamp;
+    }
+    
+    DHT11ArchiveTrack* track = &encoder->tracks[sample->sensor];
+    uint8_t* start = encoder->block + sizeof(DHT11ArchiveBlockHeader) + encoder->length;
+    uint8_t* out = start + 1;
+    uint8_t tag = sample->sensor;
+    
+    int32_t delta = (int32_t)(sample->timestamp - track->timestamp);
+    if(!sample->ok || delta != track->delta) {
+        tag |= DHT11_ARCHIVE_TAG_TIME;
+        out = dht11_archive_put_varint(out, ((uint64_t)dht11_archive_zigzag(delta) << 1) | (sample->ok ? 0 : 1));
+    }
+    
+    if(sample->ok) {
+        tag |= dht11_archive_put_delta(&out, (int32_t)sample->temperature - track->temperature)
+               << DHT11_ARCHIVE_TAG_TEMPERATURE_SHIFT;
+        tag |= dht11_archive_put_delta(&out, (int32_t)sample->humidity - track->humidity)
+               << DHT11_ARCHIVE_TAG_HUMIDITY_SHIFT;
+        track->temperature = sample->temperature;
+        track->humidity = sample->humidity;
+    }
+    *start = tag;
+    
+    track->timestamp = sample->timestamp;
+    track->delta = delta;
+    encoder->length += out - start;
+    encoder->count++;
+    encoder->span.first = MIN(encoder->span.first, sample->timestamp);
+    encoder->span.last = MAX(encoder->span.last, sample->timestamp);
+    return true;
+}
+
+/**
+ * @brief Complete the header of an encoded block and pad it
+ * 
+ * @param block Block holding the samples, written in place
+ * @param count Samples in the block
+ * @param length Encoded bytes after the header
+ */
+static void dht11_archive_block_seal(uint8_t* block, uint16_t count, uint16_t length) {
+    DHT11ArchiveBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    header.count = count;
+    header.length = length;
+    memcpy(block, &header, sizeof(header));
+    
+    size_t used = sizeof(DHT11ArchiveBlockHeader) + length;
+    memset(block + used, 0, DHT11_ARCHIVE_BLOCK_SIZE - used);
+}
+
+void dht11_archive_encoder_finish(DHT11ArchiveEncoder* encoder, DHT11ArchiveIndexEntry* entry) {
+    furi_assert(encoder);
+    furi_assert(encoder->count > 0);
+    
+    dht11_archive_block_seal(encoder->block, encoder->count, encoder->length);
+    *entry = encoder->span;
+}
+
+bool dht11_archive_decoder_init(DHT11ArchiveDecoder* decoder, const uint8_t* block) {
+    furi_assert(decoder);
+    
+    DHT11ArchiveBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    
+    decoder->block = block;
+    decoder->remaining = 0;
+    decoder->position = sizeof(DHT11ArchiveBlockHeader);
+    decoder->end = decoder->position;
+    if(header.length > DHT11_ARCHIVE_BLOCK_DATA) {
+        return false;
+    }
+    
+    decoder->remaining = header.count;
+    decoder->end += header.length;
+    dht11_archive_tracks_reset(decoder->tracks, header.timestamp);
+    return true;
+}
+
+bool dht11_archive_decoder_next(DHT11ArchiveDecoder* decoder, DHT11ArchiveSample* sample) {
+    furi_assert(decoder);
+    
+    if(decoder->remaining == 0 || decoder->position >= decoder->end) {
+        return false;
+    }
+    
+    const uint8_t* in = decoder->block + decoder->position;
+    const uint8_t* end = decoder->block + decoder->end;
+    uint8_t tag = *in++;
+    DHT11ArchiveTrack* track = &decoder->tracks[tag & DHT11_ARCHIVE_TAG_SENSOR];
+    
+    int32_t delta = track->delta;
+    bool ok = true;
+    if(tag & DHT11_ARCHIVE_TAG_TIME) {
+        uint64_t field;
+        if(!dht11_archive_get_varint(&in, end, &field) || (field >> 1) > UINT32_MAX) {
+            decoder->remaining = 0;
+            return false;
+        }
+        ok = !(field & 1);
+        delta = dht11_archive_unzigzag((uint32_t)(field >> 1));
+    }
+    
+    if(ok) {
+        int32_t temperature;
+        int32_t humidity;
+        if(!dht11_archive_get_delta((tag >> DHT11_ARCHIVE_TAG_TEMPERATURE_SHIFT) & 0x03, &in, end, &temperature) ||
+           !dht11_archive_get_delta((tag >> DHT11_ARCHIVE_TAG_HUMIDITY_SHIFT) & 0x03, &in, end, &humidity)) {
+            decoder->remaining = 0;
+            return false;
+        }
+        track->temperature += temperature;
+        track->humidity += humidity;
+    }
+    
+    track->timestamp += delta;
+    track->delta = delta;
+    decoder->position = in - decoder->block;
+    decoder->remaining--;
+    
+    sample->timestamp = track->timestamp;
+    sample->sensor = tag & DHT11_ARCHIVE_TAG_SENSOR;
+    sample->ok = ok;
+    sample->temperature = ok ? track->temperature : 0;
+    sample->humidity = ok ? track->humidity : 0;
+    return true;
+}
+
+void dht11_archive_index_path(const char* path, FuriString* index_path) {
+    furi_string_set_str(index_path, path);
+    furi_string_cat_str(index_path, DHT11_ARCHIVE_INDEX_SUFFIX);
+}
+
+/**
+ * @brief Work out the index entry of a data block
+ * 
+ * @param block Contents of the block
+ * @param entry Entry of the previous block on input, kept for an empty block
+ */
+static void dht11_archive_block_span(const uint8_t* block, DHT11ArchiveIndexEntry* entry) {
+    DHT11ArchiveDecoder decoder;
+    DHT11ArchiveSample sample;
+    bool any = false;
+    
+    if(!dht11_archive_decoder_init(&decoder, block)) {
+        return;
+    }
+    while(dht11_archive_decoder_next(&decoder, &sample)) {
+        if(!any) {
+            entry->first = sample.timestamp;
+            entry->last = sample.timestamp;
+            any = true;
+        }
+        entry->first = MIN(entry->first, sample.timestamp);
+        entry->last = MAX(entry->last, sample.timestamp);
+    }
+}
+
+bool dht11_archive_repair(Storage* storage, const char* path) {
+    furi_assert(storage);
+    
+    FuriString* index_path = furi_string_alloc();
+    dht11_archive_index_path(path, index_path);
+    File* data = storage_file_alloc(storage);
+    File* index = storage_file_alloc(storage);
+    uint32_t blocks = 0;
+    bool ok = false;
+    
+    bool data_open = storage_file_open(data, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+    if(data_open) {
+        uint64_t size = storage_file_size(data);
+        uint64_t whole = size - size % DHT11_ARCHIVE_BLOCK_SIZE;
+        
+        // A block cut short by an unclean stop is dropped
+        if(whole < size) {
+            storage_file_seek(data, whole, true);
+            storage_file_truncate(data);
+        }
+        blocks = whole > 0 ? whole / DHT11_ARCHIVE_BLOCK_SIZE - 1 : 0;
+    }
+    
+    // A new log starts with an empty index
+    if(storage_file_open(
+           index, furi_string_get_cstr(index_path), FSAM_READ_WRITE, blocks > 0 ? FSOM_OPEN_ALWAYS : FSOM_CREATE_ALWAYS)) {
+        uint64_t size = storage_file_size(index);
+        uint32_t entries = MIN(size / sizeof(DHT11ArchiveIndexEntry), (uint64_t)blocks);
+        ok = true;
+        
+        // Entries of blocks that were still buffered when the app stopped
+        if(size > entries * sizeof(DHT11ArchiveIndexEntry)) {
+            ok = storage_file_seek(index, entries * sizeof(DHT11ArchiveIndexEntry), true) &&
+                 storage_file_truncate(index);
+        }
+        
+        if(ok && entries < blocks) {
+            uint8_t* buffer = malloc(DHT11_ARCHIVE_BLOCK_SIZE);
+            DHT11ArchiveIndexEntry entry = {0};
+            if(entries > 0) {
+                ok = storage_file_seek(index, (entries - 1) * sizeof(entry), true) &&
+                     storage_file_read(index, &entry, sizeof(entry)) == sizeof(entry);
+            }
+            ok = ok && storage_file_seek(index, entries * sizeof(entry), true);
+            
+            for(uint32_t block = entries; ok && block < blocks; block++) {
+                ok = storage_file_seek(data, (block + 1) * DHT11_ARCHIVE_BLOCK_SIZE, true) &&
+                     storage_file_read(data, buffer, DHT11_ARCHIVE_BLOCK_SIZE) == DHT11_ARCHIVE_BLOCK_SIZE;
+                if(ok) {
+                    dht11_archive_block_span(buffer, &entry);
+                    ok = storage_file_write(index, &entry, sizeof(entry)) == sizeof(entry);
+                }
+            }
+            free(buffer);
+        }
+        storage_file_close(index);
+    }
+    
+    if(!ok) {
+        FURI_LOG_E("DHT11", "Failed to repair the index of %s", path);
+    }
+    
+    if(data_open) {
+        storage_file_close(data);
+    }
+    storage_file_free(index);
+    storage_file_free(data);
+    furi_string_free(index_path);
+    return ok;
+}
+
+DHT11ArchiveReader* dht11_archive_reader_open(Storage* storage, const char* path) {
+    furi_assert(storage);
+    
+    DHT11ArchiveReader* reader = malloc(sizeof(DHT11ArchiveReader));
+    reader->data = storage_file_alloc(storage);
+    reader->index = storage_file_alloc(storage);
+    reader->blocks = 0;
+    reader->indexed = 0;
+    reader->current = UINT32_MAX;
+    reader->loads = 0;
+    reader->tail = false;
+    
+    DHT11ArchiveHeader header;
+    if(!storage_file_open(reader->data, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        storage_file_free(reader->index);
+        storage_file_free(reader->data);
+        free(reader);
+        return NULL;
+    }
+    if(storage_file_read(reader->data, &header, sizeof(header)) != sizeof(header) ||
+       memcmp(header.magic, DHT11_ARCHIVE_MAGIC, sizeof(header.magic)) != 0 ||
+       header.block_size != DHT11_ARCHIVE_BLOCK_SIZE) {
+        storage_file_close(reader->data);
+        storage_file_free(reader->index);
+        storage_file_free(reader->data);
+        free(reader);
+        return NULL;
+    }
+    
+    uint64_t size = storage_file_size(reader->data);
+    reader->blocks = size >= DHT11_ARCHIVE_BLOCK_SIZE ? size / DHT11_ARCHIVE_BLOCK_SIZE - 1 : 0;
+    
+    // Without an index every seek starts at the first block
+    FuriString* index_path = furi_string_alloc();
+    dht11_archive_index_path(path, index_path);
+    if(storage_file_open(reader->index, furi_string_get_cstr(index_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint64_t entries = storage_file_size(reader->index) / sizeof(DHT11ArchiveIndexEntry);
+        reader->indexed = MIN(entries, (uint64_t)reader->blocks);
+    } else {
+        storage_file_free(reader->index);
+        reader->index = NULL;
+    }
+    furi_string_free(index_path);
+    
+    return reader;
+}
+
+void dht11_archive_reader_close(DHT11ArchiveReader* reader) {
+    furi_assert(reader);
+    
+    if(reader->index) {
+        storage_file_close(reader->index);
+        storage_file_free(reader->index);
+    }
+    storage_file_close(reader->data);
+    storage_file_free(reader->data);
+    free(reader);
+}
+
+void dht11_archive_reader_set_tail(DHT11ArchiveReader* reader, const DHT11ArchiveEncoder* encoder) {
+    furi_assert(reader);
+    furi_assert(encoder);
+    
+    reader->tail = encoder->count > 0;
+    if(reader->tail) {
+        memcpy(reader->tail_block, encoder->block, sizeof(reader->tail_block));
+        dht11_archive_block_seal(reader->tail_block, encoder->count, encoder->length);
+        reader->tail_span = encoder->span;
+    }
+    if(reader->current == reader->blocks) {
+        reader->current = UINT32_MAX;
+    }
+}
+
+/**
+ * @brief Make a data block current and start decoding it
+ * 
+ * The card is only read if the block is not in the buffer already. The
+ * block after the last one on the card is the tail, if one was set.
+ * 
+ * @param reader Pointer to the reader
+ * @param block Data block number
+ * @return false if the block could not be read
+ */
+static bool dht11_archive_reader_load(DHT11ArchiveReader* reader, uint32_t block) {
+    if(block != reader->current && block == reader->blocks) {
+        if(!reader->tail) {
+            return false;
+        }
+        memcpy(reader->buffer, reader->tail_block, DHT11_ARCHIVE_BLOCK_SIZE);
+        reader->current = block;
+    } else if(block != reader->current) {
+        reader->current = UINT32_MAX;
+        if(!storage_file_seek(reader->data, (block + 1) * DHT11_ARCHIVE_BLOCK_SIZE, true) ||
+           storage_file_read(reader->data, reader->buffer, DHT11_ARCHIVE_BLOCK_SIZE) != DHT11_ARCHIVE_BLOCK_SIZE) {
+            return false;
+        }
+        reader->current = block;
+        reader->loads++;
+    }
+    
+    // A damaged block decodes as empty
+    dht11_archive_decoder_init(&reader->decoder, reader->buffer);
+    return true;
+}
+
+bool dht11_archive_reader_seek(DHT11ArchiveReader* reader, uint32_t timestamp) {
+    furi_assert(reader);
+    
+    // First indexed block whose latest sample is not before the time
+    uint32_t low = 0;
+    uint32_t high = reader->indexed;
+    while(low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        DHT11ArchiveIndexEntry entry;
+        if(!storage_file_seek(reader->index, middle * sizeof(entry), true) ||
+           storage_file_read(reader->index, &entry, sizeof(entry)) != sizeof(entry)) {
+            return false;
+        }
+        if(entry.last < timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    
+    // Past the indexed blocks, the unindexed ones are scanned from the first;
+    // past every block on the card only the tail may still hold the time
+    if(low == reader->blocks && reader->tail && reader->tail_span.last >= timestamp) {
+        return dht11_archive_reader_load(reader, low);
+    }
+    if(low >= reader->blocks) {
+        return false;
+    }
+    return dht11_archive_reader_load(reader, low);
+}
+
+/**
+ * @brief Move on to the block after the current one
+ * 
+ * @param reader Pointer to the reader
+ * @return false at the end of the log
+ */
+static bool dht11_archive_reader_advance(DHT11ArchiveReader* reader) {
+    uint32_t following = reader->current == UINT32_MAX ? 0 : reader->current + 1;
+    return following < reader->blocks + (reader->tail ? 1 : 0) && dht11_archive_reader_load(reader, following);
+}
+
+bool dht11_archive_reader_next(DHT11ArchiveReader* reader, DHT11ArchiveSample* sample) {
+    furi_assert(reader);
+    
+    while(reader->current == UINT32_MAX || !dht11_archive_decoder_next(&reader->decoder, sample)) {
+        if(!dht11_archive_reader_advance(reader)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint16_t dht11_archive_reader_summarize(
+    DHT11ArchiveReader* reader,
+    uint8_t sensor,
+    uint32_t from,
+    uint32_t to,
+    uint8_t max_blocks,
+    DHT11HistoryRange* ranges) {
+    furi_assert(reader);
+    
+    if(!dht11_archive_reader_seek(reader, from)) {
+        return 0;
+    }
+    
+    int32_t sum[DHT11HistoryMetricCount] = {0};
+    uint16_t count = 0;
+    uint8_t blocks = 1;
+    DHT11ArchiveSample sample;
+    
+    while(count < UINT16_MAX) {
+        if(!dht11_archive_decoder_next(&reader->decoder, &sample)) {
+            if(blocks++ >= max_blocks || !dht11_archive_reader_advance(reader)) {
+                break;
+            }
+            continue;
+        }
+        if(sample.timestamp >= to) {
+            break;
+        }
+        if(sample.timestamp < from || sample.sensor != sensor || !sample.ok) {
+            continue;
+        }
+        
+        int16_t values[DHT11HistoryMetricCount] = {
+            [DHT11HistoryMetricTemperature] = sample.temperature,
+            [DHT11HistoryMetricHumidity] = sample.humidity,
+        };
+        for(uint8_t m = 0; m < DHT11HistoryMetricCount; m++) {
+            if(count == 0) {
+                ranges[m].min = values[m];
+                ranges[m].max = values[m];
+            }
+            ranges[m].min = MIN(ranges[m].min, values[m]);
+            ranges[m].max = MAX(ranges[m].max, values[m]);
+            sum[m] += values[m];
+        }
+        count++;
+    }
+    
+    for(uint8_t m = 0; count > 0 && m < DHT11HistoryMetricCount; m++) {
+        ranges[m].mean = sum[m] / (int32_t)count;
+    }
+    return count;
+}
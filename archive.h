@@ -0,0 +1,277 @@
+/**
+ * @file archive.h
+ * @brief Delta-compressed, time-indexed long-term sample log
+ * 
+ * The file is a sequence of DHT11_ARCHIVE_BLOCK_SIZE blocks. Block 0 holds
+ * the file header; every other block holds a DHT11ArchiveBlockHeader, the
+ * encoded samples and zero padding. Each block decodes on its own: the
+ * samples of a sensor are stored as deltas from the previous sample of the
+ * same sensor in the block, starting from the block's RTC timestamp and
+ * zero readings.
+ * 
+ * A sample starts with a tag byte:
+ * - bits 0-2: sensor index;
+ * - bit 3: a time field follows, otherwise the time delta repeats the
+ *   sensor's previous one;
+ * - bits 4-5 and 6-7: temperature and humidity code, 0 unchanged, 1 up one
+ *   tenth, 2 down one tenth, 3 a delta field follows.
+ * 
+ * The time field is a varint of the zig-zag time delta in seconds shifted
+ * left by one, with bit 0 set for a failed read; failed reads always carry
+ * one and leave the readings alone. The delta fields are zig-zag varints
+ * in tenths. A steady reading at a steady rate is therefore one byte.
+ * 
+ * The sidecar file, named after the log with DHT11_ARCHIVE_INDEX_SUFFIX,
+ * holds one DHT11ArchiveIndexEntry per block, so a time can be found with
+ * a binary search and a single block read.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include "history.h"
+
+/** @brief File format magic */
+#define DHT11_ARCHIVE_MAGIC "DHTZ"
+
+/** @brief File format version */
+#define DHT11_ARCHIVE_VERSION 1
+
+/** @brief Size of the header block and of every data block */
+#define DHT11_ARCHIVE_BLOCK_SIZE 512
+
+/** @brief Appended to the log path to name the index file */
+#define DHT11_ARCHIVE_INDEX_SUFFIX ".idx"
+
+/** @brief Sensor indices the tag byte can hold */
+#define DHT11_ARCHIVE_SENSORS 8
+
+/** @brief Longest encoded sample: tag, time field and two delta fields */
+#define DHT11_ARCHIVE_SAMPLE_MAX 12
+
+/**
+ * @brief File header, padded with zeros to a whole block
+ */
+typedef struct FURI_PACKED {
+    char magic[4];                  /**< DHT11_ARCHIVE_MAGIC */
+    uint8_t version;                /**< DHT11_ARCHIVE_VERSION */
+    uint8_t reserved;               /**< Zero */
+    uint16_t block_size;            /**< DHT11_ARCHIVE_BLOCK_SIZE */
+    uint32_t start_timestamp;       /**< RTC time when the file was created */
+} DHT11ArchiveHeader;
+
+/**
+ * @brief Start of every data block
+ */
+typedef struct FURI_PACKED {
+    uint32_t timestamp;             /**< RTC time the first delta of each sensor is taken from */
+    uint16_t count;                 /**< Samples in the block, 0 for an empty block */
+    uint16_t length;                /**< Bytes of encoded samples after this header */
+} DHT11ArchiveBlockHeader;
+
+/**
+ * @brief One entry of the index file, per data block in file order
+ */
+typedef struct FURI_PACKED {
+    uint32_t first;                 /**< Earliest sample time in the block */
+    uint32_t last;                  /**< Latest sample time in the block */
+} DHT11ArchiveIndexEntry;
+
+/**
+ * @brief A sample as stored in the log
+ */
+typedef struct {
+    uint32_t timestamp;             /**< RTC time of the reading, Unix seconds */
+    uint8_t sensor;                 /**< Sensor index, below DHT11_ARCHIVE_SENSORS */
+    bool ok;                        /**< The read succeeded */
+    int16_t temperature;            /**< Temperature in tenths of a degree Celsius, valid if ok */
+    uint16_t humidity;              /**< Relative humidity in tenths of a percent, valid if ok */
+} DHT11ArchiveSample;
+
+/**
+ * @brief Running state of one sensor within a block
+ */
+typedef struct {
+    uint32_t timestamp;             /**< Time of the previous sample */
+    int32_t delta;                  /**< Time delta of the previous sample */
+    int16_t temperature;            /**< Previous good temperature */
+    uint16_t humidity;              /**< Previous good humidity */
+} DHT11ArchiveTrack;
+
+/**
+ * @brief Block being filled
+ */
+typedef struct {
+    uint8_t block[DHT11_ARCHIVE_BLOCK_SIZE];        /**< Header and encoded samples */
+    DHT11ArchiveTrack tracks[DHT11_ARCHIVE_SENSORS]; /**< Per-sensor state */
+    uint16_t count;                                 /**< Samples in the block */
+    uint16_t length;                                /**< Encoded bytes after the header */
+    DHT11ArchiveIndexEntry span;                    /**< Time span of the samples so far */
+} DHT11ArchiveEncoder;
+
+/**
+ * @brief Position within a block being decoded
+ */
+typedef struct {
+    const uint8_t* block;                           /**< Block being decoded */
+    DHT11ArchiveTrack tracks[DHT11_ARCHIVE_SENSORS]; /**< Per-sensor state */
+    uint16_t remaining;                             /**< Samples not yet decoded */
+    uint16_t position;                              /**< Offset of the next sample */
+    uint16_t end;                                   /**< Offset past the encoded samples */
+} DHT11ArchiveDecoder;
+
+/**
+ * @brief Log opened for reading
+ */
+typedef struct {
+    File* data;                                     /**< Log file */
+    File* index;                                    /**< Index file, NULL if missing */
+    uint32_t blocks;                                /**< Complete data blocks */
+    uint32_t indexed;                               /**< Data blocks covered by the index */
+    uint32_t current;                               /**< Data block in buffer, UINT32_MAX for none */
+    uint32_t loads;                                 /**< Blocks read from the card since opening */
+    bool tail;                                      /**< A block not yet written follows the last one */
+    uint8_t tail_block[DHT11_ARCHIVE_BLOCK_SIZE];   /**< Copy of that block, valid if tail */
+    DHT11ArchiveIndexEntry tail_span;               /**< Time span of that block, valid if tail */
+    uint8_t buffer[DHT11_ARCHIVE_BLOCK_SIZE];       /**< Contents of the current block */
+    DHT11ArchiveDecoder decoder;                    /**< Position in the current block */
+} DHT11ArchiveReader;
+
+/**
+ * @brief Start an empty block
+ * 
+ * @param encoder Pointer to the encoder
+ */
+void dht11_archive_encoder_reset(DHT11ArchiveEncoder* encoder);
+
+/**
+ * @brief Append a sample to the block
+ * 
+ * @param encoder Pointer to the encoder
+ * @param sample Sample to encode
+ * @return false if the block is full; finish it, reset and add again
+ */
+bool dht11_archive_encoder_add(DHT11ArchiveEncoder* encoder, const DHT11ArchiveSample* sample);
+
+/**
+ * @brief Write the block header and pad the block
+ * 
+ * Afterwards the whole of encoder->block is ready to be written.
+ * 
+ * @param encoder Pointer to the encoder, holding at least one sample
+ * @param entry Output for the block's index entry
+ */
+void dht11_archive_encoder_finish(DHT11ArchiveEncoder* encoder, DHT11ArchiveIndexEntry* entry);
+
+/**
+ * @brief Start decoding a data block
+ * 
+ * @param decoder Pointer to the decoder
+ * @param block DHT11_ARCHIVE_BLOCK_SIZE bytes, kept until decoding ends
+ * @return false if the block header is not valid
+ */
+bool dht11_archive_decoder_init(DHT11ArchiveDecoder* decoder, const uint8_t* block);
+
+/**
+ * @brief Decode the next sample of the block
+ * 
+ * @param decoder Pointer to the decoder
+ * @param sample Output for the sample
+ * @return false at the end of the block or on malformed data
+ */
+bool dht11_archive_decoder_next(DHT11ArchiveDecoder* decoder, DHT11ArchiveSample* sample);
+
+/**
+ * @brief Build the index file name of a log
+ * 
+ * @param path Log file path
+ * @param index_path Output for the index file path
+ */
+void dht11_archive_index_path(const char* path, FuriString* index_path);
+
+/**
+ * @brief Make a log safe to append to after an unclean stop
+ * 
+ * Cuts a torn block off the end of the log, drops index entries for
+ * blocks that never reached the card and indexes blocks that are missing
+ * from the index. Creates an empty index if the log does not exist.
+ * 
+ * @param storage Storage record
+ * @param path Log file path
+ * @return true if the log and its index agree
+ */
+bool dht11_archive_repair(Storage* storage, const char* path);
+
+/**
+ * @brief Open a log for reading
+ * 
+ * Blocks missing from the index can still be read; seeking past the
+ * indexed ones scans them in order.
+ * 
+ * @param storage Storage record
+ * @param path Log file path
+ * @return Pointer to the reader, NULL if the file is missing or not a log
+ */
+DHT11ArchiveReader* dht11_archive_reader_open(Storage* storage, const char* path);
+
+/**
+ * @brief Close a log
+ * 
+ * @param reader Pointer to the reader
+ */
+void dht11_archive_reader_close(DHT11ArchiveReader* reader);
+
+/**
+ * @brief Read the block an encoder is filling after the ones on the card
+ * 
+ * The block is copied, so the encoder may carry on afterwards; the reader
+ * just does not see the samples added since.
+ * 
+ * @param reader Pointer to the reader
+ * @param encoder Encoder of the log, with nothing buffered in between
+ */
+void dht11_archive_reader_set_tail(DHT11ArchiveReader* reader, const DHT11ArchiveEncoder* encoder);
+
+/**
+ * @brief Move to the first block that may hold samples at or after a time
+ * 
+ * Binary search of the index, assuming the clock was never set back while
+ * logging, followed by one block read.
+ * 
+ * @param reader Pointer to the reader
+ * @param timestamp RTC time to find
+ * @return false if the log ends before that time
+ */
+bool dht11_archive_reader_seek(DHT11ArchiveReader* reader, uint32_t timestamp);
+
+/**
+ * @brief Get the next sample in file order, reading blocks as needed
+ * 
+ * @param reader Pointer to the reader
+ * @param sample Output for the sample
+ * @return false at the end of the log
+ */
+bool dht11_archive_reader_next(DHT11ArchiveReader* reader, DHT11ArchiveSample* sample);
+
+/**
+ * @brief Spread of one sensor's good readings over a time range
+ * 
+ * Seeks to from and reads on until to or until max_blocks blocks were
+ * read, so long ranges are represented by the samples at their start.
+ * 
+ * @param reader Pointer to the reader
+ * @param sensor Sensor index
+ * @param from Start of the range, inclusive
+ * @param to End of the range, exclusive
+ * @param max_blocks Most blocks to read from the card
+ * @param ranges Output for the spread of each DHT11HistoryMetric
+ * @return Number of readings summarized, 0 if there were none
+ */
+uint16_t dht11_archive_reader_summarize(
+    DHT11ArchiveReader* reader,
+    uint8_t sensor,
+    uint32_t from,
+    uint32_t to,
+    uint8_t max_blocks,
+    DHT11HistoryRange* ranges);
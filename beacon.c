@@ -0,0 +1,222 @@
+/**
+ * @file beacon.c
+ * @brief BTHome BLE broadcast implementation
+ */
+
+#include "beacon.h"
+#include <furi_hal.h>
+#include <stdlib.h>
+
+#define DHT11_BEACON_STACK_SIZE 1024
+
+/** @brief BTHome device information: version 2, unencrypted */
+#define DHT11_BEACON_BTHOME_INFO 0x40
+
+/** @brief BTHome object ids, which must appear in ascending order */
+#define DHT11_BEACON_OBJECT_PACKET_ID 0x00
+#define DHT11_BEACON_OBJECT_TEMPERATURE 0x02
+#define DHT11_BEACON_OBJECT_HUMIDITY 0x03
+#define DHT11_BEACON_OBJECT_RAW 0x54
+
+/** @brief Worker thread flags */
+typedef enum {
+    DHT11BeaconFlagStop = (1 << 0),     /**< Exit */
+} DHT11BeaconFlag;
+
+/**
+ * @brief Build the advertisement and hand it to the radio
+ * 
+ * Layout: flags, then one service data structure holding the packet id,
+ * the newest temperature and humidity in hundredths, and a raw object
+ * with the seconds between readings followed by a (temperature, humidity)
+ * delta pair in tenths for each batched reading, oldest first. The last
+ * pair leads up to the advertised values, so a collector can walk the
+ * batch backwards from them.
+ * 
+ * @param beacon Pointer to the beacon
+ */
+static void dht11_beacon_publish(DHT11Beacon* beacon) {
+    uint8_t data[EXTRA_BEACON_MAX_DATA_SIZE];
+    uint8_t length = 0;
+    int16_t temperature = beacon->temperature * 10;
+    uint16_t humidity = beacon->humidity * 10;
+    uint32_t interval_s = beacon->interval / furi_kernel_get_tick_frequency();
+    
+    data[length++] = 2;
+    data[length++] = 0x01;      // Flags
+    data[length++] = 0x06;      // General discoverable, no BR/EDR
+    
+    uint8_t service = length;
+    data[length++] = 0;         // Length, filled in below
+    data[length++] = 0x16;      // Service data, 16-bit UUID
+    data[length++] = DHT11_BEACON_BTHOME_UUID & 0xFF;
+    data[length++] = DHT11_BEACON_BTHOME_UUID >> 8;
+    data[length++] = DHT11_BEACON_BTHOME_INFO;
+    
+    data[length++] = DHT11_BEACON_OBJECT_PACKET_ID;
+    data[length++] = ++beacon->packet_id;
+    data[length++] = DHT11_BEACON_OBJECT_TEMPERATURE;
+    data[length++] = (uint16_t)temperature & 0xFF;
+    data[length++] = (uint16_t)temperature >> 8;
+    data[length++] = DHT11_BEACON_OBJECT_HUMIDITY;
+    data[length++] = humidity & 0xFF;
+    data[length++] = humidity >> 8;
+    
+    data[length++] = DHT11_BEACON_OBJECT_RAW;
+    data[length++] = 1 + 2 * beacon->batch;
+    data[length++] = MIN(interval_s, 255UL);
+    for(uint8_t i = 0; i < beacon->batch; i++) {
+        data[length++] = (uint8_t)beacon->deltas[i][0];
+        data[length++] = (uint8_t)beacon->deltas[i][1];
+    }
+    
+    data[service] = length - service - 1;
+    
+    furi_hal_bt_extra_beacon_set_data(data, length);
+    if(!furi_hal_bt_extra_beacon_is_active()) {
+        furi_hal_bt_extra_beacon_start();
+    }
+    
+    beacon->advertised_temperature = beacon->temperature;
+    beacon->advertised_humidity = beacon->humidity;
+    beacon->batch = 0;
+    beacon->updates++;
+}
+
+/**
+ * @brief Take one good reading of the advertised sensor
+ * 
+ * @param beacon Pointer to the beacon
+ * @param sample Reading to add
+ */
+static void dht11_beacon_add(DHT11Beacon* beacon, const DHT11Sample* sample) {
+    int16_t temperature = sample->temperature;
+    int16_t humidity = sample->humidity;
+    
+    if(!beacon->has_reading) {
+        beacon->has_reading = true;
+        beacon->temperature = temperature;
+        beacon->humidity = humidity;
+        beacon->tick = sample->tick;
+        beacon->interval = 0;
+        dht11_beacon_publish(beacon);
+        return;
+    }
+    
+    beacon->deltas[beacon->batch][0] = CLAMP(temperature - beacon->temperature, INT8_MAX, INT8_MIN);
+    beacon->deltas[beacon->batch][1] = CLAMP(humidity - beacon->humidity, INT8_MAX, INT8_MIN);
+    beacon->batch++;
+    beacon->temperature = temperature;
+    beacon->humidity = humidity;
+    beacon->interval = sample->tick - beacon->tick;
+    beacon->tick = sample->tick;
+    
+    // Small changes wait for the batch; large ones go out at once
+    if(beacon->batch == DHT11_BEACON_BATCH ||
+       abs(temperature - beacon->advertised_temperature) >= DHT11_BEACON_CHANGE_TEMPERATURE ||
+       abs(humidity - beacon->advertised_humidity) >= DHT11_BEACON_CHANGE_HUMIDITY) {
+        dht11_beacon_publish(beacon);
+    }
+}
+
+/**
+ * @brief Beacon thread
+ * 
+ * @param context Pointer to the beacon
+ * @return Thread exit code
+ */
+static int32_t dht11_beacon_worker(void* context) {
+    DHT11Beacon* beacon = context;
+    DHT11Sample sample;
+    
+    while(true) {
+        uint32_t flags =
+            furi_thread_flags_wait(DHT11BeaconFlagStop, FuriFlagWaitAny, furi_ms_to_ticks(DHT11_BEACON_POLL_MS));
+        if(!(flags & FuriFlagError) && (flags & DHT11BeaconFlagStop)) {
+            break;
+        }
+        
+        while(dht11_sample_buffer_read(beacon->samples, &beacon->cursor, &sample)) {
+            if(sample.ok && sample.sensor == beacon->sensor) {
+                dht11_beacon_add(beacon, &sample);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+DHT11Beacon* dht11_beacon_alloc(const DHT11SampleBuffer* samples) {
+    DHT11Beacon* beacon = malloc(sizeof(DHT11Beacon));
+    memset(beacon, 0, sizeof(DHT11Beacon));
+    beacon->samples = samples;
+    
+    beacon->thread =
+        furi_thread_alloc_ex("Dht11Beacon", DHT11_BEACON_STACK_SIZE, dht11_beacon_worker, beacon);
+    
+    return beacon;
+}
+
+void dht11_beacon_free(DHT11Beacon* beacon) {
+    furi_assert(beacon);
+    dht11_beacon_stop(beacon);
+    furi_thread_free(beacon->thread);
+    free(beacon);
+}
+
+bool dht11_beacon_start(DHT11Beacon* beacon, uint8_t sensor) {
+    furi_assert(beacon);
+    
+    if(beacon->running) {
+        return true;
+    }
+    
+    // A random static address derived from the device's own stays the same across runs
+    GapExtraBeaconConfig config = {
+        .min_adv_interval_ms = DHT11_BEACON_ADV_MIN_MS,
+        .max_adv_interval_ms = DHT11_BEACON_ADV_MAX_MS,
+        .adv_channel_map = GapAdvChannelMapAll,
+        .adv_power_level = GapAdvPowerLevel_0dBm,
+        .address_type = GapAddressTypeRandom,
+    };
+    memcpy(config.address, furi_hal_version_get_ble_mac(), sizeof(config.address));
+    config.address[sizeof(config.address) - 1] |= 0xC0;
+    
+    if(!furi_hal_bt_extra_beacon_set_config(&config)) {
+        FURI_LOG_E("DHT11", "Failed to configure beacon");
+        return false;
+    }
+    
+    beacon->sensor = sensor;
+    beacon->has_reading = false;
+    beacon->batch = 0;
+    beacon->updates = 0;
+    
+    // Only readings taken from now on
+    beacon->cursor = beacon->samples->head;
+    
+    beacon->running = true;
+    furi_thread_start(beacon->thread);
+    return true;
+}
+
+void dht11_beacon_stop(DHT11Beacon* beacon) {
+    furi_assert(beacon);
+    
+    if(!beacon->running) {
+        return;
+    }
+    
+    furi_thread_flags_set(furi_thread_get_id(beacon->thread), DHT11BeaconFlagStop);
+    furi_thread_join(beacon->thread);
+    
+    if(furi_hal_bt_extra_beacon_is_active()) {
+        furi_hal_bt_extra_beacon_stop();
+    }
+    beacon->running = false;
+}
+
+bool dht11_beacon_is_running(const DHT11Beacon* beacon) {
+    furi_assert(beacon);
+    return beacon->running;
+}
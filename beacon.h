@@ -0,0 +1,101 @@
+/**
+ * @file beacon.h
+ * @brief BTHome BLE broadcast of the latest readings
+ * 
+ * Drains the acquisition sample buffer from its own thread and advertises
+ * one sensor's newest reading as a BTHome v2 service data payload, so any
+ * number of collectors can pick it up without pairing. The readings since
+ * the previous payload travel along as a batch of small deltas in a raw
+ * object. The payload is rebuilt only when the reading moves by more than
+ * the change thresholds or the batch is full; in between the radio keeps
+ * repeating the same advertisement without involving the app.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include "sample_buffer.h"
+
+/** @brief Interval at which the sample buffer is drained */
+#define DHT11_BEACON_POLL_MS 1000
+
+/** @brief Shortest advertising interval */
+#define DHT11_BEACON_ADV_MIN_MS 1000
+
+/** @brief Longest advertising interval */
+#define DHT11_BEACON_ADV_MAX_MS 1250
+
+/** @brief Readings collected as deltas before the payload is refreshed anyway */
+#define DHT11_BEACON_BATCH 6
+
+/** @brief Temperature change in tenths of a degree that is advertised at once */
+#define DHT11_BEACON_CHANGE_TEMPERATURE 5
+
+/** @brief Humidity change in tenths of a percent that is advertised at once */
+#define DHT11_BEACON_CHANGE_HUMIDITY 20
+
+/** @brief BTHome service UUID */
+#define DHT11_BEACON_BTHOME_UUID 0xFCD2
+
+/**
+ * @brief Beacon state
+ */
+typedef struct {
+    FuriThread* thread;                         /**< Worker thread */
+    const DHT11SampleBuffer* samples;           /**< Source of samples */
+    uint32_t cursor;                            /**< Read position in the sample buffer */
+    uint8_t sensor;                             /**< Index of the advertised sensor */
+    bool running;                               /**< Advertising is configured */
+    bool has_reading;                           /**< temperature and humidity are set */
+    int16_t temperature;                        /**< Newest temperature in tenths */
+    int16_t humidity;                           /**< Newest humidity in tenths */
+    uint32_t tick;                              /**< Tick of the newest reading */
+    uint32_t interval;                          /**< Ticks between the last two readings */
+    int16_t advertised_temperature;             /**< Temperature in the current payload */
+    int16_t advertised_humidity;                /**< Humidity in the current payload */
+    int8_t deltas[DHT11_BEACON_BATCH][2];       /**< Temperature and humidity steps since the payload */
+    uint8_t batch;                              /**< Valid entries in deltas */
+    uint8_t packet_id;                          /**< BTHome packet id, bumped with every payload */
+    volatile uint32_t updates;                  /**< Payloads built since start */
+} DHT11Beacon;
+
+/**
+ * @brief Allocate a beacon reading from a sample buffer
+ * 
+ * @param samples Sample buffer to drain, usually the acquisition's
+ * @return Pointer to the allocated beacon
+ */
+DHT11Beacon* dht11_beacon_alloc(const DHT11SampleBuffer* samples);
+
+/**
+ * @brief Free the beacon, stopping it first if needed
+ * 
+ * @param beacon Pointer to the beacon
+ */
+void dht11_beacon_free(DHT11Beacon* beacon);
+
+/**
+ * @brief Start advertising one sensor's readings
+ * 
+ * Advertising begins with the next good reading of that sensor.
+ * 
+ * @param beacon Pointer to the beacon
+ * @param sensor Index of the sensor to advertise
+ * @return true if the radio accepted the beacon configuration
+ */
+bool dht11_beacon_start(DHT11Beacon* beacon, uint8_t sensor);
+
+/**
+ * @brief Stop advertising
+ * 
+ * @param beacon Pointer to the beacon
+ */
+void dht11_beacon_stop(DHT11Beacon* beacon);
+
+/**
+ * @brief Check whether the beacon is running
+ * 
+ * @param beacon Pointer to the beacon
+ * @return true if advertising is configured
+ */
+bool dht11_beacon_is_running(const DHT11Beacon* beacon);
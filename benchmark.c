@@ -0,0 +1,391 @@
+/**
+ * @file benchmark.c
+ * @brief Read parameter sweep implementation
+ */
+
+#include "benchmark.h"
+#include "format.h"
+#include <furi_hal.h>
+
+/** @brief Room for the storage calls of the report */
+#define DHT11_BENCHMARK_STACK_SIZE 2048
+
+/** @brief Longest report line */
+#define DHT11_BENCHMARK_LINE_SIZE 128
+
+/** @brief Benchmark thread flags */
+typedef enum {
+    DHT11BenchmarkFlagStop = (1 << 0),     /**< Stop the sweep and report */
+} DHT11BenchmarkFlag;
+
+static const uint8_t dht11_benchmark_thresholds[DHT11_BENCHMARK_THRESHOLD_COUNT] = DHT11_BENCHMARK_THRESHOLDS_US;
+static const uint8_t dht11_benchmark_start_ms[DHT11_BENCHMARK_START_COUNT] = DHT11_BENCHMARK_START_MS;
+static const uint8_t dht11_benchmark_recovery[DHT11_BENCHMARK_RECOVERY_COUNT] = DHT11_BENCHMARK_RECOVERY_FLIPS;
+
+void dht11_benchmark_config(uint8_t index, DHT11BenchmarkConfig* config) {
+    furi_check(index < DHT11_BENCHMARK_CONFIGS);
+    
+    // Backend varies fastest, so both backends see the sensor in the same state
+    config->backend = (index & 1) ? DHT11ReadBackendCapture : DHT11ReadBackendPolling;
+    config->pull_up = !(index & 2);
+    index >>= 2;
+    config->start_ms = dht11_benchmark_start_ms[index % DHT11_BENCHMARK_START_COUNT];
+    index /= DHT11_BENCHMARK_START_COUNT;
+    config->threshold_us = dht11_benchmark_thresholds[index % DHT11_BENCHMARK_THRESHOLD_COUNT];
+    config->recovery_flips = dht11_benchmark_recovery[index / DHT11_BENCHMARK_THRESHOLD_COUNT];
+}
+
+const char* dht11_benchmark_backend_name(DHT11ReadBackend backend) {
+    return backend == DHT11ReadBackendCapture ? "capture" : "polling";
+}
+
+/**
+ * @brief Observer hook: count the transaction in the current configuration
+ * 
+ * @param context Pointer to the benchmark
+ * @param driver Handle that was read
+ * @param transaction The finished transaction
+ */
+static void dht11_benchmark_observe(void* context, DHT11Driver* driver, const DHT11DriverTransaction* transaction) {
+    UNUSED(driver);
+    DHT11Benchmark* benchmark = context;
+    
+    furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+    dht11_stats_record(
+        &benchmark->current,
+        transaction->transfer->status,
+        transaction->transfer->recovered_bits > 0,
+        transaction->latency_us,
+        transaction->irq_off_us,
+        transaction->start_ms * 1000);
+    furi_mutex_release(benchmark->mutex);
+}
+
+/**
+ * @brief Apply a configuration to the benchmark's handle
+ * 
+ * @param benchmark Pointer to the benchmark
+ * @param config Configuration to run
+ */
+static void dht11_benchmark_apply(DHT11Benchmark* benchmark, const DHT11BenchmarkConfig* config) {
+    DHT11Driver* driver = benchmark->driver;
+    
+    dht11_driver_set_backend(driver, config->backend);
+    dht11_driver_set_start_ms(driver, config->start_ms);
+    dht11_driver_set_pull_up(driver, config->pull_up);
+    dht11_driver_set_recovery(driver, config->recovery_flips);
+    
+    // Every configuration starts calibration afresh
+    dht11_driver_set_threshold(driver, config->threshold_us);
+    dht11_driver_set_adaptive(driver, config->threshold_us == 0);
+}
+
+/**
+ * @brief Summarize the counters of a finished configuration
+ * 
+ * @param stats Counters of the configuration
+ * @param result Output summary
+ */
+static void dht11_benchmark_summarize(const DHT11Stats* stats, DHT11BenchmarkResult* result) {
+    result->attempts = stats->attempts;
+    result->successes = stats->successes;
+    result->recovered = stats->recovered;
+    result->latency_mean_us = dht11_stats_latency_mean_us(stats);
+    result->latency_max_us = stats->latency_max_us;
+    result->irq_off_mean_us = dht11_stats_irq_off_mean_us(stats);
+    result->irq_off_max_us = stats->irq_off_max_us;
+    
+    result->failure = DHT11StatusOk;
+    for(uint8_t i = DHT11StatusOk + 1; i < DHT11StatusCount; i++) {
+        if(stats->failures[i] > (result->failure ? stats->failures[result->failure] : 0)) {
+            result->failure = i;
+        }
+    }
+}
+
+/**
+ * @brief Index of the finished configuration with the best success rate
+ * 
+ * Ties go to fewer recovered reads, then to the shorter interrupts-off
+ * window.
+ * 
+ * @param benchmark Pointer to the benchmark
+ * @param count Number of finished configurations
+ * @return Best configuration, 0 if none finished
+ */
+static uint8_t dht11_benchmark_best(const DHT11Benchmark* benchmark, uint8_t count) {
+    uint8_t best = 0;
+    
+    for(uint8_t i = 1; i < count; i++) {
+        const DHT11BenchmarkResult* a = &benchmark->results[i];
+        const DHT11BenchmarkResult* b = &benchmark->results[best];
+        if(a->successes != b->successes) {
+            if(a->successes > b->successes) {
+                best = i;
+            }
+        } else if(a->recovered != b->recovered) {
+            if(a->recovered < b->recovered) {
+                best = i;
+            }
+        } else if(a->irq_off_mean_us < b->irq_off_mean_us) {
+            best = i;
+        }
+    }
+    
+    return best;
+}
+
+/**
+ * @brief Print a count as a percentage of another with one decimal
+ * 
+ * @param buffer Output buffer
+ * @param size Size of the output buffer
+ * @param count Part
+ * @param total Whole
+ */
+static void dht11_benchmark_format_percent(char* buffer, size_t size, uint32_t count, uint32_t total) {
+    dht11_format_fixed(buffer, size, total ? count * 1000 / total : 0, 1);
+}
+
+/**
+ * @brief Write one line of the report
+ * 
+ * @param file Open report file
+ * @param line Text to write
+ * @param length Length of the text, clamped to the line buffer
+ * @return true if the line was written
+ */
+static bool dht11_benchmark_write_line(File* file, const char* line, int length) {
+    length = MIN((size_t)MAX(length, 0), DHT11_BENCHMARK_LINE_SIZE - 1);
+    return storage_file_write(file, line, length) == (size_t)length;
+}
+
+/**
+ * @brief Write the report of every finished configuration
+ * 
+ * @param benchmark Pointer to the benchmark
+ * @param count Number of finished configurations
+ * @return true if the report was written
+ */
+static bool dht11_benchmark_report(DHT11Benchmark* benchmark, uint8_t count) {
+    File* file = storage_file_alloc(benchmark->storage);
+    char line[DHT11_BENCHMARK_LINE_SIZE];
+    bool ok = storage_file_open(file, DHT11_BENCHMARK_REPORT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    
+    if(ok) {
+        const DHT11Driver* driver = benchmark->driver;
+        int length = snprintf(
+            line,
+            sizeof(line),
+            "# DHT11 benchmark: sensor %s (%s), %u reads per configuration at %ums\n",
+            benchmark->name,
+            driver->protocol->name,
+            DHT11_BENCHMARK_READS,
+            driver->protocol->min_interval_ms);
+        ok = dht11_benchmark_write_line(file, line, length);
+        
+        length = snprintf(
+            line,
+            sizeof(line),
+            "# Finished %u of %u configurations, RTC %lu\n",
+            count,
+            DHT11_BENCHMARK_CONFIGS,
+            (unsigned long)furi_hal_rtc_get_timestamp());
+        ok = ok && dht11_benchmark_write_line(file, line, length);
+        
+        static const char columns[] =
+            "recovery_flips,threshold_us,start_ms,pull_up,backend,reads,ok_pct,recovered_pct,"
+            "latency_mean_us,latency_max_us,irq_off_mean_us,irq_off_max_us,top_failure\n";
+        ok = ok && dht11_benchmark_write_line(file, columns, strlen(columns));
+        
+        for(uint8_t i = 0; i < count && ok; i++) {
+            const DHT11BenchmarkResult* result = &benchmark->results[i];
+            DHT11BenchmarkConfig config;
+            char success[DHT11_FORMAT_FIXED_SIZE];
+            char recovered[DHT11_FORMAT_FIXED_SIZE];
+            
+            dht11_benchmark_config(i, &config);
+            dht11_benchmark_format_percent(success, sizeof(success), result->successes, result->attempts);
+            dht11_benchmark_format_percent(recovered, sizeof(recovered), result->recovered, result->attempts);
+            length = snprintf(
+                line,
+                sizeof(line),
+                "%u,%u,%u,%u,%s,%u,%s,%s,%lu,%lu,%lu,%lu,%s\n",
+                config.recovery_flips,
+                config.threshold_us,
+                config.start_ms,
+                config.pull_up,
+                dht11_benchmark_backend_name(config.backend),
+                result->attempts,
+                success,
+                recovered,
+                (unsigned long)result->latency_mean_us,
+                (unsigned long)result->latency_max_us,
+                (unsigned long)result->irq_off_mean_us,
+                (unsigned long)result->irq_off_max_us,
+                result->failure ? dht11_decoder_status_name(result->failure) : "-");
+            ok = dht11_benchmark_write_line(file, line, length);
+        }
+        
+        if(ok && count > 0) {
+            DHT11BenchmarkConfig config;
+            dht11_benchmark_config(dht11_benchmark_best(benchmark, count), &config);
+            length = snprintf(
+                line,
+                sizeof(line),
+                "# Best: threshold %uus, start %ums, pull-up %s, %s, recovery %u\n",
+                config.threshold_us,
+                config.start_ms,
+                config.pull_up ? "on" : "off",
+                dht11_benchmark_backend_name(config.backend),
+                config.recovery_flips);
+            ok = dht11_benchmark_write_line(file, line, length);
+        }
+        
+        storage_file_close(file);
+    }
+    
+    if(!ok) {
+        FURI_LOG_E("DHT11", "Failed to write benchmark report %s", DHT11_BENCHMARK_REPORT_PATH);
+    }
+    
+    storage_file_free(file);
+    return ok;
+}
+
+/**
+ * @brief Call the progress callback, if any
+ * 
+ * @param benchmark Pointer to the benchmark
+ */
+static void dht11_benchmark_notify(DHT11Benchmark* benchmark) {
+    if(benchmark->callback) {
+        benchmark->callback(benchmark->callback_context);
+    }
+}
+
+/**
+ * @brief Benchmark thread body
+ * 
+ * @return Always returns 0
+ */
+static int32_t dht11_benchmark_worker(void* context) {
+    DHT11Benchmark* benchmark = context;
+    DHT11Driver* driver = benchmark->driver;
+    uint8_t finished = 0;
+    bool stop = false;
+    
+    while(finished < DHT11_BENCHMARK_CONFIGS && !stop) {
+        DHT11BenchmarkConfig config;
+        dht11_benchmark_config(finished, &config);
+        dht11_benchmark_apply(benchmark, &config);
+        
+        furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+        benchmark->reads = 0;
+        dht11_stats_reset(&benchmark->current, furi_get_tick());
+        furi_mutex_release(benchmark->mutex);
+        
+        for(uint16_t i = 0; i < DHT11_BENCHMARK_READS; i++) {
+            // Wait out the minimum interval on the stop flag, so Back answers at once
+            uint32_t wait = dht11_sensor_cache_wait_ticks(&driver->cache, furi_get_tick());
+            uint32_t flags = furi_thread_flags_wait(DHT11BenchmarkFlagStop, FuriFlagWaitAny, wait);
+            if(!(flags & FuriFlagError) && (flags & DHT11BenchmarkFlagStop)) {
+                stop = true;
+                break;
+            }
+            
+            DHT11Reading reading;
+            dht11_driver_read(driver, &reading);
+            
+            furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+            benchmark->reads = i + 1;
+            furi_mutex_release(benchmark->mutex);
+            dht11_benchmark_notify(benchmark);
+        }
+        
+        // A configuration cut short is left out of the report
+        if(!stop) {
+            furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+            dht11_benchmark_summarize(&benchmark->current, &benchmark->results[finished]);
+            benchmark->completed = ++finished;
+            furi_mutex_release(benchmark->mutex);
+        }
+    }
+    
+    bool reported = dht11_benchmark_report(benchmark, finished);
+    
+    furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+    benchmark->finished = true;
+    benchmark->reported = reported;
+    furi_mutex_release(benchmark->mutex);
+    dht11_benchmark_notify(benchmark);
+    
+    // Once done, idle until asked to stop
+    if(!stop) {
+        furi_thread_flags_wait(DHT11BenchmarkFlagStop, FuriFlagWaitAny, FuriWaitForever);
+    }
+    
+    return 0;
+}
+
+DHT11Benchmark* dht11_benchmark_alloc(const GpioPin* pin, DHT11ProtocolType family, const char* name) {
+    DHT11Benchmark* benchmark = malloc(sizeof(DHT11Benchmark));
+    memset(benchmark, 0, sizeof(DHT11Benchmark));
+    benchmark->name = name;
+    benchmark->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    benchmark->storage = furi_record_open(RECORD_STORAGE);
+    dht11_stats_reset(&benchmark->current, furi_get_tick());
+    
+    benchmark->driver = dht11_driver_alloc(pin, family);
+    const DHT11DriverHooks hooks = {
+        .observe = dht11_benchmark_observe,
+        .context = benchmark,
+    };
+    dht11_driver_set_hooks(benchmark->driver, &hooks);
+    
+    benchmark->thread = furi_thread_alloc_ex(
+        "Dht11Benchmark", DHT11_BENCHMARK_STACK_SIZE, dht11_benchmark_worker, benchmark);
+    
+    return benchmark;
+}
+
+void dht11_benchmark_free(DHT11Benchmark* benchmark) {
+    furi_assert(benchmark);
+    
+    if(benchmark->started) {
+        furi_thread_flags_set(furi_thread_get_id(benchmark->thread), DHT11BenchmarkFlagStop);
+        furi_thread_join(benchmark->thread);
+    }
+    furi_thread_free(benchmark->thread);
+    
+    // Leave the line as the app's own handle expects it
+    dht11_driver_set_pull_up(benchmark->driver, true);
+    dht11_driver_free(benchmark->driver);
+    
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(benchmark->mutex);
+    free(benchmark);
+}
+
+void dht11_benchmark_start(DHT11Benchmark* benchmark, DHT11BenchmarkCallback callback, void* context) {
+    furi_assert(benchmark);
+    benchmark->callback = callback;
+    benchmark->callback_context = context;
+    benchmark->started = true;
+    furi_thread_start(benchmark->thread);
+}
+
+void dht11_benchmark_get_progress(DHT11Benchmark* benchmark, DHT11BenchmarkProgress* progress) {
+    furi_assert(benchmark);
+    furi_check(furi_mutex_acquire(benchmark->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    progress->completed = benchmark->completed;
+    progress->reads = benchmark->reads;
+    progress->current = benchmark->current;
+    progress->best = dht11_benchmark_best(benchmark, benchmark->completed);
+    progress->best_result = benchmark->results[progress->best];
+    progress->finished = benchmark->finished;
+    progress->reported = benchmark->reported;
+    
+    furi_mutex_release(benchmark->mutex);
+}
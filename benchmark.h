@@ -0,0 +1,169 @@
+/**
+ * @file benchmark.h
+ * @brief Read parameter sweep for characterising sensors and cabling
+ * 
+ * Runs DHT11_BENCHMARK_READS reads at the family's minimum interval for
+ * every combination of checksum recovery, bit threshold, start pulse,
+ * internal pull-up and read backend. The reads go through a driver handle
+ * of its own on the sensor's pin, so the app's learned threshold is left
+ * alone, and are counted with the read path statistics through the
+ * observer hook. When the sweep ends, or is stopped, one line per finished
+ * configuration is written to DHT11_BENCHMARK_REPORT_PATH.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include "driver.h"
+#include "stats.h"
+
+/** @brief Report location, replaced by every run */
+#define DHT11_BENCHMARK_REPORT_PATH APP_DATA_PATH("benchmark.txt")
+
+/** @brief Reads per configuration */
+#define DHT11_BENCHMARK_READS 50
+
+/** @brief Fixed bit thresholds swept, 0 for the family's threshold with learning on */
+#define DHT11_BENCHMARK_THRESHOLDS_US {0, 30, 40, 50}
+
+/** @brief Start pulse lengths swept */
+#define DHT11_BENCHMARK_START_MS {1, 2, 18, 25}
+
+/** @brief Checksum recovery limits swept, in bits flipped, 0 for off */
+#define DHT11_BENCHMARK_RECOVERY_FLIPS {0, 1, 2}
+
+/** @brief Number of bit thresholds in the sweep */
+#define DHT11_BENCHMARK_THRESHOLD_COUNT 4
+
+/** @brief Number of start pulse lengths in the sweep */
+#define DHT11_BENCHMARK_START_COUNT 4
+
+/** @brief Number of checksum recovery limits in the sweep */
+#define DHT11_BENCHMARK_RECOVERY_COUNT 3
+
+/** @brief Number of configurations: recovery limits, thresholds, start pulses, pull-up on and off, both backends */
+#define DHT11_BENCHMARK_CONFIGS \
+    (DHT11_BENCHMARK_RECOVERY_COUNT * DHT11_BENCHMARK_THRESHOLD_COUNT * DHT11_BENCHMARK_START_COUNT * 2 * 2)
+
+/**
+ * @brief One point of the sweep
+ */
+typedef struct {
+    uint8_t threshold_us;       /**< Fixed bit threshold, 0 to learn it */
+    uint8_t start_ms;           /**< Start pulse length */
+    bool pull_up;               /**< Internal pull-up enabled */
+    DHT11ReadBackend backend;   /**< Backend receiving the transfers */
+    uint8_t recovery_flips;     /**< Most bits checksum recovery flips, 0 for off */
+} DHT11BenchmarkConfig;
+
+/**
+ * @brief Summary of one finished configuration
+ */
+typedef struct {
+    uint16_t attempts;          /**< Transactions run */
+    uint16_t successes;         /**< Transactions with a valid reading */
+    uint16_t recovered;         /**< Successes that needed checksum recovery */
+    DHT11Status failure;        /**< Most frequent failure, DHT11StatusOk if none */
+    uint32_t latency_mean_us;   /**< Mean transaction duration */
+    uint32_t latency_max_us;    /**< Longest transaction */
+    uint32_t irq_off_mean_us;   /**< Mean interrupts-disabled window */
+    uint32_t irq_off_max_us;    /**< Longest interrupts-disabled window */
+} DHT11BenchmarkResult;
+
+/**
+ * @brief Progress callback, called from the benchmark thread after every read
+ * 
+ * @param context Context given to dht11_benchmark_start()
+ */
+typedef void (*DHT11BenchmarkCallback)(void* context);
+
+/**
+ * @brief Snapshot of a running benchmark
+ */
+typedef struct {
+    uint8_t completed;          /**< Configurations finished; the next one is being run */
+    uint16_t reads;             /**< Reads done in the configuration being run */
+    DHT11Stats current;         /**< Counters of that configuration so far */
+    uint8_t best;               /**< Finished configuration with the best success rate, once completed > 0 */
+    DHT11BenchmarkResult best_result; /**< Summary of the best configuration */
+    bool finished;              /**< The sweep ended or was stopped */
+    bool reported;              /**< The report was written */
+} DHT11BenchmarkProgress;
+
+/**
+ * @brief Benchmark state
+ */
+typedef struct {
+    DHT11Driver* driver;                /**< Handle used for the sweep */
+    const char* name;                   /**< Sensor name for the report */
+    FuriThread* thread;                 /**< Benchmark thread */
+    FuriMutex* mutex;                   /**< Guards the progress fields */
+    Storage* storage;                   /**< Storage record for the report */
+    DHT11BenchmarkCallback callback;    /**< Progress callback */
+    void* callback_context;             /**< Context for callback */
+    bool started;                       /**< The thread was started */
+    
+    // Progress, written by the benchmark thread
+    uint8_t completed;                  /**< Configurations finished */
+    uint16_t reads;                     /**< Reads done in the configuration being run */
+    DHT11Stats current;                 /**< Counters of that configuration */
+    bool finished;                      /**< The sweep ended or was stopped */
+    bool reported;                      /**< The report was written */
+    DHT11BenchmarkResult results[DHT11_BENCHMARK_CONFIGS]; /**< Finished configurations */
+} DHT11Benchmark;
+
+/**
+ * @brief Get the parameters of a configuration
+ * 
+ * @param index Configuration index, below DHT11_BENCHMARK_CONFIGS
+ * @param config Output for the parameters
+ */
+void dht11_benchmark_config(uint8_t index, DHT11BenchmarkConfig* config);
+
+/**
+ * @brief Allocate a benchmark for a sensor
+ * 
+ * The caller keeps every other reader off the pin until the benchmark is
+ * freed.
+ * 
+ * @param pin GPIO pin connected to the sensor's data line
+ * @param family Sensor family
+ * @param name Sensor name for the report
+ * @return Pointer to the allocated benchmark
+ */
+DHT11Benchmark* dht11_benchmark_alloc(const GpioPin* pin, DHT11ProtocolType family, const char* name);
+
+/**
+ * @brief Stop a running sweep and free the benchmark
+ * 
+ * A stopped sweep still reports its finished configurations.
+ * 
+ * @param benchmark Pointer to the benchmark
+ */
+void dht11_benchmark_free(DHT11Benchmark* benchmark);
+
+/**
+ * @brief Start the sweep
+ * 
+ * @param benchmark Pointer to the benchmark
+ * @param callback Progress callback, may be NULL
+ * @param context Context for callback
+ */
+void dht11_benchmark_start(DHT11Benchmark* benchmark, DHT11BenchmarkCallback callback, void* context);
+
+/**
+ * @brief Copy the progress of the sweep
+ * 
+ * @param benchmark Pointer to the benchmark
+ * @param progress Output for a consistent snapshot
+ */
+void dht11_benchmark_get_progress(DHT11Benchmark* benchmark, DHT11BenchmarkProgress* progress);
+
+/**
+ * @brief Name of a read backend for display
+ * 
+ * @param backend Read backend
+ * @return Short name
+ */
+const char* dht11_benchmark_backend_name(DHT11ReadBackend backend);
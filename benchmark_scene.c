@@ -0,0 +1,189 @@
+/**
+ * @file benchmark_scene.c
+ * @brief Benchmark scene implementation
+ * 
+ * The sweep owns the selected sensor's data line while the scene is
+ * shown: background acquisition is stopped on entry and restarted on
+ * exit. Leaving early stops the sweep, which still reports the
+ * configurations it finished.
+ */
+
+#include "benchmark_scene.h"
+#include "benchmark.h"
+#include "scenes.h"
+#include "scene_views.h"
+#include "format.h"
+#include <stdarg.h>
+
+/**
+ * @brief Append formatted text to the benchmark buffer
+ * 
+ * @param app Pointer to the application instance
+ * @param pos Current write position, advanced by the appended length
+ * @param format printf-style format string
+ */
+static void dht11_benchmark_text_append(DHT11App* app, size_t* pos, const char* format, ...) {
+    if(*pos >= DHT11_BENCHMARK_TEXT_SIZE - 1) {
+        return;
+    }
+    
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(app->benchmark_text + *pos, DHT11_BENCHMARK_TEXT_SIZE - *pos, format, args);
+    va_end(args);
+    
+    if(written > 0) {
+        *pos = MIN(*pos + written, DHT11_BENCHMARK_TEXT_SIZE - 1);
+    }
+}
+
+/**
+ * @brief Append the parameters of a configuration
+ * 
+ * @param app Pointer to the application instance
+ * @param pos Current write position, advanced by the appended length
+ * @param index Configuration index
+ */
+static void dht11_benchmark_append_config(DHT11App* app, size_t* pos, uint8_t index) {
+    DHT11BenchmarkConfig config;
+    dht11_benchmark_config(index, &config);
+    
+    if(config.threshold_us) {
+        dht11_benchmark_text_append(app, pos, "%uus", config.threshold_us);
+    } else {
+        dht11_benchmark_text_append(app, pos, "learned");
+    }
+    dht11_benchmark_text_append(
+        app,
+        pos,
+        " %ums pull-up %s %s rec %u\n",
+        config.start_ms,
+        config.pull_up ? "on" : "off",
+        dht11_benchmark_backend_name(config.backend),
+        config.recovery_flips);
+}
+
+/**
+ * @brief Render the progress into the text box
+ * 
+ * @param app Pointer to the application instance
+ */
+static void dht11_benchmark_scene_update(DHT11App* app) {
+    DHT11BenchmarkProgress progress;
+    char percent[DHT11_FORMAT_FIXED_SIZE];
+    size_t pos = 0;
+    
+    dht11_benchmark_get_progress(app->benchmark, &progress);
+    const DHT11Stats* current = &progress.current;
+    const DHT11Sensor* sensor = &app->sensors[app->selected_sensor];
+    
+    dht11_benchmark_text_append(app, &pos, "=== Benchmark ===\n");
+    dht11_benchmark_text_append(app, &pos, "Sensor: %s (%s)\n", sensor->name, sensor->driver->protocol->name);
+    
+    if(!progress.finished) {
+        dht11_benchmark_text_append(
+            app, &pos, "Config %u/%u: ", progress.completed + 1, DHT11_BENCHMARK_CONFIGS);
+        dht11_benchmark_append_config(app, &pos, progress.completed);
+        dht11_benchmark_text_append(
+            app,
+            &pos,
+            "Reads: %u/%u ok %lu rec %lu\n",
+            progress.reads,
+            DHT11_BENCHMARK_READS,
+            (unsigned long)current->successes,
+            (unsigned long)current->recovered);
+        dht11_benchmark_text_append(
+            app,
+            &pos,
+            "Latency: %luus IRQ off: %luus\n",
+            (unsigned long)dht11_stats_latency_mean_us(current),
+            (unsigned long)dht11_stats_irq_off_mean_us(current));
+        
+        uint32_t remaining = (DHT11_BENCHMARK_CONFIGS - progress.completed) * DHT11_BENCHMARK_READS -
+                             progress.reads;
+        dht11_benchmark_text_append(
+            app,
+            &pos,
+            "Remaining: ~%lumin\n",
+            (unsigned long)(remaining * sensor->driver->protocol->min_interval_ms / 60000 + 1));
+    } else {
+        dht11_benchmark_text_append(
+            app, &pos, "Finished %u/%u configs\n", progress.completed, DHT11_BENCHMARK_CONFIGS);
+        dht11_benchmark_text_append(
+            app, &pos, "Report: %s\n", progress.reported ? "benchmark.txt" : "write failed");
+    }
+    
+    if(progress.completed > 0) {
+        const DHT11BenchmarkResult* best = &progress.best_result;
+        dht11_format_fixed(
+            percent, sizeof(percent), best->attempts ? best->successes * 1000 / best->attempts : 0, 1);
+        dht11_benchmark_text_append(app, &pos, "\nBest: %s%% ok\n", percent);
+        dht11_benchmark_append_config(app, &pos, progress.best);
+    }
+    
+    text_box_set_text(app->benchmark_text_box, app->benchmark_text);
+}
+
+/**
+ * @brief Progress callback, called from the benchmark thread
+ * 
+ * @param context Application context
+ */
+static void dht11_benchmark_progress_callback(void* context) {
+    DHT11App* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, DHT11CustomEventBenchmarkProgress);
+}
+
+void dht11_scene_benchmark_on_enter(void* context) {
+    DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneBenchmark);
+    
+    text_box_set_font(app->benchmark_text_box, TextBoxFontText);
+    if(app->sensor_count > 0) {
+        // The sweep needs the line to itself
+        dht11_acquisition_stop(app->acquisition);
+        
+        const DHT11Sensor* sensor = &app->sensors[app->selected_sensor];
+        app->benchmark = dht11_benchmark_alloc(
+            sensor->driver->pin, sensor->driver->protocol - dht11_protocols, sensor->name);
+        dht11_benchmark_start(app->benchmark, dht11_benchmark_progress_callback, app);
+        dht11_benchmark_scene_update(app);
+    } else {
+        text_box_set_text(app->benchmark_text_box, "No sensors configured\n");
+    }
+    
+    view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneBenchmark);
+}
+
+bool dht11_scene_benchmark_on_event(void* context, SceneManagerEvent event) {
+    DHT11App* app = context;
+    bool consumed = false;
+    
+    if(event.type == SceneManagerEventTypeCustom && event.event == DHT11CustomEventBenchmarkProgress) {
+        if(app->benchmark) {
+            dht11_benchmark_scene_update(app);
+        }
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+    
+    return consumed;
+}
+
+void dht11_scene_benchmark_on_exit(void* context) {
+    DHT11App* app = context;
+    
+    if(app->benchmark) {
+        // Stopping early still reports the finished configurations
+        dht11_benchmark_free(app->benchmark);
+        app->benchmark = NULL;
+        
+        dht11_acquisition_start(app->acquisition);
+        dht11_acquisition_trigger(app->acquisition);
+    }
+    
+    text_box_reset(app->benchmark_text_box);
+    dht11_scene_view_release(app, DHT11SceneBenchmark);
+}
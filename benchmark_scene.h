@@ -0,0 +1,14 @@
+/**
+ * @file benchmark_scene.h
+ * @brief Benchmark scene interface
+ * 
+ * This file contains the interface for the benchmark scene which sweeps
+ * the read parameters on the selected sensor and shows the progress.
+ */
+
+#pragma once
+
+#include "app.h"
+
+/** @brief Size of the benchmark text, allocated while the scene is shown */
+#define DHT11_BENCHMARK_TEXT_SIZE 512
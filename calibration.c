@@ -0,0 +1,239 @@
+/**
+ * @file calibration.c
+ * @brief Adaptive bit threshold calibration implementation
+ */
+
+#include "calibration.h"
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define DHT11_CALIBRATION_FILETYPE "DHT11 Calibration"
+#define DHT11_CALIBRATION_VERSION 1
+
+/** @brief Key prefix of a sensor's threshold, followed by the pin name */
+#define DHT11_CALIBRATION_KEY "Threshold "
+
+void dht11_calibration_reset(DHT11Calibration* calibration, uint8_t default_us) {
+    memset(calibration, 0, sizeof(DHT11Calibration));
+    calibration->threshold_us = default_us;
+}
+
+/**
+ * @brief Split the histogram into two clusters
+ * 
+ * Otsu's method: the split that maximizes the variance between the two
+ * classes, which for two well separated peaks falls in the gap between them.
+ * 
+ * @param calibration Pointer to the calibration state
+ * @return Last bin of the lower cluster
+ */
+static uint8_t dht11_calibration_split(const DHT11Calibration* calibration) {
+    float total = 0.0f;
+    float sum = 0.0f;
+    for(uint8_t i = 0; i < DHT11_CALIBRATION_BINS; i++) {
+        total += calibration->bins[i];
+        sum += (float)i * calibration->bins[i];
+    }
+    
+    float weight_low = 0.0f;
+    float sum_low = 0.0f;
+    float best_variance = 0.0f;
+    uint8_t best_split = 0;
+    
+    for(uint8_t i = 0; i < DHT11_CALIBRATION_BINS - 1; i++) {
+        weight_low += calibration->bins[i];
+        sum_low += (float)i * calibration->bins[i];
+        
+        float weight_high = total - weight_low;
+        if(weight_low == 0.0f || weight_high == 0.0f) {
+            continue;
+        }
+        
+        float mean_low = sum_low / weight_low;
+        float mean_high = (sum - sum_low) / weight_high;
+        float variance = weight_low * weight_high * (mean_low - mean_high) * (mean_low - mean_high);
+        if(variance > best_variance) {
+            best_variance = variance;
+            best_split = i;
+        }
+    }
+    
+    return best_split;
+}
+
+/**
+ * @brief Place the threshold in the middle of the gap between the clusters
+ * 
+ * Bins holding less than 1% of the samples count as empty so that a few
+ * stray measurements do not narrow the gap.
+ * 
+ * @param calibration Pointer to the calibration state
+ * @param threshold_us Output for the derived threshold
+ * @param gap_us Output for the width of the gap
+ * @return true if two separated clusters were found
+ */
+static bool dht11_calibration_find_gap(
+    const DHT11Calibration* calibration,
+    uint8_t* threshold_us,
+    uint8_t* gap_us) {
+    uint8_t split = dht11_calibration_split(calibration);
+    uint32_t noise = calibration->samples / 100;
+    int low_edge = -1;
+    int high_edge = -1;
+    
+    for(int i = split; i >= 0; i--) {
+        if(calibration->bins[i] > noise) {
+            low_edge = i;
+            break;
+        }
+    }
+    for(int i = split + 1; i < DHT11_CALIBRATION_BINS; i++) {
+        if(calibration->bins[i] > noise) {
+            high_edge = i;
+            break;
+        }
+    }
+    if(low_edge < 0 || high_edge < 0) {
+        return false;
+    }
+    
+    // Midpoint between the top of the lower cluster and the bottom of the upper one
+    uint32_t zero_max = (low_edge + 1) * DHT11_CALIBRATION_BIN_US;
+    uint32_t one_min = high_edge * DHT11_CALIBRATION_BIN_US;
+    uint32_t threshold = (zero_max + one_min) / 2;
+    if(threshold < DHT11_CALIBRATION_MIN_US || threshold > DHT11_CALIBRATION_MAX_US) {
+        return false;
+    }
+    
+    *threshold_us = threshold;
+    *gap_us = MIN(one_min - zero_max, UINT8_MAX);
+    return true;
+}
+
+bool dht11_calibration_update(DHT11Calibration* calibration, const DHT11Transfer* transfer, uint32_t cycles_per_us) {
+    if(transfer->bits_read < DHT11_BIT_COUNT) {
+        return false;
+    }
+    
+    for(uint8_t i = 0; i < DHT11_BIT_COUNT; i++) {
+        uint32_t width_us = transfer->trace[DHT11_TRACE_BIT_HIGH(i)] / cycles_per_us;
+        calibration->bins[MIN(width_us / DHT11_CALIBRATION_BIN_US, DHT11_CALIBRATION_BINS - 1)]++;
+    }
+    calibration->samples += DHT11_BIT_COUNT;
+    
+    // Age old measurements so the threshold follows drift
+    if(calibration->samples >= DHT11_CALIBRATION_MAX_SAMPLES) {
+        calibration->samples = 0;
+        for(uint8_t i = 0; i < DHT11_CALIBRATION_BINS; i++) {
+            calibration->bins[i] /= 2;
+            calibration->samples += calibration->bins[i];
+        }
+    }
+    
+    uint8_t threshold_us = 0;
+    uint8_t gap_us = 0;
+    if(calibration->samples < DHT11_CALIBRATION_MIN_SAMPLES ||
+       !dht11_calibration_find_gap(calibration, &threshold_us, &gap_us)) {
+        return false;
+    }
+    
+    calibration->learned = true;
+    calibration->gap_us = gap_us;
+    if(threshold_us == calibration->threshold_us) {
+        return false;
+    }
+    
+    calibration->threshold_us = threshold_us;
+    calibration->dirty = true;
+    return true;
+}
+
+uint8_t dht11_calibration_margin_us(const DHT11Calibration* calibration) {
+    if(calibration->gap_us == 0) {
+        return DHT11_RECOVERY_MARGIN_US;
+    }
+    return MAX(calibration->gap_us * DHT11_CALIBRATION_MARGIN_PERCENT / 100, 1);
+}
+
+bool dht11_calibration_load(
+    const char* path,
+    DHT11Calibration* const* calibrations,
+    const char* const* names,
+    uint8_t count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+    uint32_t version = 0;
+    
+    bool ok = flipper_format_file_open_existing(file, path) &&
+              flipper_format_read_header(file, filetype, &version) &&
+              furi_string_equal_str(filetype, DHT11_CALIBRATION_FILETYPE) &&
+              version == DHT11_CALIBRATION_VERSION;
+    
+    for(uint8_t i = 0; ok && i < count; i++) {
+        uint32_t threshold_us = 0;
+        furi_string_printf(key, DHT11_CALIBRATION_KEY "%s", names[i]);
+        
+        // Keys may appear in any order
+        flipper_format_rewind(file);
+        if(flipper_format_read_uint32(file, furi_string_get_cstr(key), &threshold_us, 1) &&
+           threshold_us >= DHT11_CALIBRATION_MIN_US && threshold_us <= DHT11_CALIBRATION_MAX_US) {
+            calibrations[i]->threshold_us = threshold_us;
+            calibrations[i]->learned = true;
+        }
+    }
+    
+    furi_string_free(key);
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+bool dht11_calibration_save(
+    const char* path,
+    DHT11Calibration* const* calibrations,
+    const char* const* names,
+    uint8_t count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+    uint32_t version = 0;
+    
+    // Entries of sensors not attached this session are kept; only a
+    // missing or foreign file is started afresh
+    bool ok = flipper_format_file_open_existing(file, path) &&
+              flipper_format_read_header(file, filetype, &version) &&
+              furi_string_equal_str(filetype, DHT11_CALIBRATION_FILETYPE) &&
+              version == DHT11_CALIBRATION_VERSION;
+    if(!ok) {
+        flipper_format_file_close(file);
+        ok = flipper_format_file_open_always(file, path) &&
+             flipper_format_write_header_cstr(file, DHT11_CALIBRATION_FILETYPE, DHT11_CALIBRATION_VERSION);
+    }
+    
+    for(uint8_t i = 0; ok && i < count; i++) {
+        if(!calibrations[i]->learned) {
+            continue;
+        }
+        
+        uint32_t threshold_us = calibrations[i]->threshold_us;
+        furi_string_printf(key, DHT11_CALIBRATION_KEY "%s", names[i]);
+        flipper_format_rewind(file);
+        ok = flipper_format_insert_or_update_uint32(file, furi_string_get_cstr(key), &threshold_us, 1);
+        calibrations[i]->dirty = false;
+    }
+    
+    if(!ok) {
+        FURI_LOG_E("DHT11", "Failed to save calibration %s", path);
+    }
+    
+    furi_string_free(key);
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file calibration.h
+ * @brief Adaptive per-sensor bit threshold calibration
+ * 
+ * A '0' bit and a '1' bit differ only in the length of their high phase,
+ * nominally 26-28us against 70us. Clones and long cables shift both, so
+ * instead of a fixed cut-off every sensor keeps a histogram of its measured
+ * high phases and places its threshold in the gap between the two clusters.
+ * Learned thresholds are stored on the SD card, keyed by data pin.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "decoder.h"
+
+/** @brief Calibration file location */
+#define DHT11_CALIBRATION_PATH APP_DATA_PATH("calibration.txt")
+
+
+/** @brief Width of one histogram bin */
+#define DHT11_CALIBRATION_BIN_US 4
+
+/** @brief Number of histogram bins; longer phases land in the last one */
+#define DHT11_CALIBRATION_BINS 32
+
+/** @brief Samples needed before a threshold is derived, five transfers */
+#define DHT11_CALIBRATION_MIN_SAMPLES (5 * DHT11_BIT_COUNT)
+
+/** @brief Sample count at which the histogram is aged by halving */
+#define DHT11_CALIBRATION_MAX_SAMPLES 4096
+
+/** @brief Lowest threshold that is accepted */
+#define DHT11_CALIBRATION_MIN_US 16
+
+/** @brief Highest threshold that is accepted */
+#define DHT11_CALIBRATION_MAX_US 100
+
+/** @brief Share of the learned gap, in percent, within which checksum recovery may flip a bit */
+#define DHT11_CALIBRATION_MARGIN_PERCENT 25
+
+/**
+ * @brief Calibration state of one sensor
+ */
+typedef struct {
+    uint16_t bins[DHT11_CALIBRATION_BINS];  /**< Histogram of high phase lengths */
+    uint32_t samples;                       /**< Number of phases in the histogram */
+    uint8_t threshold_us;                   /**< High phase length above which a bit is a '1' */
+    uint8_t gap_us;                         /**< Width of the gap between the clusters, 0 until measured */
+    bool learned;                           /**< threshold_us was derived from measurements */
+    bool dirty;                             /**< Changed since last saved */
+} DHT11Calibration;
+
+/**
+ * @brief Reset to the default threshold with an empty histogram
+ * 
+ * @param calibration Pointer to the calibration state
+ * @param default_us Threshold used until the sensor has been calibrated
+ */
+void dht11_calibration_reset(DHT11Calibration* calibration, uint8_t default_us);
+
+/**
+ * @brief Feed the high phases of a transfer into the histogram
+ * 
+ * Only transfers with all 40 bits received are used; checksum failures
+ * are included since their timings are still valid measurements. Once
+ * enough phases have been collected the threshold is re-derived.
+ * 
+ * @param calibration Pointer to the calibration state
+ * @param transfer Received transfer record
+ * @param cycles_per_us Cycle counter ticks per microsecond
+ * @return true if the threshold changed
+ */
+bool dht11_calibration_update(DHT11Calibration* calibration, const DHT11Transfer* transfer, uint32_t cycles_per_us);
+
+/**
+ * @brief Distance from the threshold within which a bit is ambiguous
+ * 
+ * DHT11_CALIBRATION_MARGIN_PERCENT of the measured gap between the '0'
+ * and '1' clusters, so checksum recovery only flips bits that landed well
+ * inside the gap. DHT11_RECOVERY_MARGIN_US until the gap was measured.
+ * 
+ * @param calibration Pointer to the calibration state
+ * @return Margin in microseconds
+ */
+uint8_t dht11_calibration_margin_us(const DHT11Calibration* calibration);
+
+/**
+ * @brief Load learned thresholds from a calibration file
+ * 
+ * Sensors without an entry keep their current state.
+ * 
+ * @param path Calibration file path
+ * @param calibrations Calibration state of each sensor
+ * @param names Data pin name of each sensor, used as key
+ * @param count Number of sensors
+ * @return true if the file was read
+ */
+bool dht11_calibration_load(
+    const char* path,
+    DHT11Calibration* const* calibrations,
+    const char* const* names,
+    uint8_t count);
+
+/**
+ * @brief Store the learned thresholds in a calibration file
+ * 
+ * Entries are updated in place, so the thresholds of sensors that are not
+ * passed, such as ones unplugged for a session, are kept.
+ * 
+ * @param path Calibration file path
+ * @param calibrations Calibration state of each sensor, dirty flags are cleared
+ * @param names Data pin name of each sensor, used as key
+ * @param count Number of sensors
+ * @return true if the file was written
+ */
+bool dht11_calibration_save(
+    const char* path,
+    DHT11Calibration* const* calibrations,
+    const char* const* names,
+    uint8_t count);
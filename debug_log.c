@@ -0,0 +1,195 @@
+/**
+ * @file debug_log.c
+ * @brief Structured debug event ring buffer implementation
+ */
+
+#include "debug_log.h"
+#include "decoder.h"
+
+/** @brief Fixed description of the read backend, printed as steps 4-6 */
+static const char* const dht11_debug_log_backend_steps[][3] = {
+    {
+        "4. Critical section: Interrupts disabled\n",
+        "5. Release signal: Pin HIGH for 30us\n",
+        "6. Input mode: Pull-up enabled\n",
+    },
+    {
+        "4. Edge capture: Interrupts enabled\n",
+        "5. Release signal: Line released\n",
+        "6. Input mode: Pull-up, edge interrupt\n",
+    },
+};
+
+void dht11_debug_log_reset(DHT11DebugLog* log) {
+    memset(log, 0, sizeof(DHT11DebugLog));
+}
+
+void dht11_debug_log_push(DHT11DebugLog* log, DHT11DebugStep step, uint32_t cycles, uint32_t a, uint16_t b) {
+    DHT11DebugEvent* event = &log->events[log->head % DHT11_DEBUG_LOG_EVENTS];
+    event->cycles = cycles;
+    event->a = a;
+    event->b = b;
+    event->step = step;
+    log->head++;
+}
+
+void dht11_debug_log_begin(DHT11DebugLog* log, const char* pin_name, bool initial_level, uint8_t start_ms) {
+    uint32_t a = (uint32_t)start_ms << 24;
+    for(uint8_t i = 0; i < 3 && pin_name[i]; i++) {
+        a |= (uint32_t)(uint8_t)pin_name[i] << (8 * i);
+    }
+    
+    uint16_t b = (++log->transactions & 0x7FFF) | (initial_level ? 0x8000 : 0);
+    dht11_debug_log_push(log, DHT11DebugStepBegin, 0, a, b);
+}
+
+/**
+ * @brief Formatting state carried between the events of one transaction
+ */
+typedef struct {
+    char pin_name[4];       /**< Data pin name from the Begin event */
+    bool polling;           /**< Transaction used the polling backend */
+    uint8_t threshold_us;   /**< Bit threshold from the Threshold event */
+} DHT11DebugLogContext;
+
+/**
+ * @brief Append the text of one event
+ * 
+ * @param event Event to render
+ * @param context Formatting state of the current transaction
+ * @param text Output string, appended to
+ */
+static void dht11_debug_log_format_event(
+    const DHT11DebugEvent* event,
+    DHT11DebugLogContext* context,
+    FuriString* text) {
+    switch(event->step) {
+    case DHT11DebugStepBegin:
+        for(uint8_t i = 0; i < 3; i++) {
+            context->pin_name[i] = (char)(event->a >> (8 * i));
+        }
+        context->pin_name[3] = '\0';
+        furi_string_cat_printf(text, "=== DHT11 Debug Log #%u ===\n", event->b & 0x7FFF);
+        furi_string_cat_printf(text, "Pin: %s\n\n", context->pin_name);
+        furi_string_cat_str(text, "1. LED: Blue flash started\n");
+        furi_string_cat_printf(text, "2. Initial pin state: %s\n", (event->b & 0x8000) ? "HIGH" : "LOW");
+        furi_string_cat_printf(text, "3. Start signal: Pin LOW for %lums\n", (unsigned long)(event->a >> 24));
+        break;
+    case DHT11DebugStepBackend:
+        context->polling = event->a != 0;
+        for(uint8_t i = 0; i < 3; i++) {
+            furi_string_cat_str(text, dht11_debug_log_backend_steps[context->polling ? 0 : 1][i]);
+        }
+        break;
+    case DHT11DebugStepWaitResponse:
+        furi_string_cat_printf(text, "7. Wait for LOW: %luus timeout=%u\n", (unsigned long)event->a, event->b);
+        if(event->b) {
+            furi_string_cat_str(text, "ERROR: No response from DHT11\n");
+            furi_string_cat_printf(text, "Check: VCC->3.3V, GND->GND, DATA->%s\n", context->pin_name);
+        }
+        break;
+    case DHT11DebugStepResponseLow:
+        furi_string_cat_printf(text, "8. Response LOW: %luus\n", (unsigned long)event->a);
+        if(event->b) {
+            furi_string_cat_str(text, "ERROR: Invalid response timing\n");
+        }
+        break;
+    case DHT11DebugStepResponseHigh:
+        furi_string_cat_printf(text, "9. Response HIGH: %luus\n", (unsigned long)event->a);
+        if(event->b) {
+            furi_string_cat_str(text, "ERROR: Response too long\n");
+        } else {
+            furi_string_cat_str(text, "10. Data transmission started\n");
+        }
+        break;
+    case DHT11DebugStepThreshold:
+        context->threshold_us = event->a & 0xFF;
+        break;
+    case DHT11DebugStepBit: {
+        uint8_t index = event->b & 0x7F;
+        uint8_t value = (event->b >> 7) & 1;
+        if(index < 16) {
+            furi_string_cat_printf(
+                text, "Bit %u: %luus = %u (th:%u)\n", index, (unsigned long)event->a, value, context->threshold_us);
+        } else {
+            furi_string_cat_printf(text, "Bit %u: %luus = %u\n", index, (unsigned long)event->a, value);
+        }
+        break;
+    }
+    case DHT11DebugStepBitTimeout:
+        furi_string_cat_printf(text, "ERROR: Bit %u start timeout\n", event->b);
+        break;
+    case DHT11DebugStepComplete:
+        furi_string_cat_str(
+            text,
+            context->polling ? "11. Critical section: Interrupts enabled\n" :
+                               "11. Edge capture: Transfer complete\n");
+        furi_string_cat_printf(text, "12. Bits read: %lu/40\n", (unsigned long)event->a);
+        furi_string_cat_str(text, "Timing Analysis:\n");
+        furi_string_cat_printf(text, "- Using DWT cycle counter (%uMHz = 1us)\n", event->b);
+        furi_string_cat_printf(text, "- Transfer time: %luus\n", (unsigned long)(event->cycles / MAX(event->b, 1)));
+        furi_string_cat_str(text, "- Expected: 0=26-28us, 1=70us\n");
+        furi_string_cat_str(text, "- High precision cycle counting\n");
+        break;
+    case DHT11DebugStepRawData: {
+        uint8_t data[5] = {event->a >> 24, event->a >> 16, event->a >> 8, event->a, event->b};
+        uint8_t checksum = data[0] + data[1] + data[2] + data[3];
+        furi_string_cat_printf(
+            text, "13. Raw data: %02X %02X %02X %02X %02X\n", data[0], data[1], data[2], data[3], data[4]);
+        furi_string_cat_printf(text, "14. Checksum calc: %02X, received: %02X\n", checksum, data[4]);
+        if(checksum != data[4]) {
+            furi_string_cat_str(text, "ERROR: Checksum mismatch\n");
+        }
+        break;
+    }
+    case DHT11DebugStepValues: {
+        int16_t temperature = (int16_t)event->b;
+        furi_string_cat_printf(
+            text, "15. Humidity: %lu.%lu%%\n", (unsigned long)event->a / 10, (unsigned long)event->a % 10);
+        furi_string_cat_printf(
+            text,
+            "16. Temperature: %s%d.%d°C\n",
+            temperature < 0 ? "-" : "",
+            abs(temperature) / 10,
+            abs(temperature) % 10);
+        break;
+    }
+    case DHT11DebugStepResult:
+        if(event->a == DHT11StatusRange) {
+            furi_string_cat_str(text, "ERROR: Values out of range\n");
+        } else if(event->a == DHT11StatusOk && event->b > 0) {
+            furi_string_cat_printf(
+                text, "17. SUCCESS: Read completed, %lu bit(s) recovered\n", (unsigned long)event->b);
+        } else if(event->a == DHT11StatusOk) {
+            furi_string_cat_str(text, "17. SUCCESS: Read completed\n");
+        }
+        furi_string_cat_str(text, "\n");
+        break;
+    default:
+        break;
+    }
+}
+
+void dht11_debug_log_format(const DHT11DebugLog* log, FuriString* text) {
+    DHT11DebugLogContext context = {0};
+    bool in_transaction = false;
+    uint32_t first = log->head > DHT11_DEBUG_LOG_EVENTS ? log->head - DHT11_DEBUG_LOG_EVENTS : 0;
+    
+    furi_string_reset(text);
+    
+    for(uint32_t i = first; i < log->head; i++) {
+        const DHT11DebugEvent* event = &log->events[i % DHT11_DEBUG_LOG_EVENTS];
+        
+        // The oldest transaction may have lost its first events to newer ones
+        if(event->step == DHT11DebugStepBegin) {
+            in_transaction = true;
+        }
+        if(in_transaction) {
+            dht11_debug_log_format_event(event, &context, text);
+        }
+    }
+    
+    if(furi_string_empty(text)) {
+        furi_string_set_str(text, "No debug reads yet\n");
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file debug_log.h
+ * @brief Structured debug event ring buffer
+ * 
+ * Debug reads record what happened as compact fixed-size events rather
+ * than text. Events are only turned into text while the debug screen is
+ * shown, and the ring keeps the last few transactions instead of only the
+ * most recent one.
+ */
+
+#pragma once
+
+#include <furi.h>
+
+/** @brief Number of events kept, enough for about three transactions */
+#define DHT11_DEBUG_LOG_EVENTS 96
+
+/**
+ * @brief Debug event types
+ * 
+ * The meaning of the two arguments is given per step.
+ */
+typedef enum {
+    DHT11DebugStepBegin,            /**< a: pin name chars, start pulse ms in the top byte; b: number, level in bit 15 */
+    DHT11DebugStepBackend,          /**< a: 1 for the polling backend, 0 for edge capture */
+    DHT11DebugStepWaitResponse,     /**< a: duration in us; b: 1 on timeout */
+    DHT11DebugStepResponseLow,      /**< a: duration in us; b: 1 if invalid */
+    DHT11DebugStepResponseHigh,     /**< a: duration in us; b: 1 if invalid */
+    DHT11DebugStepThreshold,        /**< a: threshold in us, learned in bit 8; b: calibration samples */
+    DHT11DebugStepBit,              /**< a: high phase in us; b: bit index, value in bit 7 */
+    DHT11DebugStepBitTimeout,       /**< b: failed bit */
+    DHT11DebugStepComplete,         /**< a: bits read; b: cycles per us */
+    DHT11DebugStepRawData,          /**< a: data[0..3], first byte highest; b: received checksum */
+    DHT11DebugStepValues,           /**< a: humidity in tenths; b: temperature in tenths, signed */
+    DHT11DebugStepResult,           /**< a: DHT11Status, b: bits recovered */
+} DHT11DebugStep;
+
+/**
+ * @brief One recorded debug event
+ */
+typedef struct {
+    uint32_t cycles;    /**< Cycle offset from the release of the line */
+    uint32_t a;         /**< First argument */
+    uint16_t b;         /**< Second argument */
+    uint8_t step;       /**< DHT11DebugStep */
+} DHT11DebugEvent;
+
+/**
+ * @brief Debug event ring buffer
+ */
+typedef struct {
+    DHT11DebugEvent events[DHT11_DEBUG_LOG_EVENTS];     /**< Event storage */
+    uint32_t head;                                      /**< Number of events ever recorded */
+    uint16_t transactions;                              /**< Number of transactions begun */
+} DHT11DebugLog;
+
+/**
+ * @brief Empty the ring
+ * 
+ * @param log Pointer to the debug log
+ */
+void dht11_debug_log_reset(DHT11DebugLog* log);
+
+/**
+ * @brief Start a new transaction
+ * 
+ * @param log Pointer to the debug log
+ * @param pin_name Data pin name, up to three characters
+ * @param initial_level Line level before the start signal
+ * @param start_ms Length of the start pulse
+ */
+void dht11_debug_log_begin(DHT11DebugLog* log, const char* pin_name, bool initial_level, uint8_t start_ms);
+
+/**
+ * @brief Record an event, overwriting the oldest one when full
+ * 
+ * @param log Pointer to the debug log
+ * @param step Event type
+ * @param cycles Cycle offset from the release of the line
+ * @param a First argument
+ * @param b Second argument
+ */
+void dht11_debug_log_push(DHT11DebugLog* log, DHT11DebugStep step, uint32_t cycles, uint32_t a, uint16_t b);
+
+/**
+ * @brief Render every complete transaction in the ring as text
+ * 
+ * Oldest first; a transaction whose start has been overwritten is skipped.
+ * 
+ * @param log Pointer to the debug log
+ * @param text Output string, replaced
+ */
+void dht11_debug_log_format(const DHT11DebugLog* log, FuriString* text);
@@ -6,15 +6,23 @@
 #include "debug_scene.h"
 #include "sensor.h"
 #include "scenes.h"
+#include "scene_views.h"
 
 void dht11_scene_debug_on_enter(void* context) {
     DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneDebug);
     
-    // Run debug sensor read and show results
-    app->sensor_ok = dht11_sensor_debug_read(app);
+    // Run debug sensor read on the selected sensor and show the recent history
+    if(app->sensor_count > 0) {
+        dht11_sensor_debug_read(app, &app->sensors[app->selected_sensor]);
+        dht11_debug_log_format(app->debug_events, app->debug_text);
+    } else {
+        furi_string_set_str(app->debug_text, "No sensors configured\n");
+    }
     
-    text_box_set_text(app->debug_text_box, app->debug_log);
+    text_box_set_text(app->debug_text_box, furi_string_get_cstr(app->debug_text));
     text_box_set_font(app->debug_text_box, TextBoxFontText);
+    text_box_set_focus(app->debug_text_box, TextBoxFocusEnd);
     view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneDebug);
 }
 
@@ -33,4 +41,7 @@ bool dht11_scene_debug_on_event(void* context, SceneManagerEvent event) {
 void dht11_scene_debug_on_exit(void* context) {
     DHT11App* app = context;
     text_box_reset(app->debug_text_box);
+    
+    // The text box and the text are only kept while the scene is shown
+    dht11_scene_view_release(app, DHT11SceneDebug);
 }
@@ -0,0 +1,173 @@
+/**
+ * @file decoder.c
+ * @brief DHT11 bit decoder implementation
+ */
+
+#include "decoder.h"
+#include <string.h>
+
+static const char* const dht11_decoder_status_names[DHT11StatusCount] = {
+    [DHT11StatusOk] = "OK",
+    [DHT11StatusNoResponse] = "No response",
+    [DHT11StatusResponseLow] = "Response low",
+    [DHT11StatusResponseHigh] = "Response high",
+    [DHT11StatusBitTimeout] = "Bit timeout",
+    [DHT11StatusChecksum] = "Checksum",
+    [DHT11StatusRange] = "Out of range",
+};
+
+const char* dht11_decoder_status_name(DHT11Status status) {
+    return status < DHT11StatusCount ? dht11_decoder_status_names[status] : "Unknown";
+}
+
+void dht11_decoder_reset(DHT11Transfer* transfer) {
+    memset(transfer, 0, sizeof(DHT11Transfer));
+}
+
+void dht11_decoder_finish_trace(DHT11Transfer* transfer, uint32_t response_limit) {
+    uint8_t count = transfer->trace_length;
+    
+    if(count <= DHT11_TRACE_WAIT_RESPONSE) {
+        transfer->status = DHT11StatusNoResponse;
+        return;
+    }
+    
+    // Response: ~80us low followed by ~80us high
+    if(count <= DHT11_TRACE_RESPONSE_LOW || transfer->trace[DHT11_TRACE_RESPONSE_LOW] > response_limit) {
+        transfer->status = DHT11StatusResponseLow;
+        return;
+    }
+    if(count <= DHT11_TRACE_RESPONSE_HIGH || transfer->trace[DHT11_TRACE_RESPONSE_HIGH] > response_limit) {
+        transfer->status = DHT11StatusResponseHigh;
+        return;
+    }
+    
+    // Bit i is complete once the falling edge ending its high phase arrived
+    uint8_t bits = (count - DHT11_TRACE_BIT_LOW(0)) / 2;
+    transfer->bits_read = bits;
+    if(bits < DHT11_BIT_COUNT) {
+        transfer->status = DHT11StatusBitTimeout;
+        transfer->failed_bit = bits;
+    }
+}
+
+void dht11_decoder_decode(DHT11Transfer* transfer, uint32_t threshold_cycles) {
+    if(transfer->status != DHT11StatusOk) {
+        return;
+    }
+    
+    memset(transfer->data, 0, sizeof(transfer->data));
+    for(int i = 0; i < DHT11_BIT_COUNT; i++) {
+        // For DHT11: Logic '1' is ~70us, Logic '0' is ~26-28us
+        if(transfer->trace[DHT11_TRACE_BIT_HIGH(i)] > threshold_cycles) {
+            transfer->data[i / 8] |= (1 << (7 - (i % 8)));
+        }
+    }
+    
+    uint8_t checksum = transfer->data[0] + transfer->data[1] + transfer->data[2] + transfer->data[3];
+    if(checksum != transfer->data[4]) {
+        transfer->status = DHT11StatusChecksum;
+    }
+}
+
+bool dht11_decoder_recover(
+    DHT11Transfer* transfer,
+    uint32_t threshold_cycles,
+    uint32_t margin_cycles,
+    uint8_t max_flips,
+    DHT11DecoderAcceptCallback accept,
+    void* context) {
+    if(transfer->status != DHT11StatusChecksum || max_flips == 0) {
+        return false;
+    }
+    
+    // Insertion sort of the ambiguous bits by distance from the threshold
+    uint8_t candidates[DHT11_RECOVERY_CANDIDATES];
+    uint32_t distances[DHT11_RECOVERY_CANDIDATES];
+    uint8_t count = 0;
+    for(uint8_t i = 0; i < DHT11_BIT_COUNT; i++) {
+        uint32_t high = transfer->trace[DHT11_TRACE_BIT_HIGH(i)];
+        uint32_t distance = high > threshold_cycles ? high - threshold_cycles : threshold_cycles - high;
+        if(distance > margin_cycles) {
+            continue;
+        }
+        
+        uint8_t position = count < DHT11_RECOVERY_CANDIDATES ? count++ : DHT11_RECOVERY_CANDIDATES;
+        while(position > 0 && distances[position - 1] > distance) {
+            if(position < DHT11_RECOVERY_CANDIDATES) {
+                candidates[position] = candidates[position - 1];
+                distances[position] = distances[position - 1];
+            }
+            position--;
+        }
+        if(position < DHT11_RECOVERY_CANDIDATES) {
+            candidates[position] = i;
+            distances[position] = distance;
+        }
+    }
+    
+    // Fewest flips first: one wrong bit is far more likely than two. Only
+    // the least confident bits are flipped, and only when they stand clear
+    // of the next candidate; otherwise a checksum match is as likely to
+    // come from the wrong bits as from the right ones.
+    uint32_t clearance = margin_cycles * DHT11_RECOVERY_CLEARANCE_PERCENT / 100;
+    uint8_t limit = max_flips < DHT11_RECOVERY_CANDIDATES ? max_flips : DHT11_RECOVERY_CANDIDATES - 1;
+    uint8_t data[5];
+    memcpy(data, transfer->data, sizeof(data));
+    for(uint8_t flips = 1; flips <= limit && flips <= count; flips++) {
+        uint8_t bit = candidates[flips - 1];
+        data[bit / 8] ^= 1 << (7 - (bit % 8));
+        if(flips < count && distances[flips] - distances[flips - 1] < clearance) {
+            continue;
+        }
+        
+        uint8_t checksum = data[0] + data[1] + data[2] + data[3];
+        if(checksum == data[4] && accept(context, data)) {
+            memcpy(transfer->data, data, sizeof(data));
+            transfer->status = DHT11StatusOk;
+            transfer->recovered_bits = flips;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void dht11_decoder_result(
+    const DHT11Transfer* transfer,
+    uint32_t cycles_per_us,
+    uint8_t threshold_us,
+    DHT11Result* result) {
+    memset(result, 0, sizeof(DHT11Result));
+    result->status = transfer->status;
+    result->failed_bit = transfer->failed_bit;
+    result->bits_read = transfer->bits_read;
+    result->threshold_us = threshold_us;
+    result->recovered_bits = transfer->recovered_bits;
+    
+    const uint16_t* trace = transfer->trace;
+    uint8_t count = transfer->trace_length;
+    if(count > DHT11_TRACE_WAIT_RESPONSE) {
+        result->wait_us = trace[DHT11_TRACE_WAIT_RESPONSE] / cycles_per_us;
+    }
+    if(count > DHT11_TRACE_RESPONSE_LOW) {
+        result->response_low_us = trace[DHT11_TRACE_RESPONSE_LOW] / cycles_per_us;
+    }
+    if(count > DHT11_TRACE_RESPONSE_HIGH) {
+        result->response_high_us = trace[DHT11_TRACE_RESPONSE_HIGH] / cycles_per_us;
+    }
+    
+    // The margins on either side of the threshold
+    uint32_t threshold_cycles = threshold_us * cycles_per_us;
+    for(uint8_t i = 0; i < transfer->bits_read; i++) {
+        uint16_t high = trace[DHT11_TRACE_BIT_HIGH(i)];
+        uint16_t high_us = high / cycles_per_us;
+        if(high > threshold_cycles) {
+            if(result->one_min_us == 0 || high_us < result->one_min_us) {
+                result->one_min_us = high_us;
+            }
+        } else if(high_us > result->zero_max_us) {
+            result->zero_max_us = high_us;
+        }
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ * @file decoder.h
+ * @brief DHT11 transfer record and bit decoder
+ * 
+ * Every read backend fills the same transfer record with raw timings
+ * while the transfer is in flight. Decoding and all formatting happen
+ * afterwards, outside any timing-critical section.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Number of data bits in a transfer */
+#define DHT11_BIT_COUNT 40
+
+/** @brief Default for the most bits flipped when recovering from a checksum failure, 0 to disable */
+#define DHT11_RECOVERY_MAX_FLIPS 1
+
+/** @brief Least-confident bits ranked for flipping; one fewer can be flipped at most */
+#define DHT11_RECOVERY_CANDIDATES 5
+
+/** @brief Only bits this close to the threshold are considered ambiguous, until the gap is learned */
+#define DHT11_RECOVERY_MARGIN_US 8
+
+/** @brief How much closer than the next candidate flipped bits must be, percent of the margin */
+#define DHT11_RECOVERY_CLEARANCE_PERCENT 5
+
+/**
+ * @brief Number of phases recorded per transfer
+ * 
+ * Wait for response, response low, response high, then a low and a
+ * high phase for every data bit.
+ */
+#define DHT11_TRACE_LENGTH (3 + 2 * DHT11_BIT_COUNT)
+
+/** @brief Trace index of the time until the sensor answered */
+#define DHT11_TRACE_WAIT_RESPONSE 0
+/** @brief Trace index of the response low phase */
+#define DHT11_TRACE_RESPONSE_LOW 1
+/** @brief Trace index of the response high phase */
+#define DHT11_TRACE_RESPONSE_HIGH 2
+/** @brief Trace index of the low phase preceding bit i */
+#define DHT11_TRACE_BIT_LOW(i) (3 + 2 * (i))
+/** @brief Trace index of the high phase of bit i */
+#define DHT11_TRACE_BIT_HIGH(i) (4 + 2 * (i))
+
+/**
+ * @brief Outcome of a transfer
+ */
+typedef enum {
+    DHT11StatusOk,              /**< Valid reading */
+    DHT11StatusNoResponse,      /**< Sensor never pulled the line low */
+    DHT11StatusResponseLow,     /**< Response low phase did not end */
+    DHT11StatusResponseHigh,    /**< Response high phase did not end */
+    DHT11StatusBitTimeout,      /**< A data bit did not start in time */
+    DHT11StatusChecksum,        /**< Checksum mismatch */
+    DHT11StatusRange,           /**< Values out of reasonable range */
+    DHT11StatusCount,           /**< Number of status values */
+} DHT11Status;
+
+/**
+ * @brief Raw record of one transfer
+ * 
+ * Every phase of the waveform is stored as a CPU cycle delta between two
+ * edges, saturated to 16 bits (about 1ms at 64MHz).
+ */
+typedef struct {
+    DHT11Status status;                     /**< Outcome of the transfer */
+    uint8_t failed_bit;                     /**< Bit index for DHT11StatusBitTimeout */
+    uint8_t bits_read;                      /**< Number of bits whose high phase was measured */
+    uint8_t trace_length;                   /**< Number of valid entries in trace */
+    uint16_t trace[DHT11_TRACE_LENGTH];     /**< Cycle delta of each phase */
+    uint8_t data[5];                        /**< Decoded bytes, last one is the checksum */
+    uint8_t recovered_bits;                 /**< Bits flipped to pass the checksum, 0 if none */
+} DHT11Transfer;
+
+/**
+ * @brief Outcome of a transaction as reported to callers
+ * 
+ * The error class together with where the transfer stopped and the
+ * timings measured up to that point, in microseconds. Phases that were
+ * not reached are 0.
+ */
+typedef struct {
+    DHT11Status status;             /**< Error class, DHT11StatusOk on success */
+    uint8_t failed_bit;             /**< Bit that did not start, valid for DHT11StatusBitTimeout */
+    uint8_t bits_read;              /**< Number of bits received */
+    uint8_t threshold_us;           /**< Bit threshold the transfer was decoded with */
+    uint8_t recovered_bits;         /**< Bits flipped to pass the checksum, 0 if none */
+    uint16_t wait_us;               /**< Time until the sensor answered */
+    uint16_t response_low_us;       /**< Response low phase */
+    uint16_t response_high_us;      /**< Response high phase */
+    uint16_t zero_max_us;           /**< Longest high phase decoded as '0' */
+    uint16_t one_min_us;            /**< Shortest high phase decoded as '1' */
+} DHT11Result;
+
+/**
+ * @brief Cycle delta between two timestamps, saturated to the trace width
+ * 
+ * @param from Timestamp of the earlier edge
+ * @param to Timestamp of the later edge
+ * @return Elapsed cycles, at most UINT16_MAX
+ */
+static inline uint16_t dht11_trace_delta(uint32_t from, uint32_t to) {
+    uint32_t delta = to - from;
+    return delta > UINT16_MAX ? UINT16_MAX : (uint16_t)delta;
+}
+
+/**
+ * @brief Short human-readable name of a transfer status
+ * 
+ * @param status Transfer status
+ * @return Static string
+ */
+const char* dht11_decoder_status_name(DHT11Status status);
+
+/**
+ * @brief Clear a transfer record before a new transaction
+ * 
+ * @param transfer Pointer to the transfer record
+ */
+void dht11_decoder_reset(DHT11Transfer* transfer);
+
+/**
+ * @brief Derive the transfer status from a trace of recorded edges
+ * 
+ * For backends that timestamp edges rather than waiting for each phase:
+ * sets status, bits_read and failed_bit from the number of recorded
+ * phases and rejects response phases longer than response_limit.
+ * 
+ * @param transfer Transfer record with trace and trace_length filled in
+ * @param response_limit Maximum response phase length in cycles
+ */
+void dht11_decoder_finish_trace(DHT11Transfer* transfer, uint32_t response_limit);
+
+/**
+ * @brief Decode the data bits and verify the checksum
+ * 
+ * Does nothing if the transfer already failed. Otherwise fills data and
+ * sets status to DHT11StatusOk or DHT11StatusChecksum.
+ * 
+ * @param transfer Pointer to a received transfer record
+ * @param threshold_cycles High phase length above which a bit is a '1'
+ */
+void dht11_decoder_decode(DHT11Transfer* transfer, uint32_t threshold_cycles);
+
+/**
+ * @brief Check whether candidate data bytes are plausible
+ * 
+ * @param context User context
+ * @param data Five data bytes with a matching checksum
+ * @return true if the values pass the caller's range checks
+ */
+typedef bool (*DHT11DecoderAcceptCallback)(void* context, const uint8_t* data);
+
+/**
+ * @brief Try to repair a transfer that failed the checksum
+ * 
+ * Ranks the bits by how close their high phase came to the threshold and
+ * flips the least confident one, then the two least confident, and so on
+ * up to max_flips. Bits further than the margin from the threshold are
+ * never flipped. A set of bits is only tried when every bit left
+ * unflipped is further from the threshold by at least
+ * DHT11_RECOVERY_CLEARANCE_PERCENT of the margin: when several bits are
+ * about as doubtful, a checksum match says little about which of them
+ * was wrong, and guessing lets wrong readings through. The first set
+ * tried that matches the checksum and that the callback accepts replaces
+ * the data; the status becomes DHT11StatusOk and recovered_bits is set.
+ * 
+ * @param transfer Transfer record with status DHT11StatusChecksum
+ * @param threshold_cycles Threshold the transfer was decoded with
+ * @param margin_cycles Largest distance from the threshold of a flipped bit
+ * @param max_flips Most bits flipped at once, 0 to disable recovery
+ * @param accept Range check for candidates
+ * @param context Context passed to accept
+ * @return true if the transfer was recovered
+ */
+bool dht11_decoder_recover(
+    DHT11Transfer* transfer,
+    uint32_t threshold_cycles,
+    uint32_t margin_cycles,
+    uint8_t max_flips,
+    DHT11DecoderAcceptCallback accept,
+    void* context);
+
+/**
+ * @brief Summarize a decoded transfer for callers
+ * 
+ * @param transfer Decoded transfer record
+ * @param cycles_per_us Cycle counter ticks per microsecond
+ * @param threshold_us Bit threshold the transfer was decoded with
+ * @param result Output for the summary
+ */
+void dht11_decoder_result(
+    const DHT11Transfer* transfer,
+    uint32_t cycles_per_us,
+    uint8_t threshold_us,
+    DHT11Result* result);
@@ -22,6 +22,7 @@
 #include "app.h"
 #include "sensor.h"
 #include "scenes.h"
+#include "scene_views.h"
 
 // Include the compiled app icons
 #include "dht11_icons.h"
@@ -53,6 +54,19 @@ static bool dht11_custom_event_callback(void* context, uint32_t custom_event) {
     return scene_manager_handle_custom_event(app->scene_manager, custom_event);
 }
 
+/**
+ * @brief New sample callback
+ * 
+ * Called from the acquisition thread; forwards the notification to the
+ * GUI thread as a custom event.
+ * 
+ * @param context Application context
+ */
+static void dht11_sample_ready_callback(void* context) {
+    DHT11App* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, DHT11CustomEventSampleReady);
+}
+
 /**
  * @brief Main application entry point
  * 
@@ -65,13 +79,19 @@ static bool dht11_custom_event_callback(void* context, uint32_t custom_event) {
 int32_t dht11_app(void* p) {
     UNUSED(p);
     
-    // Allocate application structure
+    // Allocate application structure; views are allocated by their scenes
     DHT11App* app = malloc(sizeof(DHT11App));
+    memset(app, 0, sizeof(DHT11App));
     
     // Initialize records
     app->gui = furi_record_open(RECORD_GUI);
     app->notifications = furi_record_open(RECORD_NOTIFICATION);
     
+    // Settings are read once here; everything else uses the cached copy
+    dht11_settings_default(&app->settings);
+    dht11_settings_load(&app->settings, DHT11_SETTINGS_PATH);
+    dht11_settings_refresh_units(&app->settings);
+    
     // Initialize view dispatcher
     app->view_dispatcher = view_dispatcher_alloc();
     view_dispatcher_set_event_callback_context(app->view_dispatcher, app);
@@ -82,27 +102,41 @@ int32_t dht11_app(void* p) {
     // Initialize scene manager
     app->scene_manager = scene_manager_alloc(&dht11_scene_handlers, app);
     
-    // Initialize GUI components
-    app->submenu = submenu_alloc();
-    view_dispatcher_add_view(app->view_dispatcher, DHT11SceneMainMenu, submenu_get_view(app->submenu));
-    
-    app->sensor_widget = widget_alloc();
-    view_dispatcher_add_view(app->view_dispatcher, DHT11SceneReadSensor, widget_get_view(app->sensor_widget));
+    // Initialize the sensor driver; leaves every data pin as input with pull-up
+    dht11_sensor_init(app, DHT11_DEFAULT_BACKEND);
     
-    app->about_text_box = text_box_alloc();
-    view_dispatcher_add_view(app->view_dispatcher, DHT11SceneAbout, text_box_get_view(app->about_text_box));
+    // Trend history of every sensor, filled by the acquisition thread
+    app->history = dht11_history_alloc(app->sensor_count);
     
-    app->debug_text_box = text_box_alloc();
-    view_dispatcher_add_view(app->view_dispatcher, DHT11SceneDebug, text_box_get_view(app->debug_text_box));
-    
-    // Initialize sensor data
-    app->temperature = 0.0f;
-    app->humidity = 0.0f;
-    app->sensor_ok = false;
-    app->about_text = NULL;
+    // Alerts are evaluated by the acquisition thread, so they exist before it starts
+    app->alerts = dht11_alert_alloc();
+    app->alerts->actions = app->settings.alert_actions;
+    for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+        DHT11AlertRule rule = app->alerts->rules[i];
+        rule.threshold = app->settings.alert_thresholds[i];
+        dht11_alert_set_rule(app->alerts, i, &rule);
+    }
+    dht11_alert_set_enabled(app->alerts, app->settings.alerts);
+    
+    // Sample continuously in the background, independent of the GUI
+    app->acquisition = dht11_acquisition_alloc(app);
+    dht11_acquisition_set_callback(app->acquisition, dht11_sample_ready_callback, app);
+    dht11_acquisition_set_period(app->acquisition, app->settings.period_ms);
+    dht11_acquisition_set_filter(app->acquisition, &app->settings.filter);
+    dht11_acquisition_start(app->acquisition);
+    
+    // Logging to SD is switched on from the main menu, or with the app
+    app->logger = dht11_logger_alloc(&app->acquisition->samples);
+    if(app->settings.log == DHT11SettingsLogCsv) {
+        dht11_logger_start(app->logger, DHT11_LOGGER_CSV_PATH, DHT11LoggerFormatCsv);
+    } else if(app->settings.log == DHT11SettingsLogBinary) {
+        dht11_logger_start(app->logger, DHT11_LOGGER_BINARY_PATH, DHT11LoggerFormatBinary);
+    } else if(app->settings.log == DHT11SettingsLogArchive) {
+        dht11_logger_start(app->logger, DHT11_LOGGER_ARCHIVE_PATH, DHT11LoggerFormatArchive);
+    }
     
-    // Initialize and enable GPIO pin C0 for DHT11 with pull-up resistor
-    furi_hal_gpio_init(DHT11_PIN, GpioModeInput, GpioPullUp, GpioSpeedLow);
+    // So is the BLE beacon
+    app->beacon = dht11_beacon_alloc(&app->acquisition->samples);
     
     // Start with main menu scene
     scene_manager_next_scene(app->scene_manager, DHT11SceneMainMenu);
@@ -113,17 +147,20 @@ int32_t dht11_app(void* p) {
     // Cleanup
     furi_assert(app);
     
-    // Remove views from dispatcher
-    view_dispatcher_remove_view(app->view_dispatcher, DHT11SceneMainMenu);
-    view_dispatcher_remove_view(app->view_dispatcher, DHT11SceneReadSensor);
-    view_dispatcher_remove_view(app->view_dispatcher, DHT11SceneAbout);
-    view_dispatcher_remove_view(app->view_dispatcher, DHT11SceneDebug);
+    // Stop sampling before tearing down the views it notifies; the logger
+    // drains the remaining samples before the buffer goes away
+    dht11_acquisition_stop(app->acquisition);
+    dht11_logger_free(app->logger);
+    dht11_beacon_free(app->beacon);
+    dht11_acquisition_free(app->acquisition);
+    dht11_alert_free(app->alerts);
+    
+    // Remove and free the views the scenes left allocated
+    dht11_scene_views_free(app);
+    dht11_history_free(app->history);
     
-    // Free GUI components
-    submenu_free(app->submenu);
-    widget_free(app->sensor_widget);
-    text_box_free(app->about_text_box);
-    text_box_free(app->debug_text_box);
+    // Release sensor driver
+    dht11_sensor_deinit(app);
     
     // Free scene manager
     scene_manager_free(app->scene_manager);
@@ -131,11 +168,6 @@ int32_t dht11_app(void* p) {
     // Free view dispatcher
     view_dispatcher_free(app->view_dispatcher);
     
-    // Free about text if allocated
-    if(app->about_text) {
-        free(app->about_text);
-    }
-    
     // Close records
     furi_record_close(RECORD_GUI);
     furi_record_close(RECORD_NOTIFICATION);
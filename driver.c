@@ -0,0 +1,510 @@
+/**
+ * @file driver.c
+ * @brief Handle-based DHT driver implementation
+ * 
+ * One read engine for every family and backend: start pulse, reception by
+ * busy-waiting or edge capture, then decoding, threshold calibration,
+ * checksum recovery and range validation. All state a transaction touches
+ * belongs to the handle, so only the interrupts-off window of the polling
+ * backend is shared between handles.
+ */
+
+#include "driver.h"
+#include "sensor_port.h"
+#include "timing.h"
+#include "polling.h"
+#include <furi_hal.h>
+
+/** @brief Worker thread flags */
+typedef enum {
+    DHT11DriverFlagStop = (1 << 0),     /**< Exit the worker loop */
+    DHT11DriverFlagRead = (1 << 1),     /**< Run the pending read */
+} DHT11DriverFlag;
+
+#define DHT11_DRIVER_FLAGS_ALL (DHT11DriverFlagStop | DHT11DriverFlagRead)
+
+DHT11Driver* dht11_driver_alloc(const GpioPin* pin, DHT11ProtocolType family) {
+    furi_check(pin && family < DHT11ProtocolCount);
+    
+    // Enable the cycle counter and precompute every protocol timing
+    dht11_timing_init();
+    
+    DHT11Driver* driver = malloc(sizeof(DHT11Driver));
+    memset(driver, 0, sizeof(DHT11Driver));
+    driver->pin = pin;
+    driver->protocol = &dht11_protocols[family];
+    driver->start_ms = driver->protocol->start_ms;
+    driver->pull_up = true;
+    driver->adaptive = true;
+    driver->recovery_flips = DHT11_RECOVERY_MAX_FLIPS;
+    driver->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    dht11_calibration_reset(&driver->calibration, driver->protocol->threshold_us);
+    dht11_sensor_cache_reset(&driver->cache, driver->protocol->min_interval_ms);
+    dht11_decoder_reset(&driver->transfer);
+    
+    driver->backend = DHT11_DRIVER_DEFAULT_BACKEND;
+    if(driver->backend == DHT11ReadBackendCapture) {
+        driver->capture = dht11_capture_alloc(pin);
+    }
+    
+    // Idle state: input with pull-up resistor
+    furi_hal_gpio_init(pin, GpioModeInput, GpioPullUp, GpioSpeedLow);
+    
+    return driver;
+}
+
+void dht11_driver_free(DHT11Driver* driver) {
+    furi_assert(driver);
+    
+    if(driver->worker) {
+        furi_thread_flags_set(furi_thread_get_id(driver->worker), DHT11DriverFlagStop);
+        furi_thread_join(driver->worker);
+        furi_thread_free(driver->worker);
+    }
+    if(driver->capture) {
+        dht11_capture_free(driver->capture);
+    }
+    furi_mutex_free(driver->mutex);
+    free(driver);
+}
+
+void dht11_driver_set_backend(DHT11Driver* driver, DHT11ReadBackend backend) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    driver->backend = backend;
+    if(backend == DHT11ReadBackendCapture && !driver->capture) {
+        driver->capture = dht11_capture_alloc(driver->pin);
+        driver->capture->pull_up = driver->pull_up;
+    } else if(backend != DHT11ReadBackendCapture && driver->capture) {
+        dht11_capture_free(driver->capture);
+        driver->capture = NULL;
+    }
+    
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_start_ms(DHT11Driver* driver, uint8_t start_ms) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    driver->start_ms = start_ms ? start_ms : driver->protocol->start_ms;
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_threshold(DHT11Driver* driver, uint8_t threshold_us) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    dht11_calibration_reset(&driver->calibration, threshold_us ? threshold_us : driver->protocol->threshold_us);
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_adaptive(DHT11Driver* driver, bool adaptive) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    driver->adaptive = adaptive;
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_recovery(DHT11Driver* driver, uint8_t max_flips) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    driver->recovery_flips = max_flips;
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_pull_up(DHT11Driver* driver, bool pull_up) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    driver->pull_up = pull_up;
+    if(driver->capture) {
+        driver->capture->pull_up = pull_up;
+    }
+    furi_hal_gpio_init(driver->pin, GpioModeInput, pull_up ? GpioPullUp : GpioPullNo, GpioSpeedLow);
+    
+    furi_mutex_release(driver->mutex);
+}
+
+void dht11_driver_set_hooks(DHT11Driver* driver, const DHT11DriverHooks* hooks) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    if(hooks) {
+        driver->hooks = *hooks;
+    } else {
+        memset(&driver->hooks, 0, sizeof(DHT11DriverHooks));
+    }
+    
+    furi_mutex_release(driver->mutex);
+}
+
+/**
+ * @brief Call the indicator hook, if any
+ * 
+ * @param driver Pointer to the handle
+ * @param active true when the bus is about to be used
+ */
+static void dht11_driver_indicate(DHT11Driver* driver, bool active) {
+    if(driver->hooks.indicate) {
+        driver->hooks.indicate(driver->hooks.context, active);
+    }
+}
+
+/**
+ * @brief Receive a transfer by busy-waiting on the data line
+ * 
+ * @param pin GPIO pin connected to the data line
+ * @param pull_up Release the line with the internal pull-up enabled
+ * @param transfer Transfer record to fill
+ * @return Cycles spent with interrupts disabled
+ */
+static uint32_t dht11_driver_receive_polling(const GpioPin* pin, bool pull_up, DHT11Transfer* transfer) {
+    // Critical: Disable interrupts during timing-sensitive communication
+    FURI_CRITICAL_ENTER();
+    uint32_t start = dht11_timing_now();
+    
+    dht11_polling_receive(pin, pull_up, transfer);
+    
+    uint32_t irq_off = dht11_timing_now() - start;
+    FURI_CRITICAL_EXIT();
+    return irq_off;
+}
+
+/**
+ * @brief Receive a transfer through the edge capture backend
+ * 
+ * Interrupts stay enabled; edges are timestamped from the pin's EXTI
+ * interrupt and converted to bit timings once the transfer is complete.
+ * 
+ * @param capture Capture state for the data pin
+ * @param transfer Transfer record to fill
+ */
+static void dht11_driver_receive_capture(DHT11Capture* capture, DHT11Transfer* transfer) {
+    // A full transfer takes about 5ms; allow for scheduling latency
+    dht11_capture_run(capture, 10);
+    dht11_capture_fill_transfer(capture, transfer);
+}
+
+/**
+ * @brief Range check for checksum recovery candidates
+ * 
+ * @param context Handle whose family the candidate is checked against
+ * @param data Candidate data bytes
+ * @return true if the candidate converts to plausible values
+ */
+static bool dht11_driver_accept(void* context, const uint8_t* data) {
+    const DHT11Driver* driver = context;
+    int16_t temperature;
+    uint16_t humidity;
+    return dht11_protocol_convert(driver->protocol, data, &temperature, &humidity);
+}
+
+/**
+ * @brief Decode, validate and store a received transfer
+ * 
+ * Shared tail of every transaction, whichever backend received it:
+ * decoding, threshold calibration, checksum recovery, range validation,
+ * the cache update and the observer hook.
+ * 
+ * @param driver Pointer to the handle, locked
+ * @param tick Tick at which the transaction started
+ * @param start Cycle counter at the start pulse
+ * @param start_ms Length of the start pulse sent
+ * @param irq_off Cycles spent with interrupts disabled
+ * @return Outcome of the transaction
+ */
+static DHT11Status dht11_driver_finish(
+    DHT11Driver* driver,
+    uint32_t tick,
+    uint32_t start,
+    uint8_t start_ms,
+    uint32_t irq_off) {
+    DHT11Transfer* transfer = &driver->transfer;
+    uint32_t cycles_per_us = dht11_timing.cycles_per_us;
+    DHT11DriverTransaction transaction = {.tick = tick, .transfer = transfer, .start_ms = start_ms};
+    DHT11Result result;
+    
+    dht11_decoder_decode(transfer, driver->calibration.threshold_us * cycles_per_us);
+    
+    // A checksum failure may have been a misplaced threshold: retry with the new one
+    if(driver->adaptive && dht11_calibration_update(&driver->calibration, transfer, cycles_per_us) &&
+       transfer->status == DHT11StatusChecksum) {
+        transfer->status = DHT11StatusOk;
+        dht11_decoder_decode(transfer, driver->calibration.threshold_us * cycles_per_us);
+    }
+    
+    // Still wrong: one of the bits nearest the threshold was probably misread
+    dht11_decoder_recover(
+        transfer,
+        driver->calibration.threshold_us * cycles_per_us,
+        dht11_calibration_margin_us(&driver->calibration) * cycles_per_us,
+        driver->recovery_flips,
+        dht11_driver_accept,
+        driver);
+    
+    // Convert and validate according to the sensor's family
+    if(transfer->status == DHT11StatusOk &&
+       !dht11_protocol_convert(
+           driver->protocol, transfer->data, &transaction.temperature, &transaction.humidity)) {
+        transfer->status = DHT11StatusRange;
+    }
+    
+    dht11_decoder_result(transfer, cycles_per_us, driver->calibration.threshold_us, &result);
+    dht11_sensor_cache_store(&driver->cache, tick, &result, transaction.temperature, transaction.humidity);
+    
+    transaction.latency_us = (dht11_timing_now() - start) / cycles_per_us;
+    transaction.irq_off_us = irq_off / cycles_per_us;
+    if(driver->hooks.observe) {
+        driver->hooks.observe(driver->hooks.context, driver, &transaction);
+    }
+    
+    return transfer->status;
+}
+
+/**
+ * @brief Run one complete transaction on the bus
+ * 
+ * Start pulse, reception through the selected backend, then
+ * dht11_driver_finish(). The indicator brackets the transaction from the
+ * outside, so whatever it does is never timed.
+ * 
+ * @param driver Pointer to the handle, locked
+ * @return Outcome of the transaction
+ */
+static DHT11Status dht11_driver_transact(DHT11Driver* driver) {
+    dht11_driver_indicate(driver, true);
+    
+    uint32_t tick = furi_get_tick();
+    uint32_t start = dht11_timing_now();
+    uint32_t irq_off = 0;
+    dht11_decoder_reset(&driver->transfer);
+    
+    // Send start signal: pull low for as long as the family needs
+    furi_hal_gpio_init(driver->pin, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
+    furi_hal_gpio_write(driver->pin, false);
+    furi_delay_ms(driver->start_ms);
+    
+    if(driver->backend == DHT11ReadBackendCapture) {
+        dht11_driver_receive_capture(driver->capture, &driver->transfer);
+    } else {
+        irq_off = dht11_driver_receive_polling(driver->pin, driver->pull_up, &driver->transfer);
+    }
+    
+    DHT11Status status = dht11_driver_finish(driver, tick, start, driver->start_ms, irq_off);
+    
+    dht11_driver_indicate(driver, false);
+    return status;
+}
+
+bool dht11_driver_read(DHT11Driver* driver, DHT11Reading* reading) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    // Too soon after the last transaction: answer from the cache
+    uint32_t tick = furi_get_tick();
+    if(dht11_sensor_cache_wait_ticks(&driver->cache, tick) > 0) {
+        dht11_sensor_cache_get(&driver->cache, tick, reading);
+    } else {
+        dht11_driver_transact(driver);
+        dht11_sensor_cache_get(&driver->cache, furi_get_tick(), reading);
+        reading->fresh = true;
+    }
+    
+    furi_mutex_release(driver->mutex);
+    return reading->valid;
+}
+
+uint32_t dht11_driver_wait_ticks(DHT11Driver* driver) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    uint32_t wait = dht11_sensor_cache_wait_ticks(&driver->cache, furi_get_tick());
+    furi_mutex_release(driver->mutex);
+    return wait;
+}
+
+bool dht11_driver_read_fresh(DHT11Driver* driver, DHT11Reading* reading) {
+    furi_assert(driver);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    // Sit out the rest of the interval rather than disturb the sensor
+    uint32_t wait = dht11_sensor_cache_wait_ticks(&driver->cache, furi_get_tick());
+    if(wait > 0) {
+        furi_delay_tick(wait);
+    }
+    
+    bool ok = dht11_driver_transact(driver) == DHT11StatusOk;
+    dht11_sensor_cache_get(&driver->cache, furi_get_tick(), reading);
+    reading->fresh = true;
+    
+    furi_mutex_release(driver->mutex);
+    return ok;
+}
+
+/**
+ * @brief Asynchronous read worker
+ * 
+ * @return Always returns 0
+ */
+static int32_t dht11_driver_worker(void* context) {
+    DHT11Driver* driver = context;
+    
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(DHT11_DRIVER_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
+        if(flags & FuriFlagError) {
+            continue;
+        }
+        
+        // A queued read completes before the worker exits
+        if(flags & DHT11DriverFlagRead) {
+            DHT11Reading reading;
+            dht11_driver_read(driver, &reading);
+            
+            // Cleared before the callback, which may queue the next read
+            furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+            DHT11DriverCallback callback = driver->callback;
+            void* callback_context = driver->callback_context;
+            driver->pending = false;
+            furi_mutex_release(driver->mutex);
+            
+            callback(driver, &reading, callback_context);
+        }
+        if(flags & DHT11DriverFlagStop) {
+            break;
+        }
+    }
+    
+    return 0;
+}
+
+bool dht11_driver_read_async(DHT11Driver* driver, DHT11DriverCallback callback, void* context) {
+    furi_assert(driver);
+    furi_assert(callback);
+    furi_check(furi_mutex_acquire(driver->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    bool queued = !driver->pending;
+    if(queued) {
+        // Most handles are only ever read synchronously: no thread until asked
+        if(!driver->worker) {
+            driver->worker = furi_thread_alloc_ex(
+                "Dht11Driver", DHT11_DRIVER_WORKER_STACK_SIZE, dht11_driver_worker, driver);
+            furi_thread_start(driver->worker);
+        }
+        
+        driver->callback = callback;
+        driver->callback_context = context;
+        driver->pending = true;
+        furi_thread_flags_set(furi_thread_get_id(driver->worker), DHT11DriverFlagRead);
+    }
+    
+    furi_mutex_release(driver->mutex);
+    return queued;
+}
+
+uint8_t dht11_driver_read_batch(
+    DHT11Driver* const* drivers,
+    uint8_t count,
+    uint8_t mask,
+    uint8_t* read_mask,
+    DHT11Reading* readings) {
+    furi_check(count <= DHT11_DRIVER_BATCH_MAX);
+    uint8_t ok_mask = 0;
+    mask &= (uint8_t)((1 << count) - 1);
+    
+    // Locked in index order, so overlapping batches cannot deadlock
+    for(uint8_t i = 0; i < count; i++) {
+        if(mask & (1 << i)) {
+            furi_check(furi_mutex_acquire(drivers[i]->mutex, FuriWaitForever) == FuriStatusOk);
+        }
+    }
+    
+    // Handles read too recently keep their cached status and stay off the bus
+    uint8_t pending = mask;
+    uint32_t tick = furi_get_tick();
+    for(uint8_t i = 0; i < count; i++) {
+        if((pending & (1 << i)) && dht11_sensor_cache_wait_ticks(&drivers[i]->cache, tick) > 0) {
+            pending &= ~(1 << i);
+            if(drivers[i]->cache.last.status == DHT11StatusOk) {
+                ok_mask |= (1 << i);
+            }
+        }
+    }
+    uint8_t selected = pending;
+    if(read_mask) {
+        *read_mask = selected;
+    }
+    
+    if(selected) {
+        // Heap scratch: one window of port words
+        uint16_t* words = malloc(DHT11_PORT_SAMPLES * sizeof(uint16_t));
+        
+        for(uint8_t i = 0; i < count; i++) {
+            if(selected & (1 << i)) {
+                dht11_driver_indicate(drivers[i], true);
+            }
+        }
+        
+        // One shared start pulse for every handle in the batch, long enough for all of them
+        tick = furi_get_tick();
+        uint32_t start = dht11_timing_now();
+        uint32_t irq_off = 0;
+        uint8_t start_ms = 0;
+        for(uint8_t i = 0; i < count; i++) {
+            if(selected & (1 << i)) {
+                dht11_decoder_reset(&drivers[i]->transfer);
+                furi_hal_gpio_init(drivers[i]->pin, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
+                furi_hal_gpio_write(drivers[i]->pin, false);
+                start_ms = MAX(start_ms, drivers[i]->start_ms);
+            }
+        }
+        furi_delay_ms(start_ms);
+        
+        // One sampling window per GPIO port; later groups just see a longer start pulse
+        while(pending) {
+            const GpioPin* pins[DHT11_DRIVER_BATCH_MAX];
+            DHT11Transfer* group[DHT11_DRIVER_BATCH_MAX];
+            uint8_t group_count = 0;
+            GPIO_TypeDef* port = drivers[__builtin_ctz(pending)]->pin->port;
+            
+            for(uint8_t i = 0; i < count; i++) {
+                if((pending & (1 << i)) && drivers[i]->pin->port == port) {
+                    pins[group_count] = drivers[i]->pin;
+                    group[group_count] = &drivers[i]->transfer;
+                    group_count++;
+                    pending &= ~(1 << i);
+                }
+            }
+            
+            irq_off = MAX(irq_off, dht11_port_receive(pins, group, group_count, words));
+        }
+        
+        // Every handle in the batch shares the batch's latency and window
+        for(uint8_t i = 0; i < count; i++) {
+            if((selected & (1 << i)) &&
+               dht11_driver_finish(drivers[i], tick, start, start_ms, irq_off) == DHT11StatusOk) {
+                ok_mask |= (1 << i);
+            }
+        }
+        
+        for(uint8_t i = 0; i < count; i++) {
+            if(selected & (1 << i)) {
+                dht11_driver_indicate(drivers[i], false);
+            }
+        }
+        
+        free(words);
+    }
+    
+    // Copied out while still locked, so no other reader can change them first
+    tick = furi_get_tick();
+    for(uint8_t i = 0; i < count; i++) {
+        if(mask & (1 << i)) {
+            if(readings) {
+                dht11_sensor_cache_get(&drivers[i]->cache, tick, &readings[i]);
+                readings[i].fresh = (selected & (1 << i)) != 0;
+            }
+            furi_mutex_release(drivers[i]->mutex);
+        }
+    }
+    
+    return ok_mask;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file driver.h
+ * @brief Handle-based DHT driver
+ * 
+ * Everything needed to read one sensor lives in its handle: the data pin,
+ * the family descriptor, the learned bit threshold, the read-through cache
+ * and a transfer record of its own. Nothing here knows about the app, the
+ * GUI or notifications, so several handles can be read from different
+ * threads at once and the driver can be dropped into another FAP as is.
+ * 
+ * What the caller wants around a transaction is attached through hooks:
+ * an indicator called before and after the bus is used, never inside the
+ * timed section, and an observer that sees every finished transaction.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_gpio.h>
+#include "decoder.h"
+#include "protocol.h"
+#include "calibration.h"
+#include "sensor_capture.h"
+#include "sensor_cache.h"
+
+/** @brief Read backend of a newly allocated handle */
+#define DHT11_DRIVER_DEFAULT_BACKEND DHT11ReadBackendCapture
+
+/** @brief Most handles in one batch read */
+#define DHT11_DRIVER_BATCH_MAX 8
+
+/** @brief Stack of the worker thread behind asynchronous reads */
+#define DHT11_DRIVER_WORKER_STACK_SIZE 1024
+
+typedef struct DHT11Driver DHT11Driver;
+
+/**
+ * @brief A finished transaction, as passed to the observer hook
+ */
+typedef struct {
+    uint32_t tick;                  /**< Tick at which the transaction started */
+    const DHT11Transfer* transfer;  /**< Raw timings and data, with the final status */
+    int16_t temperature;            /**< Temperature in tenths of a degree Celsius, once the checksum matched */
+    uint16_t humidity;              /**< Relative humidity in tenths of a percent, once the checksum matched */
+    uint32_t latency_us;            /**< Time from the start pulse to the decoded result */
+    uint32_t irq_off_us;            /**< Time spent with interrupts disabled */
+    uint8_t start_ms;               /**< Length of the start pulse sent, shared by a batch */
+} DHT11DriverTransaction;
+
+/**
+ * @brief Optional caller hooks, each may be NULL
+ * 
+ * Hooks run on the reading thread with the handle locked.
+ */
+typedef struct {
+    /** Called with true just before the start pulse and false once the line is released */
+    void (*indicate)(void* context, bool active);
+    /** Called after every transaction with interrupts enabled */
+    void (*observe)(void* context, DHT11Driver* driver, const DHT11DriverTransaction* transaction);
+    void* context;                  /**< Passed to both hooks */
+} DHT11DriverHooks;
+
+/**
+ * @brief Completion callback of an asynchronous read
+ * 
+ * Called from the handle's worker thread. Another read may be queued
+ * from inside the callback.
+ * 
+ * @param driver Handle that was read
+ * @param reading Outcome, as dht11_driver_read() would have returned it
+ * @param context Context given with the request
+ */
+typedef void (*DHT11DriverCallback)(DHT11Driver* driver, const DHT11Reading* reading, void* context);
+
+/**
+ * @brief One sensor
+ * 
+ * Fields are read-only for callers; change them through the setters.
+ */
+struct DHT11Driver {
+    const GpioPin* pin;                 /**< GPIO pin connected to the data line */
+    const DHT11Protocol* protocol;      /**< Sensor family */
+    DHT11ReadBackend backend;           /**< Backend used to receive transfers */
+    uint8_t start_ms;                   /**< Start pulse length */
+    bool pull_up;                       /**< Internal pull-up enabled on the data line */
+    bool adaptive;                      /**< Bit threshold learned from the measured high phases */
+    uint8_t recovery_flips;             /**< Most bits checksum recovery flips, 0 for off */
+    DHT11Calibration calibration;       /**< Learned bit threshold */
+    DHT11Capture* capture;              /**< Edge capture state, NULL for polling */
+    DHT11SensorCache cache;             /**< Last reading and bus access time */
+    DHT11Transfer transfer;             /**< Raw record of the last transaction */
+    DHT11DriverHooks hooks;             /**< Caller hooks */
+    FuriMutex* mutex;                   /**< Serializes use of the handle */
+    FuriThread* worker;                 /**< Asynchronous read thread, NULL before the first request */
+    DHT11DriverCallback callback;       /**< Completion callback of the pending asynchronous read */
+    void* callback_context;             /**< Context for callback */
+    bool pending;                       /**< An asynchronous read is queued or running */
+};
+
+/**
+ * @brief Allocate a handle for a sensor on a data pin
+ * 
+ * Enables the cycle counter, takes the start pulse and threshold from the
+ * family, selects DHT11_DRIVER_DEFAULT_BACKEND with the internal pull-up
+ * and threshold learning enabled, allows DHT11_RECOVERY_MAX_FLIPS flips of
+ * checksum recovery and puts the pin into its idle state.
+ * 
+ * @param pin GPIO pin connected to the data line
+ * @param family Sensor family
+ * @return Pointer to the allocated handle
+ */
+DHT11Driver* dht11_driver_alloc(const GpioPin* pin, DHT11ProtocolType family);
+
+/**
+ * @brief Free a handle
+ * 
+ * Waits for a pending asynchronous read to complete.
+ * 
+ * @param driver Pointer to the handle
+ */
+void dht11_driver_free(DHT11Driver* driver);
+
+/**
+ * @brief Select how transfers are received
+ * 
+ * @param driver Pointer to the handle
+ * @param backend Read backend
+ */
+void dht11_driver_set_backend(DHT11Driver* driver, DHT11ReadBackend backend);
+
+/**
+ * @brief Override the family's start pulse
+ * 
+ * @param driver Pointer to the handle
+ * @param start_ms Start pulse length, 0 for the family's value
+ */
+void dht11_driver_set_start_ms(DHT11Driver* driver, uint8_t start_ms);
+
+/**
+ * @brief Restart threshold calibration from a given threshold
+ * 
+ * @param driver Pointer to the handle
+ * @param threshold_us Initial threshold, 0 for the family's value
+ */
+void dht11_driver_set_threshold(DHT11Driver* driver, uint8_t threshold_us);
+
+/**
+ * @brief Enable or disable learning of the bit threshold
+ * 
+ * With learning off the threshold stays where dht11_driver_set_threshold()
+ * put it.
+ * 
+ * @param driver Pointer to the handle
+ * @param adaptive true to learn from the measured high phases
+ */
+void dht11_driver_set_adaptive(DHT11Driver* driver, bool adaptive);
+
+/**
+ * @brief Limit checksum recovery
+ * 
+ * @param driver Pointer to the handle
+ * @param max_flips Most bits flipped to pass the checksum, 0 to disable recovery
+ */
+void dht11_driver_set_recovery(DHT11Driver* driver, uint8_t max_flips);
+
+/**
+ * @brief Enable or disable the internal pull-up on the data line
+ * 
+ * Turn it off when the line has an external pull-up of its own. Batch
+ * reads always release the lines with the internal pull-up.
+ * 
+ * @param driver Pointer to the handle
+ * @param pull_up true to enable the pull-up
+ */
+void dht11_driver_set_pull_up(DHT11Driver* driver, bool pull_up);
+
+/**
+ * @brief Attach caller hooks
+ * 
+ * @param driver Pointer to the handle
+ * @param hooks Hooks to copy, NULL to detach
+ */
+void dht11_driver_set_hooks(DHT11Driver* driver, const DHT11DriverHooks* hooks);
+
+/**
+ * @brief Get a reading, touching the bus only when the sensor allows it
+ * 
+ * Starts a transaction if the family's minimum interval has passed since
+ * the previous one; otherwise answers from the cache. Either way the
+ * newest good reading is returned with its age.
+ * 
+ * @param driver Pointer to the handle
+ * @param reading Output for the reading; fresh is set if the bus was used
+ * @return true if a good reading is available
+ */
+bool dht11_driver_read(DHT11Driver* driver, DHT11Reading* reading);
+
+/**
+ * @brief Time until the sensor may go on the bus again
+ * 
+ * @param driver Pointer to the handle
+ * @return Ticks to wait, 0 if dht11_driver_read() would start a transaction now
+ */
+uint32_t dht11_driver_wait_ticks(DHT11Driver* driver);
+
+/**
+ * @brief Always run a transaction
+ * 
+ * Like dht11_driver_read(), but waits out the rest of the minimum
+ * interval instead of answering from the cache.
+ * 
+ * @param driver Pointer to the handle
+ * @param reading Output for the reading, always fresh
+ * @return true if the transaction succeeded
+ */
+bool dht11_driver_read_fresh(DHT11Driver* driver, DHT11Reading* reading);
+
+/**
+ * @brief Queue a read on the handle's worker thread
+ * 
+ * The worker is started on the first request and reads as
+ * dht11_driver_read() does.
+ * 
+ * @param driver Pointer to the handle
+ * @param callback Called with the outcome
+ * @param context Passed to callback
+ * @return false if a read is still pending on this handle
+ */
+bool dht11_driver_read_async(DHT11Driver* driver, DHT11DriverCallback callback, void* context);
+
+/**
+ * @brief Read several sensors at once
+ * 
+ * All selected handles get one shared start pulse, as long as the longest
+ * any of their families needs. Sensors on the same GPIO port are then
+ * received together in a single interrupts-off window by sampling the port
+ * input register, whatever backend the handles selected. Handles still
+ * inside their minimum interval are left out and keep their cached
+ * status. Every handle read calls its own hooks.
+ * 
+ * @param drivers Handles
+ * @param count Number of handles, at most DHT11_DRIVER_BATCH_MAX
+ * @param mask Bit mask of indices into drivers to read
+ * @param read_mask Output for the handles actually read, may be NULL
+ * @param readings Output indexed like drivers, filled for every handle in
+ *                 mask before its lock is released, may be NULL
+ * @return Bit mask of the handles whose most recent transaction succeeded
+ */
+uint8_t dht11_driver_read_batch(
+    DHT11Driver* const* drivers,
+    uint8_t count,
+    uint8_t mask,
+    uint8_t* read_mask,
+    DHT11Reading* readings);
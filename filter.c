@@ -0,0 +1,170 @@
+/**
+ * @file filter.c
+ * @brief Streaming per-sensor filter chain implementation
+ */
+
+#include "filter.h"
+#include <furi.h>
+#include <math.h>
+
+void dht11_filter_config_default(DHT11FilterConfig* config) {
+    config->stages = DHT11_FILTER_DEFAULT_STAGES;
+    config->median_size = DHT11_FILTER_DEFAULT_MEDIAN;
+    config->ema_alpha = DHT11_FILTER_DEFAULT_EMA_ALPHA;
+    config->spike_temperature = DHT11_FILTER_DEFAULT_SPIKE_TEMPERATURE;
+    config->spike_humidity = DHT11_FILTER_DEFAULT_SPIKE_HUMIDITY;
+}
+
+void dht11_filter_reset(DHT11Filter* filter) {
+    memset(filter, 0, sizeof(DHT11Filter));
+}
+
+/**
+ * @brief Median of the channel's window
+ * 
+ * @param channel Filter channel
+ * @param size Configured window size
+ * @return Median of the readings in the window
+ */
+static int16_t dht11_filter_median(const DHT11FilterChannel* channel, uint8_t size) {
+    int16_t sorted[DHT11_FILTER_MEDIAN_MAX];
+    uint8_t count = MIN(channel->window_fill, size);
+    
+    // Insertion sort; the window holds five values at most
+    for(uint8_t i = 0; i < count; i++) {
+        int16_t value = channel->window[i];
+        uint8_t j = i;
+        while(j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    
+    if(count % 2) {
+        return sorted[count / 2];
+    }
+    return (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+}
+
+/**
+ * @brief Fold a value into running statistics
+ * 
+ * @param stats Pointer to the statistics
+ * @param value New value
+ */
+static void dht11_filter_stats_add(DHT11FilterStats* stats, int16_t value) {
+    stats->count++;
+    if(stats->count == 1) {
+        stats->min = value;
+        stats->max = value;
+    } else {
+        stats->min = MIN(stats->min, value);
+        stats->max = MAX(stats->max, value);
+    }
+    
+    // Welford: numerically stable without keeping the values
+    float delta = value - stats->mean;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * (value - stats->mean);
+}
+
+/**
+ * @brief Divide by DHT11_FILTER_EMA_ONE, rounding half away from zero
+ * 
+ * @param scaled Scaled value
+ * @return Value in tenths
+ */
+static int16_t dht11_filter_unscale(int32_t scaled) {
+    int32_t half = DHT11_FILTER_EMA_ONE / 2;
+    return (scaled < 0 ? scaled - half : scaled + half) / DHT11_FILTER_EMA_ONE;
+}
+
+/**
+ * @brief Run an accepted reading through the median and average stages
+ * 
+ * @param channel Filter channel
+ * @param config Filter settings
+ * @param primed The channel has seen a reading before
+ * @param value Raw reading in tenths
+ * @return Filtered value in tenths
+ */
+static int16_t dht11_filter_channel_apply(
+    DHT11FilterChannel* channel,
+    const DHT11FilterConfig* config,
+    bool primed,
+    int16_t value) {
+    channel->last = value;
+    
+    if(config->stages & DHT11FilterStageMedian) {
+        uint8_t size = CLAMP(config->median_size, DHT11_FILTER_MEDIAN_MAX, 1);
+        channel->window[channel->window_pos] = value;
+        channel->window_pos = (channel->window_pos + 1) % size;
+        channel->window_fill = MIN(channel->window_fill + 1, size);
+        value = dht11_filter_median(channel, size);
+    }
+    
+    if(config->stages & DHT11FilterStageEma) {
+        // Keep the average scaled so small weights still move it
+        int32_t scaled = (int32_t)value * DHT11_FILTER_EMA_ONE;
+        channel->ema = primed ? channel->ema + config->ema_alpha * (scaled - channel->ema) / DHT11_FILTER_EMA_ONE :
+                                scaled;
+        value = dht11_filter_unscale(channel->ema);
+    }
+    
+    if(config->stages & DHT11FilterStageStats) {
+        dht11_filter_stats_add(&channel->stats, value);
+    }
+    
+    channel->output = value;
+    return value;
+}
+
+bool dht11_filter_apply(
+    DHT11Filter* filter,
+    const DHT11FilterConfig* config,
+    uint32_t tick,
+    int16_t* temperature,
+    uint16_t* humidity) {
+    furi_assert(filter);
+    furi_assert(config);
+    
+    if(filter->primed && (config->stages & DHT11FilterStageSpike)) {
+        // Allow at least a second's worth of change, however close the reads
+        uint32_t elapsed = tick - filter->last_tick;
+        uint32_t frequency = furi_kernel_get_tick_frequency();
+        uint64_t elapsed_ms = (uint64_t)(elapsed / frequency) * 1000 + (elapsed % frequency) * 1000 / frequency;
+        elapsed_ms = MAX(elapsed_ms, 1000u);
+        
+        bool spike = (uint64_t)abs(*temperature - filter->temperature.last) * 1000 >
+                         config->spike_temperature * elapsed_ms ||
+                     (uint64_t)abs(*humidity - filter->humidity.last) * 1000 >
+                         config->spike_humidity * elapsed_ms;
+        if(spike && filter->rejected < DHT11_FILTER_SPIKE_LIMIT) {
+            filter->rejected++;
+            filter->spikes++;
+            *temperature = filter->temperature.output;
+            *humidity = filter->humidity.output;
+            return false;
+        }
+    }
+    
+    *temperature = dht11_filter_channel_apply(&filter->temperature, config, filter->primed, *temperature);
+    *humidity = dht11_filter_channel_apply(&filter->humidity, config, filter->primed, *humidity);
+    filter->primed = true;
+    filter->last_tick = tick;
+    filter->rejected = 0;
+    return true;
+}
+
+int16_t dht11_filter_stats_mean(const DHT11FilterStats* stats) {
+    return (int16_t)lroundf(stats->mean);
+}
+
+uint16_t dht11_filter_stats_deviation(const DHT11FilterStats* stats) {
+    if(stats->count < 2) {
+        return 0;
+    }
+    // Values are in tenths, so ten times the deviation is in hundredths
+    return (uint16_t)lroundf(sqrtf(stats->m2 / (stats->count - 1)) * 10.0f);
+}
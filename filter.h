@@ -0,0 +1,156 @@
+/**
+ * @file filter.h
+ * @brief Streaming per-sensor filter chain for published samples
+ * 
+ * Raw readings jitter by a count and now and then spike. Between the read
+ * and the sample buffer, every good reading runs through a chain of small
+ * filters, each with fixed state per sensor and constant work per sample:
+ * rate-of-change spike rejection, a median over the last few readings and
+ * an exponential moving average. Running min, max, mean and variance of
+ * the filtered values are kept with Welford's method. The display, logger
+ * and everything else reading the sample buffer see the filtered stream;
+ * the sensor cache and debug reads keep the raw values.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Longest median window */
+#define DHT11_FILTER_MEDIAN_MAX 5
+
+/** @brief Stages enabled by default */
+#define DHT11_FILTER_DEFAULT_STAGES \
+    (DHT11FilterStageSpike | DHT11FilterStageMedian | DHT11FilterStageStats)
+
+/** @brief Default median window, odd and at most DHT11_FILTER_MEDIAN_MAX */
+#define DHT11_FILTER_DEFAULT_MEDIAN 3
+
+/** @brief Fixed-point scale of the moving average weight and state */
+#define DHT11_FILTER_EMA_ONE 256
+
+/** @brief Default moving average weight of a new reading, 0.25 */
+#define DHT11_FILTER_DEFAULT_EMA_ALPHA (DHT11_FILTER_EMA_ONE / 4)
+
+/** @brief Default fastest plausible temperature change, tenths of a degree per second */
+#define DHT11_FILTER_DEFAULT_SPIKE_TEMPERATURE 20
+
+/** @brief Default fastest plausible humidity change, tenths of a percent per second */
+#define DHT11_FILTER_DEFAULT_SPIKE_HUMIDITY 50
+
+/** @brief Rejections in a row after which a jump is taken as a real step */
+#define DHT11_FILTER_SPIKE_LIMIT 3
+
+/**
+ * @brief Filter stages, combined as a bit mask
+ */
+typedef enum {
+    DHT11FilterStageSpike = (1 << 0),   /**< Drop readings that change too fast */
+    DHT11FilterStageMedian = (1 << 1),  /**< Median of the last readings */
+    DHT11FilterStageEma = (1 << 2),     /**< Exponential moving average */
+    DHT11FilterStageStats = (1 << 3),   /**< Running min, max, mean and variance */
+} DHT11FilterStage;
+
+/**
+ * @brief Filter chain settings, shared by all sensors
+ */
+typedef struct {
+    uint8_t stages;                 /**< DHT11FilterStage mask */
+    uint8_t median_size;            /**< Median window, 1 to DHT11_FILTER_MEDIAN_MAX */
+    uint16_t ema_alpha;             /**< Weight of a new reading, 1 to DHT11_FILTER_EMA_ONE */
+    uint16_t spike_temperature;     /**< Largest temperature change per second, in tenths */
+    uint16_t spike_humidity;        /**< Largest humidity change per second, in tenths */
+} DHT11FilterConfig;
+
+/**
+ * @brief Running statistics of one quantity
+ * 
+ * The extremes are exact; mean and m2 stay in float because Welford's
+ * update divides by the count, which fixed point cannot follow for long
+ * runs. Nothing here is on the display or logging path.
+ */
+typedef struct {
+    uint32_t count;                 /**< Values seen */
+    float mean;                     /**< Running mean, in tenths */
+    float m2;                       /**< Sum of squared deviations from the mean */
+    int16_t min;                    /**< Smallest value, in tenths */
+    int16_t max;                    /**< Largest value, in tenths */
+} DHT11FilterStats;
+
+/**
+ * @brief Filter state of one quantity of one sensor, all values in tenths
+ */
+typedef struct {
+    int16_t window[DHT11_FILTER_MEDIAN_MAX];    /**< Last readings, oldest overwritten */
+    uint8_t window_fill;                        /**< Readings in the window */
+    uint8_t window_pos;                         /**< Next slot to overwrite */
+    int16_t last;                               /**< Last accepted raw reading */
+    int16_t output;                             /**< Last value the chain produced */
+    int32_t ema;                                /**< Moving average, scaled by DHT11_FILTER_EMA_ONE */
+    DHT11FilterStats stats;                     /**< Statistics of the filter output */
+} DHT11FilterChannel;
+
+/**
+ * @brief Filter state of one sensor
+ */
+typedef struct {
+    DHT11FilterChannel temperature;     /**< Temperature channel */
+    DHT11FilterChannel humidity;        /**< Humidity channel */
+    bool primed;                        /**< At least one reading was accepted */
+    uint32_t last_tick;                 /**< Tick of the last accepted reading */
+    uint8_t rejected;                   /**< Consecutive spike rejections */
+    uint32_t spikes;                    /**< Readings rejected as spikes */
+} DHT11Filter;
+
+/**
+ * @brief Fill in the default settings
+ * 
+ * @param config Pointer to the settings
+ */
+void dht11_filter_config_default(DHT11FilterConfig* config);
+
+/**
+ * @brief Clear the filter state of a sensor
+ * 
+ * @param filter Pointer to the filter state
+ */
+void dht11_filter_reset(DHT11Filter* filter);
+
+/**
+ * @brief Run a good reading through the chain
+ * 
+ * A reading that moved further from the last accepted one than the
+ * spike limits allow for the time in between is dropped, and the
+ * previous output is returned in its place. After
+ * DHT11_FILTER_SPIKE_LIMIT drops in a row the new level is accepted.
+ * 
+ * @param filter Filter state of the sensor
+ * @param config Filter settings
+ * @param tick Tick of the reading
+ * @param temperature Raw temperature in, filtered temperature out, in tenths
+ * @param humidity Raw humidity in, filtered humidity out, in tenths
+ * @return false if the reading was rejected as a spike
+ */
+bool dht11_filter_apply(
+    DHT11Filter* filter,
+    const DHT11FilterConfig* config,
+    uint32_t tick,
+    int16_t* temperature,
+    uint16_t* humidity);
+
+/**
+ * @brief Mean of the values seen so far
+ * 
+ * @param stats Pointer to the statistics
+ * @return Mean in tenths, rounded
+ */
+int16_t dht11_filter_stats_mean(const DHT11FilterStats* stats);
+
+/**
+ * @brief Standard deviation of the values seen so far
+ * 
+ * @param stats Pointer to the statistics
+ * @return Sample standard deviation in hundredths, 0 with fewer than two values
+ */
+uint16_t dht11_filter_stats_deviation(const DHT11FilterStats* stats);
@@ -0,0 +1,82 @@
+/**
+ * @file format.c
+ * @brief Integer formatting implementation
+ */
+
+#include "format.h"
+#include <string.h>
+
+/**
+ * @brief Copy a string, truncating to the buffer
+ * 
+ * @param buffer Output buffer, always NUL terminated
+ * @param size Size of the output buffer
+ * @param text Characters to copy
+ * @param length Number of characters
+ * @return Number of characters written, excluding the NUL
+ */
+static size_t dht11_format_copy(char* buffer, size_t size, const char* text, size_t length) {
+    if(size == 0) {
+        return 0;
+    }
+    if(length >= size) {
+        length = size - 1;
+    }
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Print a magnitude with an optional sign and decimal point
+ * 
+ * @param buffer Output buffer, always NUL terminated
+ * @param size Size of the output buffer
+ * @param magnitude Absolute value
+ * @param negative Prefix a minus sign
+ * @param decimals Digits after the decimal point
+ * @return Number of characters written, excluding the NUL
+ */
+static size_t dht11_format_digits(char* buffer, size_t size, uint32_t magnitude, bool negative, uint8_t decimals) {
+    // Ten digits, sign, point and leading zeros for up to nine decimals
+    char digits[24];
+    size_t pos = sizeof(digits);
+    uint8_t printed = 0;
+    
+    // Digits come out least significant first, so fill from the end
+    do {
+        if(decimals > 0 && printed == decimals) {
+            digits[--pos] = '.';
+        }
+        digits[--pos] = '0' + magnitude % 10;
+        magnitude /= 10;
+        printed++;
+    } while((magnitude > 0 || printed <= decimals) && pos > 2);
+    
+    if(negative) {
+        digits[--pos] = '-';
+    }
+    
+    return dht11_format_copy(buffer, size, digits + pos, sizeof(digits) - pos);
+}
+
+size_t dht11_format_uint(char* buffer, size_t size, uint32_t value) {
+    return dht11_format_digits(buffer, size, value, false, 0);
+}
+
+size_t dht11_format_fixed(char* buffer, size_t size, int32_t value, uint8_t decimals) {
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    return dht11_format_digits(buffer, size, magnitude, value < 0, decimals);
+}
+
+int32_t dht11_format_fahrenheit(int32_t celsius) {
+    // Round half away from zero, as printf did on the float value
+    int32_t scaled = celsius * 9;
+    scaled += scaled < 0 ? -2 : 2;
+    return scaled / 5 + 320;
+}
+
+size_t dht11_format_temperature(char* buffer, size_t size, int32_t celsius, bool imperial) {
+    size_t length = dht11_format_fixed(buffer, size, imperial ? dht11_format_fahrenheit(celsius) : celsius, 1);
+    return length + dht11_format_copy(buffer + length, size - length, imperial ? "°F" : "°C", strlen("°C"));
+}
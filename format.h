@@ -0,0 +1,62 @@
+/**
+ * @file format.h
+ * @brief Integer formatting of fixed-point readings
+ * 
+ * Readings travel through the app as integers in tenths. These helpers
+ * print them without going through float printf, which keeps soft-float
+ * formatting out of the logging path and out of the binary.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Buffer size that fits any fixed-point value, sign, point and NUL included */
+#define DHT11_FORMAT_FIXED_SIZE 13
+
+/** @brief Buffer size that fits any formatted temperature, unit and NUL included */
+#define DHT11_FORMAT_TEMPERATURE_SIZE 16
+
+/**
+ * @brief Print an unsigned integer
+ * 
+ * @param buffer Output buffer, always NUL terminated
+ * @param size Size of the output buffer
+ * @param value Value to print
+ * @return Number of characters written, excluding the NUL
+ */
+size_t dht11_format_uint(char* buffer, size_t size, uint32_t value);
+
+/**
+ * @brief Print a fixed-point value
+ * 
+ * dht11_format_fixed(buffer, size, -53, 1) prints "-5.3".
+ * 
+ * @param buffer Output buffer, always NUL terminated
+ * @param size Size of the output buffer
+ * @param value Value in units of 10^-decimals
+ * @param decimals Digits after the decimal point
+ * @return Number of characters written, excluding the NUL
+ */
+size_t dht11_format_fixed(char* buffer, size_t size, int32_t value, uint8_t decimals);
+
+/**
+ * @brief Convert a temperature to Fahrenheit, rounding to the nearest tenth
+ * 
+ * @param celsius Temperature in tenths of a degree Celsius
+ * @return Temperature in tenths of a degree Fahrenheit
+ */
+int32_t dht11_format_fahrenheit(int32_t celsius);
+
+/**
+ * @brief Print a temperature with one decimal and its unit
+ * 
+ * @param buffer Output buffer, always NUL terminated
+ * @param size Size of the output buffer
+ * @param celsius Temperature in tenths of a degree Celsius
+ * @param imperial Print in Fahrenheit instead of Celsius
+ * @return Number of characters written, excluding the NUL
+ */
+size_t dht11_format_temperature(char* buffer, size_t size, int32_t celsius, bool imperial);
@@ -0,0 +1,120 @@
+/**
+ * @file graph_scene.c
+ * @brief History graph scene implementation
+ */
+
+#include "graph_scene.h"
+#include "scenes.h"
+#include "scene_views.h"
+#include <furi_hal.h>
+
+/**
+ * @brief Input callback for the sensor selection keys
+ * 
+ * @param event Custom event for the pressed key
+ * @param context Application context
+ */
+static void dht11_graph_view_callback(uint32_t event, void* context) {
+    DHT11App* app = context;
+    scene_manager_handle_custom_event(app->scene_manager, event);
+}
+
+/**
+ * @brief Summarize the archive span shown into plot columns
+ * 
+ * Each column seeks to its start through the archive index, so only a
+ * few blocks are read per column however long the archive is.
+ * 
+ * @param app Application context
+ */
+static void dht11_graph_scene_load(DHT11App* app) {
+    uint32_t span = dht11_graph_view_get_log_span(app->graph_view);
+    if(span == 0 || app->sensor_count == 0) {
+        return;
+    }
+    
+    // The logger holds an archive open for writing; while it is paused for
+    // the read, the block it is filling is taken from RAM
+    bool paused = app->logger->format == DHT11LoggerFormatArchive && dht11_logger_pause(app->logger);
+    
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DHT11ArchiveReader* reader = dht11_archive_reader_open(storage, DHT11_LOGGER_ARCHIVE_PATH);
+    DHT11GraphColumn* columns = NULL;
+    if(reader) {
+        if(paused && app->logger->fill == 0) {
+            dht11_archive_reader_set_tail(reader, app->logger->archive);
+        }
+        columns = malloc(DHT11_GRAPH_WIDTH * sizeof(DHT11GraphColumn));
+        uint32_t from = furi_hal_rtc_get_timestamp() - span;
+        for(uint16_t c = 0; c < DHT11_GRAPH_WIDTH; c++) {
+            uint32_t start = from + (uint64_t)span * c / DHT11_GRAPH_WIDTH;
+            uint32_t end = from + (uint64_t)span * (c + 1) / DHT11_GRAPH_WIDTH;
+            columns[c].count = dht11_archive_reader_summarize(
+                reader, app->selected_sensor, start, end, DHT11_GRAPH_SCENE_COLUMN_BLOCKS, columns[c].range);
+        }
+        dht11_archive_reader_close(reader);
+    }
+    furi_record_close(RECORD_STORAGE);
+    
+    if(paused) {
+        dht11_logger_resume(app->logger);
+    }
+    
+    dht11_graph_view_set_log(app->graph_view, columns);
+    free(columns);
+}
+
+/**
+ * @brief Point the graph at the selected sensor
+ * 
+ * @param app Application context
+ */
+static void dht11_graph_scene_select(DHT11App* app) {
+    dht11_graph_view_set_sensor(
+        app->graph_view,
+        app->sensor_count > 0 ? app->sensors[app->selected_sensor].name : NULL,
+        app->selected_sensor,
+        app->sensor_count,
+        app->settings.imperial);
+    dht11_graph_scene_load(app);
+}
+
+void dht11_scene_graph_on_enter(void* context) {
+    DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneGraph);
+    
+    dht11_graph_view_set_callback(app->graph_view, dht11_graph_view_callback, app);
+    dht11_graph_scene_select(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneGraph);
+}
+
+bool dht11_scene_graph_on_event(void* context, SceneManagerEvent event) {
+    DHT11App* app = context;
+    bool consumed = false;
+    
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == DHT11CustomEventSampleReady) {
+            dht11_graph_view_update(app->graph_view);
+        } else if(event.event == DHT11CustomEventGraphLoad) {
+            dht11_graph_scene_load(app);
+        } else if(event.event == DHT11CustomEventPreviousSensor && app->sensor_count > 0) {
+            app->selected_sensor = (app->selected_sensor + app->sensor_count - 1) % app->sensor_count;
+            dht11_graph_scene_select(app);
+        } else if(event.event == DHT11CustomEventNextSensor && app->sensor_count > 0) {
+            app->selected_sensor = (app->selected_sensor + 1) % app->sensor_count;
+            dht11_graph_scene_select(app);
+        }
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+    
+    return consumed;
+}
+
+void dht11_scene_graph_on_exit(void* context) {
+    DHT11App* app = context;
+    dht11_graph_view_set_callback(app->graph_view, NULL, NULL);
+    dht11_scene_view_release(app, DHT11SceneGraph);
+}
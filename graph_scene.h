@@ -0,0 +1,15 @@
+/**
+ * @file graph_scene.h
+ * @brief History graph scene interface
+ * 
+ * This file contains the interface for the history graph scene which plots
+ * temperature and humidity trends from the in-memory history and from the
+ * SD archive.
+ */
+
+#pragma once
+
+#include "app.h"
+
+/** @brief Most archive blocks read for one plot column; longer columns show their start */
+#define DHT11_GRAPH_SCENE_COLUMN_BLOCKS 2
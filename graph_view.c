@@ -0,0 +1,414 @@
+/**
+ * @file graph_view.c
+ * @brief History trend graph view implementation
+ */
+
+#include "graph_view.h"
+#include "app.h"
+#include "format.h"
+
+/** @brief Left edge of the plot, leaving room for the scale labels */
+#define DHT11_GRAPH_X 27
+
+/** @brief Top edge of the plot, below the title */
+#define DHT11_GRAPH_Y 11
+
+/** @brief Plot height */
+#define DHT11_GRAPH_HEIGHT 53
+
+/** @brief Smallest vertical span, in tenths, so noise is not magnified */
+#define DHT11_GRAPH_MIN_SPAN 20
+
+/** @brief History tiers followed by the archive spans */
+#define DHT11_GRAPH_TIERS (DHT11HistoryTierCount + DHT11_GRAPH_LOG_SPAN_COUNT)
+
+struct DHT11GraphView {
+    View* view;                         /**< Underlying view */
+    DHT11GraphViewCallback callback;    /**< Input callback */
+    void* context;                      /**< Context for the callback */
+};
+
+/**
+ * @brief Model drawn by the view
+ */
+typedef struct {
+    DHT11History* history;              /**< History being plotted */
+    uint8_t tier;                       /**< A DHT11HistoryTier, or an archive span after them */
+    DHT11HistoryMetric metric;          /**< Quantity shown */
+    char name[4];                       /**< Data pin name */
+    uint8_t index;                      /**< Sensor shown */
+    uint8_t count;                      /**< Number of sensors */
+    bool imperial;                      /**< Label temperatures in Fahrenheit */
+    DHT11GraphColumn* log;              /**< Columns of the archive span, allocated on first use */
+    bool log_loaded;                    /**< log holds the span and sensor shown */
+} DHT11GraphViewModel;
+
+static const char* const dht11_graph_tier_names[DHT11_GRAPH_TIERS] = {
+    [DHT11HistoryTierRaw] = "Raw",
+    [DHT11HistoryTierMinute] = "1 min",
+    [DHT11HistoryTierHour] = "1 hour",
+    [DHT11HistoryTierCount] = "SD 1 day",
+    [DHT11HistoryTierCount + 1] = "SD 7 days",
+};
+
+static const uint32_t dht11_graph_log_spans[DHT11_GRAPH_LOG_SPAN_COUNT] = DHT11_GRAPH_LOG_SPANS;
+
+/**
+ * @brief Combine the points plotted in one column
+ * 
+ * @param model View model, with the history locked
+ * @param first First point of the column
+ * @param last One past the last point of the column
+ * @param range Output for the spread of the column
+ * @return false if every point of the column is a gap
+ */
+static bool dht11_graph_column(
+    const DHT11GraphViewModel* model,
+    uint16_t first,
+    uint16_t last,
+    DHT11HistoryRange* range) {
+    int32_t sum = 0;
+    uint16_t points = 0;
+    
+    for(uint16_t i = first; i < last; i++) {
+        DHT11HistoryRange point;
+        if(!dht11_history_get(model->history, model->index, model->tier, model->metric, i, &point)) {
+            continue;
+        }
+        if(points == 0) {
+            *range = point;
+        }
+        range->min = MIN(range->min, point.min);
+        range->max = MAX(range->max, point.max);
+        sum += point.mean;
+        points++;
+    }
+    
+    if(points > 0) {
+        range->mean = sum / points;
+    }
+    return points > 0;
+}
+
+/**
+ * @brief Get the spread plotted in one column
+ * 
+ * @param model View model, with the history locked for a history tier
+ * @param count Points in the tier
+ * @param per_column Points combined into one column
+ * @param column Column, 0 is the newest
+ * @param range Output for the spread of the column
+ * @return false if the column is a gap
+ */
+static bool dht11_graph_point(
+    const DHT11GraphViewModel* model,
+    uint16_t count,
+    uint16_t per_column,
+    int32_t column,
+    DHT11HistoryRange* range) {
+    if(model->tier >= DHT11HistoryTierCount) {
+        const DHT11GraphColumn* point = &model->log[DHT11_GRAPH_WIDTH - 1 - column];
+        if(point->count == 0) {
+            return false;
+        }
+        *range = point->range[model->metric];
+        return true;
+    }
+    
+    int32_t last = count - column * per_column;
+    return dht11_graph_column(model, MAX(last - per_column, 0), last, range);
+}
+
+/**
+ * @brief Format a scale label
+ * 
+ * @param model View model
+ * @param tenths Value in tenths of the stored unit
+ * @param buffer Output buffer
+ * @param size Size of the output buffer
+ */
+static void dht11_graph_format_label(const DHT11GraphViewModel* model, int32_t tenths, char* buffer, size_t size) {
+    if(model->metric == DHT11HistoryMetricTemperature && model->imperial) {
+        tenths = dht11_format_fahrenheit(tenths);
+    }
+    dht11_format_fixed(buffer, size, tenths, 1);
+}
+
+/**
+ * @brief Map a value onto the plot
+ * 
+ * @param value Value in tenths
+ * @param low Value at the bottom edge
+ * @param high Value at the top edge
+ * @return Screen row
+ */
+static int32_t dht11_graph_row(int32_t value, int32_t low, int32_t high) {
+    return DHT11_GRAPH_Y + (DHT11_GRAPH_HEIGHT - 1) -
+           (value - low) * (DHT11_GRAPH_HEIGHT - 1) / (high - low);
+}
+
+/**
+ * @brief Draw callback
+ * 
+ * Title, scale labels on the left and one column per plot pixel, newest
+ * on the right. Each column is a bar from minimum to maximum, and the
+ * means are joined by a line.
+ * 
+ * @param canvas Canvas to draw on
+ * @param _model DHT11GraphViewModel
+ */
+static void dht11_graph_view_draw(Canvas* canvas, void* _model) {
+    DHT11GraphViewModel* model = _model;
+    char buffer[32];
+    
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontSecondary);
+    
+    const char* unit = model->metric == DHT11HistoryMetricHumidity ? "%" : (model->imperial ? "°F" : "°C");
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%s %s  %s  %s",
+        model->metric == DHT11HistoryMetricHumidity ? "Hum" : "Temp",
+        unit,
+        dht11_graph_tier_names[model->tier],
+        model->name);
+    canvas_draw_str_aligned(canvas, 64, 0, AlignCenter, AlignTop, buffer);
+    
+    if(!model->history) {
+        return;
+    }
+    
+    // An archive span fills every column; raw readings are twice as many
+    bool log = model->tier >= DHT11HistoryTierCount;
+    uint16_t per_column = 1;
+    uint16_t count = 0;
+    if(log) {
+        if(!model->log_loaded) {
+            canvas_draw_str_aligned(canvas, 64, 36, AlignCenter, AlignCenter, "No SD archive");
+            return;
+        }
+        count = DHT11_GRAPH_WIDTH;
+    } else {
+        per_column = MAX(dht11_history_capacity(model->tier) / DHT11_GRAPH_WIDTH, 1);
+        dht11_history_lock(model->history);
+        count = dht11_history_count(model->history, model->index, model->tier);
+    }
+    uint16_t columns = MIN((count + per_column - 1) / per_column, DHT11_GRAPH_WIDTH);
+    
+    // Scale to the visible points
+    int32_t low = INT16_MAX;
+    int32_t high = INT16_MIN;
+    for(uint16_t c = 0; c < columns; c++) {
+        DHT11HistoryRange range;
+        if(dht11_graph_point(model, count, per_column, c, &range)) {
+            low = MIN(low, range.min);
+            high = MAX(high, range.max);
+        }
+    }
+    
+    if(low > high) {
+        if(!log) {
+            dht11_history_unlock(model->history);
+        }
+        canvas_draw_str_aligned(canvas, 64, 36, AlignCenter, AlignCenter, "No data yet");
+        return;
+    }
+    if(high - low < DHT11_GRAPH_MIN_SPAN) {
+        int32_t middle = (high + low) / 2;
+        low = middle - DHT11_GRAPH_MIN_SPAN / 2;
+        high = middle + DHT11_GRAPH_MIN_SPAN / 2;
+    }
+    
+    canvas_draw_line(
+        canvas, DHT11_GRAPH_X - 1, DHT11_GRAPH_Y, DHT11_GRAPH_X - 1, DHT11_GRAPH_Y + DHT11_GRAPH_HEIGHT - 1);
+    dht11_graph_format_label(model, high, buffer, sizeof(buffer));
+    canvas_draw_str_aligned(canvas, 0, DHT11_GRAPH_Y, AlignLeft, AlignTop, buffer);
+    dht11_graph_format_label(model, low, buffer, sizeof(buffer));
+    canvas_draw_str_aligned(canvas, 0, DHT11_GRAPH_Y + DHT11_GRAPH_HEIGHT, AlignLeft, AlignBottom, buffer);
+    
+    // Newest column at the right edge
+    int32_t previous_row = -1;
+    for(int32_t c = columns - 1; c >= 0; c--) {
+        DHT11HistoryRange range;
+        int32_t x = DHT11_GRAPH_X + DHT11_GRAPH_WIDTH - 1 - c;
+        
+        if(!dht11_graph_point(model, count, per_column, c, &range)) {
+            previous_row = -1;
+            continue;
+        }
+        
+        int32_t row = dht11_graph_row(range.mean, low, high);
+        canvas_draw_line(canvas, x, dht11_graph_row(range.min, low, high), x, dht11_graph_row(range.max, low, high));
+        if(previous_row >= 0) {
+            canvas_draw_line(canvas, x - 1, previous_row, x, row);
+        }
+        previous_row = row;
+    }
+    
+    if(!log) {
+        dht11_history_unlock(model->history);
+    }
+}
+
+/**
+ * @brief Input callback
+ * 
+ * @param event Input event
+ * @param context DHT11GraphView
+ * @return true if the event was consumed
+ */
+static bool dht11_graph_view_input(InputEvent* event, void* context) {
+    DHT11GraphView* graph_view = context;
+    
+    if(event->type != InputTypePress && event->type != InputTypeRepeat) {
+        return false;
+    }
+    
+    bool consumed = false;
+    bool load = false;
+    uint8_t count = 0;
+    with_view_model(
+        graph_view->view,
+        DHT11GraphViewModel * model,
+        {
+            count = model->count;
+            if(event->key == InputKeyUp) {
+                model->tier = (model->tier + DHT11_GRAPH_TIERS - 1) % DHT11_GRAPH_TIERS;
+                consumed = true;
+            } else if(event->key == InputKeyDown) {
+                model->tier = (model->tier + 1) % DHT11_GRAPH_TIERS;
+                consumed = true;
+            } else if(event->key == InputKeyOk) {
+                model->metric = (model->metric + 1) % DHT11HistoryMetricCount;
+                consumed = true;
+            }
+            if(event->key == InputKeyUp || event->key == InputKeyDown) {
+                model->log_loaded = false;
+                load = model->tier >= DHT11HistoryTierCount;
+            }
+        },
+        consumed);
+    
+    // The archive is read by the scene, never from the draw callback
+    if(load && graph_view->callback) {
+        graph_view->callback(DHT11CustomEventGraphLoad, graph_view->context);
+    }
+    
+    if(consumed || !graph_view->callback || count < 2) {
+        return consumed;
+    }
+    
+    if(event->key == InputKeyLeft) {
+        graph_view->callback(DHT11CustomEventPreviousSensor, graph_view->context);
+        return true;
+    } else if(event->key == InputKeyRight) {
+        graph_view->callback(DHT11CustomEventNextSensor, graph_view->context);
+        return true;
+    }
+    
+    return false;
+}
+
+DHT11GraphView* dht11_graph_view_alloc(DHT11History* history) {
+    DHT11GraphView* graph_view = malloc(sizeof(DHT11GraphView));
+    graph_view->callback = NULL;
+    graph_view->context = NULL;
+    
+    graph_view->view = view_alloc();
+    view_allocate_model(graph_view->view, ViewModelTypeLocking, sizeof(DHT11GraphViewModel));
+    view_set_context(graph_view->view, graph_view);
+    view_set_draw_callback(graph_view->view, dht11_graph_view_draw);
+    view_set_input_callback(graph_view->view, dht11_graph_view_input);
+    
+    with_view_model(
+        graph_view->view,
+        DHT11GraphViewModel * model,
+        {
+            memset(model, 0, sizeof(DHT11GraphViewModel));
+            model->history = history;
+            model->tier = DHT11HistoryTierMinute;
+        },
+        false);
+    
+    return graph_view;
+}
+
+void dht11_graph_view_free(DHT11GraphView* graph_view) {
+    furi_assert(graph_view);
+    with_view_model(graph_view->view, DHT11GraphViewModel * model, { free(model->log); }, false);
+    view_free(graph_view->view);
+    free(graph_view);
+}
+
+View* dht11_graph_view_get_view(DHT11GraphView* graph_view) {
+    furi_assert(graph_view);
+    return graph_view->view;
+}
+
+void dht11_graph_view_set_callback(DHT11GraphView* graph_view, DHT11GraphViewCallback callback, void* context) {
+    furi_assert(graph_view);
+    graph_view->callback = callback;
+    graph_view->context = context;
+}
+
+void dht11_graph_view_set_sensor(
+    DHT11GraphView* graph_view,
+    const char* name,
+    uint8_t index,
+    uint8_t count,
+    bool imperial) {
+    furi_assert(graph_view);
+    
+    with_view_model(
+        graph_view->view,
+        DHT11GraphViewModel * model,
+        {
+            snprintf(model->name, sizeof(model->name), "%s", name ? name : "");
+            model->index = index;
+            model->count = count;
+            model->imperial = imperial;
+            model->log_loaded = false;
+        },
+        true);
+}
+
+void dht11_graph_view_update(DHT11GraphView* graph_view) {
+    furi_assert(graph_view);
+    with_view_model(graph_view->view, DHT11GraphViewModel * model, { UNUSED(model); }, true);
+}
+
+uint32_t dht11_graph_view_get_log_span(DHT11GraphView* graph_view) {
+    furi_assert(graph_view);
+    
+    uint32_t span = 0;
+    with_view_model(
+        graph_view->view,
+        DHT11GraphViewModel * model,
+        {
+            if(model->tier >= DHT11HistoryTierCount) {
+                span = dht11_graph_log_spans[model->tier - DHT11HistoryTierCount];
+            }
+        },
+        false);
+    return span;
+}
+
+void dht11_graph_view_set_log(DHT11GraphView* graph_view, const DHT11GraphColumn* columns) {
+    furi_assert(graph_view);
+    
+    with_view_model(
+        graph_view->view,
+        DHT11GraphViewModel * model,
+        {
+            if(columns) {
+                if(!model->log) {
+                    model->log = malloc(DHT11_GRAPH_WIDTH * sizeof(DHT11GraphColumn));
+                }
+                memcpy(model->log, columns, DHT11_GRAPH_WIDTH * sizeof(DHT11GraphColumn));
+            }
+            model->log_loaded = columns != NULL;
+        },
+        true);
+}
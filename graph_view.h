@@ -0,0 +1,122 @@
+/**
+ * @file graph_view.h
+ * @brief History trend graph view
+ * 
+ * Plots one tier of one metric of a sensor's history. The draw callback
+ * reads straight from the history ring buffers under the history lock,
+ * so the graph costs no memory besides the history itself.
+ * 
+ * After the history tiers come longer spans taken from the SD archive.
+ * Those are never read while drawing; the scene is asked to summarize
+ * the span into columns, which are then kept by the view.
+ */
+
+#pragma once
+
+#include <gui/view.h>
+#include "history.h"
+
+/** @brief Plot width, one column per point of the minute and hour tiers */
+#define DHT11_GRAPH_WIDTH 100
+
+/** @brief Spans of the SD archive shown after the history tiers, in seconds */
+#define DHT11_GRAPH_LOG_SPANS {24 * 60 * 60, 7 * 24 * 60 * 60}
+
+/** @brief Number of entries in DHT11_GRAPH_LOG_SPANS */
+#define DHT11_GRAPH_LOG_SPAN_COUNT 2
+
+/**
+ * @brief One plot column of an archive span
+ */
+typedef struct {
+    DHT11HistoryRange range[DHT11HistoryMetricCount];   /**< Spread of each metric */
+    uint16_t count;                                     /**< Readings in the column, 0 for a gap */
+} DHT11GraphColumn;
+
+/**
+ * @brief Input callback, invoked with a DHT11CustomEvent
+ * 
+ * @param event Custom event for the pressed key
+ * @param context User context
+ */
+typedef void (*DHT11GraphViewCallback)(uint32_t event, void* context);
+
+/** @brief Graph view instance */
+typedef struct DHT11GraphView DHT11GraphView;
+
+/**
+ * @brief Allocate the graph view
+ * 
+ * @param history History to plot; must outlive the view
+ * @return Pointer to the allocated view
+ */
+DHT11GraphView* dht11_graph_view_alloc(DHT11History* history);
+
+/**
+ * @brief Free the graph view
+ * 
+ * @param graph_view Pointer to the view
+ */
+void dht11_graph_view_free(DHT11GraphView* graph_view);
+
+/**
+ * @brief Get the underlying View for the view dispatcher
+ * 
+ * @param graph_view Pointer to the view
+ * @return View instance
+ */
+View* dht11_graph_view_get_view(DHT11GraphView* graph_view);
+
+/**
+ * @brief Set the function called on Left and Right
+ * 
+ * Up and Down switch the tier and OK the metric without a callback;
+ * switching to an archive span asks for its columns with
+ * DHT11CustomEventGraphLoad.
+ * 
+ * @param graph_view Pointer to the view
+ * @param callback Callback receiving DHT11CustomEventPreviousSensor, NextSensor or GraphLoad
+ * @param context Context passed to the callback
+ */
+void dht11_graph_view_set_callback(DHT11GraphView* graph_view, DHT11GraphViewCallback callback, void* context);
+
+/**
+ * @brief Select the sensor to plot
+ * 
+ * @param graph_view Pointer to the view
+ * @param name Data pin name of the sensor
+ * @param index Index of the sensor
+ * @param count Number of sensors; selection is enabled if more than one
+ * @param imperial Label temperatures in Fahrenheit
+ */
+void dht11_graph_view_set_sensor(
+    DHT11GraphView* graph_view,
+    const char* name,
+    uint8_t index,
+    uint8_t count,
+    bool imperial);
+
+/**
+ * @brief Redraw with the current history contents
+ * 
+ * @param graph_view Pointer to the view
+ */
+void dht11_graph_view_update(DHT11GraphView* graph_view);
+
+/**
+ * @brief Length of the archive span shown
+ * 
+ * @param graph_view Pointer to the view
+ * @return Span in seconds, 0 while a history tier is shown
+ */
+uint32_t dht11_graph_view_get_log_span(DHT11GraphView* graph_view);
+
+/**
+ * @brief Set the columns of the archive span shown
+ * 
+ * The view keeps a copy until the tier or the sensor changes.
+ * 
+ * @param graph_view Pointer to the view
+ * @param columns DHT11_GRAPH_WIDTH columns, oldest first, NULL if there is no archive
+ */
+void dht11_graph_view_set_log(DHT11GraphView* graph_view, const DHT11GraphColumn* columns);
@@ -0,0 +1,116 @@
+/**
+ * @file hal.h
+ * @brief Pin and clock interface under the protocol code
+ * 
+ * The decoder, timing core and polling receiver only touch hardware
+ * through these calls. On the Flipper they are inline wrappers around
+ * furi_hal_gpio and the DWT cycle counter, so the hot loops compile to
+ * the same code as direct register access. Defining DHT11_HAL_HOST turns
+ * them into plain prototypes that a desktop build implements, for example
+ * with a simulated data line replaying a recorded waveform.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef DHT11_HAL_HOST
+
+/** @brief Opaque data line handle provided by the host build */
+typedef const struct DHT11HostPin* DHT11HalPin;
+
+/** @brief Start the cycle counter */
+void dht11_hal_clock_init(void);
+
+/** @brief Cycle counter frequency in Hz */
+uint32_t dht11_hal_clock_hz(void);
+
+/** @brief Current cycle counter value, wrapping at 32 bits */
+uint32_t dht11_hal_cycles(void);
+
+/** @brief Sample the data line */
+bool dht11_hal_pin_read(DHT11HalPin pin);
+
+/** @brief Drive the data line to a level */
+void dht11_hal_pin_write(DHT11HalPin pin, bool level);
+
+/** @brief Switch the data line to push-pull output */
+void dht11_hal_pin_drive(DHT11HalPin pin);
+
+/** @brief Release the data line to input, with or without the internal pull-up */
+void dht11_hal_pin_release(DHT11HalPin pin, bool pull_up);
+
+#else
+
+#include <furi_hal.h>
+
+/** @brief Data line handle */
+typedef const GpioPin* DHT11HalPin;
+
+/**
+ * @brief Start the cycle counter
+ */
+static inline void dht11_hal_clock_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Cycle counter frequency
+ * 
+ * @return Frequency in Hz
+ */
+static inline uint32_t dht11_hal_clock_hz(void) {
+    return SystemCoreClock;
+}
+
+/**
+ * @brief Current cycle counter value
+ * 
+ * @return DWT cycle count, wrapping at 32 bits
+ */
+static inline uint32_t dht11_hal_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Sample the data line
+ * 
+ * @param pin Data line
+ * @return Current level
+ */
+static inline bool dht11_hal_pin_read(DHT11HalPin pin) {
+    return furi_hal_gpio_read(pin);
+}
+
+/**
+ * @brief Drive the data line to a level
+ * 
+ * @param pin Data line, must be an output
+ * @param level Level to drive
+ */
+static inline void dht11_hal_pin_write(DHT11HalPin pin, bool level) {
+    furi_hal_gpio_write(pin, level);
+}
+
+/**
+ * @brief Switch the data line to push-pull output
+ * 
+ * @param pin Data line
+ */
+static inline void dht11_hal_pin_drive(DHT11HalPin pin) {
+    furi_hal_gpio_init(pin, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
+}
+
+/**
+ * @brief Release the data line to input
+ * 
+ * @param pin Data line
+ * @param pull_up Enable the internal pull-up, off when only an external one is fitted
+ */
+static inline void dht11_hal_pin_release(DHT11HalPin pin, bool pull_up) {
+    furi_hal_gpio_init(pin, GpioModeInput, pull_up ? GpioPullUp : GpioPullNo, GpioSpeedLow);
+}
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * @file history.c
+ * @brief Multi-resolution sample history implementation
+ */
+
+#include "history.h"
+
+/** @brief Number of aggregated tiers, minutes and hours */
+#define DHT11_HISTORY_AGGREGATES (DHT11HistoryTierCount - 1)
+
+/** @brief Minutes in one hour bucket */
+#define DHT11_HISTORY_MINUTES_PER_HOUR 60
+
+/**
+ * @brief One raw reading
+ */
+typedef struct {
+    int16_t value[DHT11HistoryMetricCount];     /**< Reading in tenths */
+} DHT11HistoryRaw;
+
+/**
+ * @brief One minute or hour bucket
+ */
+typedef struct {
+    DHT11HistoryRange range[DHT11HistoryMetricCount];   /**< Spread of each metric */
+    uint16_t count;                                     /**< Readings in the bucket, 0 for a gap */
+} DHT11HistoryBucket;
+
+/**
+ * @brief Bucket being filled
+ */
+typedef struct {
+    uint32_t bucket;                            /**< Bucket number, counted on across tick wraps */
+    DHT11HistoryBucket point;                   /**< Running min and max */
+    int32_t sum[DHT11HistoryMetricCount];       /**< Running sum for the mean */
+} DHT11HistoryAccumulator;
+
+/**
+ * @brief Ring buffer of buckets
+ */
+typedef struct {
+    DHT11HistoryBucket points[DHT11_HISTORY_LENGTH];    /**< Closed buckets */
+    uint32_t head;                                      /**< Number of buckets ever closed */
+    DHT11HistoryAccumulator open;                       /**< Bucket being filled */
+} DHT11HistoryTierBuffer;
+
+/**
+ * @brief History of one sensor
+ */
+typedef struct {
+    DHT11HistoryRaw raw[DHT11_HISTORY_RAW_LENGTH];      /**< Recent readings */
+    uint32_t raw_head;                                  /**< Number of readings ever added */
+    uint32_t minute;                                    /**< Minute bucket of the newest reading */
+    uint32_t minute_start;                              /**< Tick at which that minute began */
+    DHT11HistoryTierBuffer tiers[DHT11_HISTORY_AGGREGATES];     /**< Minute and hour tiers */
+} DHT11HistorySensor;
+
+struct DHT11History {
+    FuriMutex* mutex;               /**< Guards the buffers between producer and readers */
+    uint8_t sensor_count;           /**< Number of entries in sensors */
+    uint32_t minute_ticks;          /**< Ticks in one minute */
+    DHT11HistorySensor sensors[];   /**< Per-sensor history */
+};
+
+DHT11History* dht11_history_alloc(uint8_t sensor_count) {
+    DHT11History* history = malloc(sizeof(DHT11History) + sensor_count * sizeof(DHT11HistorySensor));
+    memset(history->sensors, 0, sensor_count * sizeof(DHT11HistorySensor));
+    history->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    history->sensor_count = sensor_count;
+    history->minute_ticks = furi_ms_to_ticks(60 * 1000);
+    return history;
+}
+
+void dht11_history_free(DHT11History* history) {
+    furi_assert(history);
+    furi_mutex_free(history->mutex);
+    free(history);
+}
+
+/**
+ * @brief Fold a reading or a closed bucket into a tier
+ * 
+ * Closes the open bucket first when the point belongs to a later one,
+ * passes it on to the next coarser tier and leaves a gap for every bucket
+ * that received nothing.
+ * 
+ * @param sensor History of the sensor
+ * @param level Aggregated tier, 0 for minutes
+ * @param bucket Bucket number of the point in this tier
+ * @param point Reading or bucket to add
+ */
+static void dht11_history_accumulate(
+    DHT11HistorySensor* sensor,
+    uint8_t level,
+    uint32_t bucket,
+    const DHT11HistoryBucket* point) {
+    DHT11HistoryTierBuffer* tier = &sensor->tiers[level];
+    DHT11HistoryAccumulator* open = &tier->open;
+    
+    if(open->point.count > 0 && bucket != open->bucket) {
+        DHT11HistoryBucket closed = open->point;
+        for(uint8_t m = 0; m < DHT11HistoryMetricCount; m++) {
+            closed.range[m].mean = open->sum[m] / (int32_t)closed.count;
+        }
+        tier->points[tier->head++ % DHT11_HISTORY_LENGTH] = closed;
+        
+        if(level + 1 < DHT11_HISTORY_AGGREGATES) {
+            dht11_history_accumulate(sensor, level + 1, open->bucket / DHT11_HISTORY_MINUTES_PER_HOUR, &closed);
+        }
+        
+        // Empty buckets in between, never more than the ring holds
+        uint32_t missing = MIN(bucket - open->bucket - 1, (uint32_t)DHT11_HISTORY_LENGTH);
+        for(uint32_t i = 0; i < missing; i++) {
+            memset(&tier->points[tier->head++ % DHT11_HISTORY_LENGTH], 0, sizeof(DHT11HistoryBucket));
+        }
+        
+        memset(open, 0, sizeof(DHT11HistoryAccumulator));
+    }
+    
+    if(open->point.count == 0) {
+        open->bucket = bucket;
+        for(uint8_t m = 0; m < DHT11HistoryMetricCount; m++) {
+            open->point.range[m].min = point->range[m].min;
+            open->point.range[m].max = point->range[m].max;
+        }
+    }
+    
+    for(uint8_t m = 0; m < DHT11HistoryMetricCount; m++) {
+        open->point.range[m].min = MIN(open->point.range[m].min, point->range[m].min);
+        open->point.range[m].max = MAX(open->point.range[m].max, point->range[m].max);
+        open->sum[m] += (int32_t)point->range[m].mean * point->count;
+    }
+    open->point.count += point->count;
+}
+
+void dht11_history_add(DHT11History* history, const DHT11Sample* sample) {
+    furi_assert(history);
+    
+    if(!sample->ok || sample->sensor >= history->sensor_count) {
+        return;
+    }
+    
+    DHT11HistoryBucket point = {0};
+    int16_t values[DHT11HistoryMetricCount] = {
+        [DHT11HistoryMetricTemperature] = sample->temperature,
+        [DHT11HistoryMetricHumidity] = sample->humidity,
+    };
+    for(uint8_t m = 0; m < DHT11HistoryMetricCount; m++) {
+        point.range[m].min = values[m];
+        point.range[m].max = values[m];
+        point.range[m].mean = values[m];
+    }
+    point.count = 1;
+    
+    furi_check(furi_mutex_acquire(history->mutex, FuriWaitForever) == FuriStatusOk);
+    
+    DHT11HistorySensor* sensor = &history->sensors[sample->sensor];
+    
+    // Minutes are counted on from tick differences, so the tick wrapping
+    // after 49 days neither restarts the numbering nor wipes the buckets
+    if(sensor->raw_head == 0) {
+        sensor->minute = sample->tick / history->minute_ticks;
+        sensor->minute_start = sample->tick - sample->tick % history->minute_ticks;
+    } else if((int32_t)(sample->tick - sensor->minute_start) > 0) {
+        uint32_t minutes = (sample->tick - sensor->minute_start) / history->minute_ticks;
+        sensor->minute += minutes;
+        sensor->minute_start += minutes * history->minute_ticks;
+    }
+    
+    DHT11HistoryRaw* raw = &sensor->raw[sensor->raw_head++ % DHT11_HISTORY_RAW_LENGTH];
+    memcpy(raw->value, values, sizeof(raw->value));
+    
+    dht11_history_accumulate(sensor, 0, sensor->minute, &point);
+    
+    furi_mutex_release(history->mutex);
+}
+
+void dht11_history_lock(DHT11History* history) {
+    furi_assert(history);
+    furi_check(furi_mutex_acquire(history->mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+void dht11_history_unlock(DHT11History* history) {
+    furi_assert(history);
+    furi_mutex_release(history->mutex);
+}
+
+uint16_t dht11_history_capacity(DHT11HistoryTier tier) {
+    return tier == DHT11HistoryTierRaw ? DHT11_HISTORY_RAW_LENGTH : DHT11_HISTORY_LENGTH;
+}
+
+uint16_t dht11_history_count(DHT11History* history, uint8_t sensor, DHT11HistoryTier tier) {
+    furi_assert(history);
+    
+    if(sensor >= history->sensor_count) {
+        return 0;
+    }
+    
+    const DHT11HistorySensor* entry = &history->sensors[sensor];
+    if(tier == DHT11HistoryTierRaw) {
+        return MIN(entry->raw_head, (uint32_t)DHT11_HISTORY_RAW_LENGTH);
+    }
+    
+    // The open bucket is shown as the newest point
+    const DHT11HistoryTierBuffer* buffer = &entry->tiers[tier - 1];
+    uint32_t total = buffer->head + (buffer->open.point.count > 0 ? 1 : 0);
+    return MIN(total, (uint32_t)DHT11_HISTORY_LENGTH);
+}
+
+bool dht11_history_get(
+    DHT11History* history,
+    uint8_t sensor,
+    DHT11HistoryTier tier,
+    DHT11HistoryMetric metric,
+    uint16_t index,
+    DHT11HistoryRange* range) {
+    furi_assert(history);
+    
+    uint16_t count = dht11_history_count(history, sensor, tier);
+    if(index >= count) {
+        return false;
+    }
+    
+    const DHT11HistorySensor* entry = &history->sensors[sensor];
+    if(tier == DHT11HistoryTierRaw) {
+        uint32_t position = entry->raw_head - count + index;
+        int16_t value = entry->raw[position % DHT11_HISTORY_RAW_LENGTH].value[metric];
+        range->min = value;
+        range->max = value;
+        range->mean = value;
+        return true;
+    }
+    
+    const DHT11HistoryTierBuffer* buffer = &entry->tiers[tier - 1];
+    bool has_open = buffer->open.point.count > 0;
+    uint32_t position = buffer->head + (has_open ? 1 : 0) - count + index;
+    
+    if(has_open && position == buffer->head) {
+        const DHT11HistoryAccumulator* open = &buffer->open;
+        range->min = open->point.range[metric].min;
+        range->max = open->point.range[metric].max;
+        range->mean = open->sum[metric] / (int32_t)open->point.count;
+        return true;
+    }
+    
+    const DHT11HistoryBucket* point = &buffer->points[position % DHT11_HISTORY_LENGTH];
+    if(point->count == 0) {
+        return false;
+    }
+    *range = point->range[metric];
+    return true;
+}
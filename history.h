@@ -0,0 +1,135 @@
+/**
+ * @file history.h
+ * @brief Fixed-memory multi-resolution sample history
+ * 
+ * Every sensor keeps three ring buffers: the raw readings of the last few
+ * minutes, per-minute and per-hour min/max/mean. Each reading is added to
+ * the raw ring and to the open minute bucket; a closed minute bucket is
+ * in turn added to the open hour bucket. Nothing is ever rescanned and
+ * the memory used is fixed at allocation, however long the app runs.
+ * 
+ * Written by the acquisition thread, read from the GUI thread under the
+ * history lock.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include "sample_buffer.h"
+
+/** @brief Raw readings kept per sensor, about three minutes at 1Hz */
+#define DHT11_HISTORY_RAW_LENGTH 200
+
+/** @brief Minute and hour buckets kept per sensor */
+#define DHT11_HISTORY_LENGTH 100
+
+/**
+ * @brief History resolutions
+ */
+typedef enum {
+    DHT11HistoryTierRaw,        /**< Individual readings */
+    DHT11HistoryTierMinute,     /**< One bucket per minute */
+    DHT11HistoryTierHour,       /**< One bucket per hour */
+    DHT11HistoryTierCount,      /**< Number of tiers */
+} DHT11HistoryTier;
+
+/**
+ * @brief Recorded quantities
+ */
+typedef enum {
+    DHT11HistoryMetricTemperature,  /**< Temperature in tenths of a degree Celsius */
+    DHT11HistoryMetricHumidity,     /**< Relative humidity in tenths of a percent */
+    DHT11HistoryMetricCount,        /**< Number of metrics */
+} DHT11HistoryMetric;
+
+/**
+ * @brief Spread of one metric over a bucket, in tenths
+ */
+typedef struct {
+    int16_t min;    /**< Lowest value */
+    int16_t max;    /**< Highest value */
+    int16_t mean;   /**< Average value */
+} DHT11HistoryRange;
+
+/** @brief History store instance */
+typedef struct DHT11History DHT11History;
+
+/**
+ * @brief Allocate the history of a number of sensors
+ * 
+ * @param sensor_count Number of sensors to keep history for
+ * @return Pointer to the allocated history
+ */
+DHT11History* dht11_history_alloc(uint8_t sensor_count);
+
+/**
+ * @brief Free the history
+ * 
+ * @param history Pointer to the history
+ */
+void dht11_history_free(DHT11History* history);
+
+/**
+ * @brief Add a sample; failed reads are ignored
+ * 
+ * @param history Pointer to the history
+ * @param sample Published sample
+ */
+void dht11_history_add(DHT11History* history, const DHT11Sample* sample);
+
+/**
+ * @brief Take the history lock for a series of reads
+ * 
+ * @param history Pointer to the history
+ */
+void dht11_history_lock(DHT11History* history);
+
+/**
+ * @brief Release the history lock
+ * 
+ * @param history Pointer to the history
+ */
+void dht11_history_unlock(DHT11History* history);
+
+/**
+ * @brief Capacity of a tier
+ * 
+ * @param tier History tier
+ * @return Maximum number of points in the tier
+ */
+uint16_t dht11_history_capacity(DHT11HistoryTier tier);
+
+/**
+ * @brief Number of points in a tier, including the bucket still being filled
+ * 
+ * Call with the lock held.
+ * 
+ * @param history Pointer to the history
+ * @param sensor Index of the sensor
+ * @param tier History tier
+ * @return Number of points, at most dht11_history_capacity()
+ */
+uint16_t dht11_history_count(DHT11History* history, uint8_t sensor, DHT11HistoryTier tier);
+
+/**
+ * @brief Read one point of a tier
+ * 
+ * Minutes and hours without a successful read are kept as gaps so that
+ * the position of a point always reflects its time. Call with the lock
+ * held.
+ * 
+ * @param history Pointer to the history
+ * @param sensor Index of the sensor
+ * @param tier History tier
+ * @param metric Quantity to read
+ * @param index Point index, 0 is the oldest
+ * @param range Output for the value of the point
+ * @return false if the point is a gap
+ */
+bool dht11_history_get(
+    DHT11History* history,
+    uint8_t sensor,
+    DHT11HistoryTier tier,
+    DHT11HistoryMetric metric,
+    uint16_t index,
+    DHT11HistoryRange* range);
@@ -0,0 +1,455 @@
+/**
+ * @file logger.c
+ * @brief Buffered SD card sample logger implementation
+ */
+
+#include "logger.h"
+#include "format.h"
+#include <furi_hal.h>
+
+#define DHT11_LOGGER_STACK_SIZE 2048
+
+/** @brief Longest encoded CSV line */
+#define DHT11_LOGGER_LINE_SIZE 48
+
+/** @brief CSV column names, written at the start of a new file */
+#define DHT11_LOGGER_CSV_HEADER "timestamp,tick,sensor,ok,temperature,humidity\n"
+
+/** @brief Worker thread flags */
+typedef enum {
+    DHT11LoggerFlagStop = (1 << 0),     /**< Flush everything and exit */
+    DHT11LoggerFlagPause = (1 << 1),    /**< Flush whole blocks only and exit */
+} DHT11LoggerFlag;
+
+#define DHT11_LOGGER_FLAGS_ALL (DHT11LoggerFlagStop | DHT11LoggerFlagPause)
+
+/**
+ * @brief Write out the buffered data that ends on a block boundary
+ * 
+ * Writes the bytes needed to bring the file to the next block boundary
+ * followed by as many whole blocks as are buffered. With force set, the
+ * whole buffer is written regardless of alignment.
+ * 
+ * @param logger Pointer to the logger
+ * @param force Write the unaligned tail as well
+ */
+static void dht11_logger_flush(DHT11Logger* logger, bool force) {
+    size_t head = (DHT11_LOGGER_BLOCK_SIZE - logger->offset % DHT11_LOGGER_BLOCK_SIZE) %
+                  DHT11_LOGGER_BLOCK_SIZE;
+    size_t length = 0;
+    
+    if(force) {
+        length = logger->fill;
+    } else if(logger->fill >= head) {
+        length = head + ((logger->fill - head) / DHT11_LOGGER_BLOCK_SIZE) * DHT11_LOGGER_BLOCK_SIZE;
+    }
+    
+    if(length == 0) {
+        return;
+    }
+    
+    size_t written = storage_file_write(logger->file, logger->buffer, length);
+    if(written != length) {
+        logger->write_errors++;
+    }
+    
+    // Keep whatever did not make it to the card at the front of the buffer
+    logger->offset += written;
+    logger->fill -= written;
+    memmove(logger->buffer, logger->buffer + written, logger->fill);
+    
+    if(written > 0) {
+        storage_file_sync(logger->file);
+    }
+}
+
+/**
+ * @brief Append raw bytes to the buffer, flushing to make room
+ * 
+ * @param logger Pointer to the logger
+ * @param data Bytes to append
+ * @param length Number of bytes
+ * @return true if the bytes were buffered
+ */
+static bool dht11_logger_append(DHT11Logger* logger, const void* data, size_t length) {
+    if(logger->fill + length > sizeof(logger->buffer)) {
+        dht11_logger_flush(logger, false);
+    }
+    if(logger->fill + length > sizeof(logger->buffer)) {
+        return false;
+    }
+    
+    memcpy(logger->buffer + logger->fill, data, length);
+    logger->fill += length;
+    return true;
+}
+
+/**
+ * @brief Buffer the archive block being filled and index it
+ * 
+ * The index entry goes straight to its file; it is a few bytes per block,
+ * and dht11_archive_repair() drops entries whose block never made it to
+ * the card.
+ * 
+ * @param logger Pointer to the logger
+ */
+static void dht11_logger_close_block(DHT11Logger* logger) {
+    if(logger->archive->count == 0) {
+        return;
+    }
+    
+    DHT11ArchiveIndexEntry entry;
+    dht11_archive_encoder_finish(logger->archive, &entry);
+    if(!dht11_logger_append(logger, logger->archive->block, DHT11_ARCHIVE_BLOCK_SIZE) ||
+       storage_file_write(logger->index, &entry, sizeof(entry)) != sizeof(entry)) {
+        logger->write_errors++;
+    }
+    dht11_archive_encoder_reset(logger->archive);
+}
+
+/**
+ * @brief Encode one sample in the logger's format and buffer it
+ * 
+ * @param logger Pointer to the logger
+ * @param sample Sample to encode
+ * @param timestamp RTC time of the sample
+ */
+static void dht11_logger_encode(DHT11Logger* logger, const DHT11Sample* sample, uint32_t timestamp) {
+    if(logger->format == DHT11LoggerFormatBinary) {
+        DHT11LoggerRecord record = {0};
+        record.timestamp = timestamp;
+        record.tick = sample->tick;
+        record.sensor = sample->sensor;
+        record.ok = sample->ok;
+        if(sample->ok) {
+            record.temperature = sample->temperature;
+            record.humidity = sample->humidity;
+        }
+        dht11_logger_append(logger, &record, sizeof(record));
+    } else if(logger->format == DHT11LoggerFormatArchive) {
+        DHT11ArchiveSample record = {
+            .timestamp = timestamp,
+            .sensor = sample->sensor,
+            .ok = sample->ok,
+            .temperature = sample->ok ? sample->temperature : 0,
+            .humidity = sample->ok ? sample->humidity : 0,
+        };
+        if(!dht11_archive_encoder_add(logger->archive, &record)) {
+            dht11_logger_close_block(logger);
+            dht11_archive_encoder_add(logger->archive, &record);
+        }
+    } else {
+        // Integer formatting only, no printf on the logging path; the
+        // line fits the longest record, so nothing is ever cut short
+        char line[DHT11_LOGGER_LINE_SIZE];
+        size_t length = dht11_format_uint(line, sizeof(line), timestamp);
+        line[length++] = ',';
+        length += dht11_format_uint(line + length, sizeof(line) - length, sample->tick);
+        line[length++] = ',';
+        length += dht11_format_uint(line + length, sizeof(line) - length, sample->sensor);
+        if(sample->ok) {
+            memcpy(line + length, ",1,", 3);
+            length += 3;
+            length += dht11_format_fixed(line + length, sizeof(line) - length, sample->temperature, 1);
+            line[length++] = ',';
+            length += dht11_format_fixed(line + length, sizeof(line) - length, sample->humidity, 1);
+            line[length++] = '\n';
+        } else {
+            memcpy(line + length, ",0,,\n", 5);
+            length += 5;
+        }
+        dht11_logger_append(logger, line, length);
+    }
+    
+    logger->logged++;
+}
+
+/**
+ * @brief Encode every sample published since the last poll
+ * 
+ * @param logger Pointer to the logger
+ */
+static void dht11_logger_drain(DHT11Logger* logger) {
+    DHT11Sample sample;
+    uint32_t now_tick = furi_get_tick();
+    uint32_t now_timestamp = furi_hal_rtc_get_timestamp();
+    uint32_t expected = logger->cursor;
+    
+    while(dht11_sample_buffer_read(logger->samples, &logger->cursor, &sample)) {
+        // Samples overwritten before we got to them show up as a sequence gap
+        if(sample.sequence != expected) {
+            logger->lost += sample.sequence - expected;
+        }
+        expected = sample.sequence + 1;
+        
+        uint32_t age = (now_tick - sample.tick) / furi_kernel_get_tick_frequency();
+        dht11_logger_encode(logger, &sample, now_timestamp - age);
+    }
+}
+
+/**
+ * @brief Logger thread
+ * 
+ * @param context Pointer to the logger
+ * @return Thread exit code
+ */
+static int32_t dht11_logger_worker(void* context) {
+    DHT11Logger* logger = context;
+    uint32_t last_flush = furi_get_tick();
+    
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            DHT11_LOGGER_FLAGS_ALL, FuriFlagWaitAny, furi_ms_to_ticks(logger->poll_ms));
+        
+        dht11_logger_drain(logger);
+        
+        if(!(flags & FuriFlagError) && (flags & DHT11LoggerFlagStop)) {
+            if(logger->archive) {
+                dht11_logger_close_block(logger);
+            }
+            dht11_logger_flush(logger, true);
+            break;
+        }
+        
+        // The unaligned tail and the archive block stay in RAM until resumed
+        if(!(flags & FuriFlagError) && (flags & DHT11LoggerFlagPause)) {
+            dht11_logger_flush(logger, false);
+            break;
+        }
+        
+        if(furi_get_tick() - last_flush >= furi_ms_to_ticks(logger->flush_interval_ms)) {
+            dht11_logger_flush(logger, false);
+            last_flush = furi_get_tick();
+        }
+    }
+    
+    return 0;
+}
+
+DHT11Logger* dht11_logger_alloc(const DHT11SampleBuffer* samples) {
+    DHT11Logger* logger = malloc(sizeof(DHT11Logger));
+    logger->samples = samples;
+    logger->flush_interval_ms = DHT11_LOGGER_FLUSH_INTERVAL_MS;
+    logger->poll_ms = DHT11_LOGGER_POLL_MS;
+    logger->storage = furi_record_open(RECORD_STORAGE);
+    logger->file = NULL;
+    logger->index = NULL;
+    logger->archive = NULL;
+    logger->paused = false;
+    logger->path = furi_string_alloc();
+    
+    logger->thread =
+        furi_thread_alloc_ex("Dht11Logger", DHT11_LOGGER_STACK_SIZE, dht11_logger_worker, logger);
+    
+    return logger;
+}
+
+void dht11_logger_free(DHT11Logger* logger) {
+    furi_assert(logger);
+    dht11_logger_stop(logger);
+    furi_thread_free(logger->thread);
+    furi_string_free(logger->path);
+    furi_record_close(RECORD_STORAGE);
+    free(logger);
+}
+
+void dht11_logger_set_flush_interval(DHT11Logger* logger, uint32_t interval_ms) {
+    furi_assert(logger);
+    logger->flush_interval_ms = interval_ms;
+}
+
+void dht11_logger_set_poll_interval(DHT11Logger* logger, uint32_t interval_ms) {
+    furi_assert(logger);
+    logger->poll_ms = interval_ms;
+}
+
+/**
+ * @brief Open the log file, and the index of an archive, for appending
+ * 
+ * Writes the format's header if the file is new. When resuming, the
+ * buffer and archive block kept by dht11_logger_pause() carry on instead;
+ * the files were left consistent, so the archive is not repaired again.
+ * The worker thread is left for the caller to start.
+ * 
+ * @param logger Pointer to the logger
+ * @param path Log file path
+ * @param format Encoding to use
+ * @param resume Continue the paused log
+ * @return true if the files were opened
+ */
+static bool dht11_logger_open(DHT11Logger* logger, const char* path, DHT11LoggerFormat format, bool resume) {
+    if(format == DHT11LoggerFormatArchive && !resume) {
+        dht11_archive_repair(logger->storage, path);
+    }
+    
+    logger->file = storage_file_alloc(logger->storage);
+    if(!storage_file_open(logger->file, path, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        FURI_LOG_E("DHT11", "Failed to open log %s", path);
+        storage_file_free(logger->file);
+        logger->file = NULL;
+        return false;
+    }
+    
+    if(format == DHT11LoggerFormatArchive) {
+        FuriString* index_path = furi_string_alloc();
+        dht11_archive_index_path(path, index_path);
+        logger->index = storage_file_alloc(logger->storage);
+        bool opened = storage_file_open(logger->index, furi_string_get_cstr(index_path), FSAM_WRITE, FSOM_OPEN_APPEND);
+        furi_string_free(index_path);
+        
+        if(!opened) {
+            FURI_LOG_E("DHT11", "Failed to open the index of %s", path);
+            storage_file_free(logger->index);
+            logger->index = NULL;
+            storage_file_close(logger->file);
+            storage_file_free(logger->file);
+            logger->file = NULL;
+            return false;
+        }
+        
+        if(!resume) {
+            logger->archive = malloc(sizeof(DHT11ArchiveEncoder));
+            dht11_archive_encoder_reset(logger->archive);
+        }
+    }
+    
+    furi_string_set_str(logger->path, path);
+    logger->format = format;
+    logger->offset = storage_file_size(logger->file);
+    logger->paused = false;
+    if(resume) {
+        return true;
+    }
+    logger->fill = 0;
+    
+    // The header goes through the buffer so it is part of the first block
+    if(logger->offset == 0) {
+        if(format == DHT11LoggerFormatArchive) {
+            // The header takes a whole block so that data blocks stay aligned
+            DHT11ArchiveHeader header = {0};
+            memcpy(header.magic, DHT11_ARCHIVE_MAGIC, sizeof(header.magic));
+            header.version = DHT11_ARCHIVE_VERSION;
+            header.block_size = DHT11_ARCHIVE_BLOCK_SIZE;
+            header.start_timestamp = furi_hal_rtc_get_timestamp();
+            memcpy(logger->archive->block, &header, sizeof(header));
+            dht11_logger_append(logger, logger->archive->block, DHT11_ARCHIVE_BLOCK_SIZE);
+            dht11_archive_encoder_reset(logger->archive);
+        } else if(format == DHT11LoggerFormatBinary) {
+            DHT11LoggerHeader header = {0};
+            memcpy(header.magic, DHT11_LOGGER_MAGIC, sizeof(header.magic));
+            header.version = DHT11_LOGGER_VERSION;
+            header.record_size = sizeof(DHT11LoggerRecord);
+            header.tick_hz = furi_kernel_get_tick_frequency();
+            header.start_timestamp = furi_hal_rtc_get_timestamp();
+            dht11_logger_append(logger, &header, sizeof(header));
+        } else {
+            dht11_logger_append(logger, DHT11_LOGGER_CSV_HEADER, strlen(DHT11_LOGGER_CSV_HEADER));
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Stop the worker, write out the buffered data and close the files
+ * 
+ * @param logger Pointer to the logger, with a file open
+ * @param pause Write whole blocks only and keep the rest for dht11_logger_open()
+ */
+static void dht11_logger_close(DHT11Logger* logger, bool pause) {
+    furi_thread_flags_set(
+        furi_thread_get_id(logger->thread), pause ? DHT11LoggerFlagPause : DHT11LoggerFlagStop);
+    furi_thread_join(logger->thread);
+    
+    if(logger->index) {
+        storage_file_close(logger->index);
+        storage_file_free(logger->index);
+        logger->index = NULL;
+    }
+    if(!pause) {
+        free(logger->archive);
+        logger->archive = NULL;
+    }
+    logger->paused = pause;
+    
+    storage_file_close(logger->file);
+    storage_file_free(logger->file);
+    logger->file = NULL;
+}
+
+bool dht11_logger_start(DHT11Logger* logger, const char* path, DHT11LoggerFormat format) {
+    furi_assert(logger);
+    
+    if(logger->file) {
+        return true;
+    }
+    
+    // A paused log is finished before another one is started
+    dht11_logger_stop(logger);
+    
+    if(!dht11_logger_open(logger, path, format, false)) {
+        return false;
+    }
+    
+    logger->logged = 0;
+    logger->lost = 0;
+    logger->write_errors = 0;
+    
+    // Only log samples taken from now on
+    logger->cursor = logger->samples->head;
+    
+    furi_thread_start(logger->thread);
+    return true;
+}
+
+void dht11_logger_stop(DHT11Logger* logger) {
+    furi_assert(logger);
+    
+    // What a paused log kept in RAM is written out through a last resume
+    if(logger->paused && !dht11_logger_resume(logger)) {
+        free(logger->archive);
+        logger->archive = NULL;
+        logger->paused = false;
+    }
+    
+    if(!logger->file) {
+        return;
+    }
+    
+    dht11_logger_close(logger, false);
+}
+
+bool dht11_logger_pause(DHT11Logger* logger) {
+    furi_assert(logger);
+    
+    if(!logger->file) {
+        return false;
+    }
+    
+    dht11_logger_close(logger, true);
+    return true;
+}
+
+bool dht11_logger_resume(DHT11Logger* logger) {
+    furi_assert(logger);
+    
+    if(logger->file) {
+        return true;
+    }
+    if(!logger->paused) {
+        return false;
+    }
+    
+    // The cursor and counters carry on from where the logger paused
+    if(!dht11_logger_open(logger, furi_string_get_cstr(logger->path), logger->format, true)) {
+        return false;
+    }
+    
+    furi_thread_start(logger->thread);
+    return true;
+}
+
+bool dht11_logger_is_running(const DHT11Logger* logger) {
+    furi_assert(logger);
+    return logger->file != NULL;
+}
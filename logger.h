@@ -0,0 +1,203 @@
+/**
+ * @file logger.h
+ * @brief Buffered SD card sample logger
+ * 
+ * Drains the acquisition sample buffer from its own thread, encodes each
+ * sample as a CSV line, a compact binary record or into a delta-compressed
+ * archive block, and collects them in RAM. The buffer is written to the
+ * card in whole 512-byte blocks aligned to the file offset, once per flush
+ * interval or whenever it fills up, so the card sees few large
+ * sector-aligned writes instead of one small write per sample. The partial
+ * block at the tail is written when logging stops, but not when it pauses.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include "sample_buffer.h"
+#include "archive.h"
+
+/** @brief Default CSV log file location */
+#define DHT11_LOGGER_CSV_PATH APP_DATA_PATH("log.csv")
+
+/** @brief Default binary log file location */
+#define DHT11_LOGGER_BINARY_PATH APP_DATA_PATH("log.bin")
+
+/** @brief Default archive log file location, indexed in the same name with DHT11_ARCHIVE_INDEX_SUFFIX */
+#define DHT11_LOGGER_ARCHIVE_PATH APP_DATA_PATH("log.arc")
+
+/** @brief Format used when logging is switched on from the menu */
+#define DHT11_LOGGER_DEFAULT_FORMAT DHT11LoggerFormatCsv
+
+/** @brief File matching DHT11_LOGGER_DEFAULT_FORMAT */
+#define DHT11_LOGGER_DEFAULT_PATH DHT11_LOGGER_CSV_PATH
+
+/** @brief Card write granularity; flushes are aligned to this */
+#define DHT11_LOGGER_BLOCK_SIZE 512
+
+/** @brief RAM buffer size, a multiple of the block size */
+#define DHT11_LOGGER_BUFFER_SIZE (4 * DHT11_LOGGER_BLOCK_SIZE)
+
+/** @brief Default interval between flushes */
+#define DHT11_LOGGER_FLUSH_INTERVAL_MS 60000
+
+/** @brief Default interval at which the logger drains the sample buffer */
+#define DHT11_LOGGER_POLL_MS 500
+
+/** @brief Binary file format magic */
+#define DHT11_LOGGER_MAGIC "DHTL"
+
+/** @brief Binary file format version */
+#define DHT11_LOGGER_VERSION 1
+
+/**
+ * @brief Log file encodings
+ */
+typedef enum {
+    DHT11LoggerFormatCsv,       /**< One text line per sample */
+    DHT11LoggerFormatBinary,    /**< Fixed-size DHT11LoggerRecord per sample */
+    DHT11LoggerFormatArchive,   /**< Delta-compressed blocks with a time index, see archive.h */
+} DHT11LoggerFormat;
+
+/**
+ * @brief Binary log header, written once at the start of the file
+ */
+typedef struct FURI_PACKED {
+    char magic[4];                  /**< DHT11_LOGGER_MAGIC */
+    uint8_t version;                /**< DHT11_LOGGER_VERSION */
+    uint8_t record_size;            /**< Size of one record in bytes */
+    uint16_t reserved;              /**< Zero */
+    uint32_t tick_hz;               /**< System tick frequency */
+    uint32_t start_timestamp;       /**< RTC time when the file was created */
+} DHT11LoggerHeader;
+
+/**
+ * @brief One logged sample in the binary format
+ */
+typedef struct FURI_PACKED {
+    uint32_t timestamp;             /**< RTC time of the reading, Unix seconds */
+    uint32_t tick;                  /**< System tick of the reading */
+    uint8_t sensor;                 /**< Sensor index */
+    uint8_t ok;                     /**< Non-zero if the read succeeded */
+    int16_t temperature;            /**< Temperature in tenths of a degree Celsius */
+    uint16_t humidity;              /**< Relative humidity in tenths of a percent */
+} DHT11LoggerRecord;
+
+/**
+ * @brief Logger state
+ */
+typedef struct {
+    FuriThread* thread;                     /**< Worker thread */
+    const DHT11SampleBuffer* samples;       /**< Source of samples */
+    uint32_t cursor;                        /**< Read position in the sample buffer */
+    DHT11LoggerFormat format;               /**< Encoding of the open file */
+    volatile uint32_t flush_interval_ms;    /**< Time between flushes */
+    volatile uint32_t poll_ms;              /**< Time between drains of the sample buffer */
+    Storage* storage;                       /**< Storage record */
+    File* file;                             /**< Open log file, or NULL when stopped */
+    File* index;                            /**< Open archive index file, NULL for other formats */
+    DHT11ArchiveEncoder* archive;           /**< Archive block being filled, NULL for other formats */
+    FuriString* path;                       /**< Path of the log file, kept for dht11_logger_resume() */
+    bool paused;                            /**< Closed by dht11_logger_pause(), with its buffer kept */
+    uint64_t offset;                        /**< File size including flushed data */
+    uint8_t buffer[DHT11_LOGGER_BUFFER_SIZE];   /**< Encoded samples not yet written */
+    size_t fill;                            /**< Bytes used in buffer */
+    volatile uint32_t logged;               /**< Samples encoded since start */
+    volatile uint32_t lost;                 /**< Samples overwritten before they were read */
+    volatile uint32_t write_errors;         /**< Failed or short writes */
+} DHT11Logger;
+
+/**
+ * @brief Allocate a logger reading from a sample buffer
+ * 
+ * @param samples Sample buffer to drain, usually the acquisition's
+ * @return Pointer to the allocated logger
+ */
+DHT11Logger* dht11_logger_alloc(const DHT11SampleBuffer* samples);
+
+/**
+ * @brief Free the logger, stopping it first if needed
+ * 
+ * @param logger Pointer to the logger
+ */
+void dht11_logger_free(DHT11Logger* logger);
+
+/**
+ * @brief Set the interval between flushes
+ * 
+ * May be called while logging. The buffer is also flushed early whenever
+ * it fills up.
+ * 
+ * @param logger Pointer to the logger
+ * @param interval_ms Flush interval in milliseconds
+ */
+void dht11_logger_set_flush_interval(DHT11Logger* logger, uint32_t interval_ms);
+
+/**
+ * @brief Set the interval at which samples are taken from the sample buffer
+ * 
+ * Longer intervals mean fewer wake-ups. The interval must stay short
+ * enough that the sample buffer does not wrap in between, or samples are
+ * lost. Takes effect after the current wait.
+ * 
+ * @param logger Pointer to the logger
+ * @param interval_ms Poll interval in milliseconds
+ */
+void dht11_logger_set_poll_interval(DHT11Logger* logger, uint32_t interval_ms);
+
+/**
+ * @brief Open the log file and start logging new samples
+ * 
+ * The file is appended to if it exists; a CSV header line or binary
+ * header is written when it is new. An archive and its index are first
+ * brought back in line with dht11_archive_repair().
+ * 
+ * @param logger Pointer to the logger
+ * @param path Log file path
+ * @param format Encoding to use
+ * @return true if the file was opened and logging started
+ */
+bool dht11_logger_start(DHT11Logger* logger, const char* path, DHT11LoggerFormat format);
+
+/**
+ * @brief Stop logging, write out everything buffered and close the file
+ * 
+ * @param logger Pointer to the logger
+ */
+void dht11_logger_stop(DHT11Logger* logger);
+
+/**
+ * @brief Close the log file for a moment so that it can be read
+ * 
+ * Writes out the whole blocks buffered. The unaligned tail and the
+ * archive block being filled stay in RAM, so pausing neither pads a block
+ * early nor leaves a torn one; a reader can take that block from
+ * logger->archive with dht11_archive_reader_set_tail(). Samples published
+ * in the meantime stay in the sample buffer and are logged by
+ * dht11_logger_resume(), as long as it wraps no further. Stopping a paused
+ * logger writes out what it kept.
+ * 
+ * @param logger Pointer to the logger
+ * @return true if the logger was running and must be resumed
+ */
+bool dht11_logger_pause(DHT11Logger* logger);
+
+/**
+ * @brief Reopen the file closed by dht11_logger_pause() and carry on
+ * 
+ * Appends after the blocks written when pausing, with the kept buffer
+ * and archive block; the archive is not repaired again.
+ * 
+ * @param logger Pointer to the logger
+ * @return true if logging resumed
+ */
+bool dht11_logger_resume(DHT11Logger* logger);
+
+/**
+ * @brief Check whether the logger is running
+ * 
+ * @param logger Pointer to the logger
+ * @return true if a log file is open
+ */
+bool dht11_logger_is_running(const DHT11Logger* logger);
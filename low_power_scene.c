@@ -0,0 +1,123 @@
+/**
+ * @file low_power_scene.c
+ * @brief Low-power logging scene implementation
+ * 
+ * While the scene is shown the app samples once per minute into the SD
+ * logger and otherwise sleeps: the backlight is off, the read LED stays
+ * dark, the sensors are only powered around each transaction if their
+ * supply can be switched, and new samples no longer wake the GUI thread.
+ * The logger drains the sample buffer once per period instead of twice a
+ * second. A key press refreshes the status page; Back restores
+ * everything.
+ */
+
+#include "low_power_scene.h"
+#include "sensor.h"
+#include "scenes.h"
+#include "scene_views.h"
+
+/**
+ * @brief Input callback for the wake keys
+ * 
+ * @param event Custom event for the pressed key
+ * @param context Application context
+ */
+static void dht11_low_power_view_callback(uint32_t event, void* context) {
+    DHT11App* app = context;
+    scene_manager_handle_custom_event(app->scene_manager, event);
+}
+
+/**
+ * @brief Refresh the status page
+ * 
+ * @param app Application context
+ */
+static void dht11_low_power_scene_update(DHT11App* app) {
+    DHT11LowPowerStatus status = {0};
+    
+    status.period_s = app->acquisition->period_ms / 1000;
+    status.elapsed_s = (furi_get_tick() - app->low_power.start_tick) / furi_kernel_get_tick_frequency();
+    status.switched = app->low_power.switched;
+    status.logging = dht11_logger_is_running(app->logger);
+    status.logged = app->logger->logged;
+    status.lost = app->logger->lost;
+    status.imperial = app->settings.imperial;
+    if(app->sensor_count > 0) {
+        snprintf(status.name, sizeof(status.name), "%s", app->sensors[app->selected_sensor].name);
+        status.have_sample = dht11_acquisition_latest(app->acquisition, app->selected_sensor, &status.sample);
+    }
+    
+    dht11_low_power_view_set_status(app->low_power_view, &status);
+}
+
+void dht11_scene_low_power_on_enter(void* context) {
+    DHT11App* app = context;
+    DHT11LowPowerState* state = &app->low_power;
+    
+    dht11_scene_view_acquire(app, DHT11SceneLowPower);
+    state->period_ms = app->acquisition->period_ms;
+    state->callback = app->acquisition->callback;
+    state->callback_context = app->acquisition->callback_context;
+    state->start_tick = furi_get_tick();
+    
+    // Samples no longer wake the GUI; the page is refreshed on a key press only
+    dht11_acquisition_set_callback(app->acquisition, NULL, NULL);
+    
+    state->switched = dht11_sensor_set_low_power(app, true);
+    dht11_acquisition_set_period(app->acquisition, DHT11_LOW_POWER_PERIOD_MS);
+    
+    state->started_logger = !dht11_logger_is_running(app->logger) &&
+                            dht11_logger_start(app->logger, DHT11_LOGGER_DEFAULT_PATH, DHT11_LOGGER_DEFAULT_FORMAT);
+    if(!dht11_logger_is_running(app->logger)) {
+        notification_message(app->notifications, &sequence_error);
+    }
+    
+    // One wake-up per sample and few card writes
+    dht11_logger_set_poll_interval(app->logger, DHT11_LOW_POWER_PERIOD_MS);
+    dht11_logger_set_flush_interval(app->logger, DHT11_LOW_POWER_FLUSH_INTERVAL_MS);
+    
+    dht11_low_power_view_set_callback(app->low_power_view, dht11_low_power_view_callback, app);
+    dht11_low_power_scene_update(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneLowPower);
+    
+    notification_message(app->notifications, &sequence_display_backlight_off);
+}
+
+bool dht11_scene_low_power_on_event(void* context, SceneManagerEvent event) {
+    DHT11App* app = context;
+    bool consumed = false;
+    
+    if(event.type == SceneManagerEventTypeCustom && event.event == DHT11CustomEventWake) {
+        // The key press itself turns the backlight on for the usual timeout
+        dht11_low_power_scene_update(app);
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+    
+    return consumed;
+}
+
+void dht11_scene_low_power_on_exit(void* context) {
+    DHT11App* app = context;
+    DHT11LowPowerState* state = &app->low_power;
+    
+    dht11_low_power_view_set_callback(app->low_power_view, NULL, NULL);
+    
+    dht11_logger_set_poll_interval(app->logger, DHT11_LOGGER_POLL_MS);
+    dht11_logger_set_flush_interval(app->logger, DHT11_LOGGER_FLUSH_INTERVAL_MS);
+    if(state->started_logger) {
+        dht11_logger_stop(app->logger);
+    }
+    
+    dht11_sensor_set_low_power(app, false);
+    dht11_acquisition_set_period(app->acquisition, state->period_ms);
+    dht11_acquisition_set_callback(app->acquisition, state->callback, state->callback_context);
+    
+    // Do not wait out the long period before the next sample
+    dht11_acquisition_trigger(app->acquisition);
+    
+    notification_message(app->notifications, &sequence_display_backlight_on);
+    dht11_scene_view_release(app, DHT11SceneLowPower);
+}
@@ -0,0 +1,17 @@
+/**
+ * @file low_power_scene.h
+ * @brief Low-power logging scene interface
+ * 
+ * This file contains the interface for the low-power logging scene which
+ * switches the app into long-term battery sampling to the SD card.
+ */
+
+#pragma once
+
+#include "app.h"
+
+/** @brief Sampling period while in low-power mode */
+#define DHT11_LOW_POWER_PERIOD_MS (60 * 1000)
+
+/** @brief Interval between SD card flushes while in low-power mode */
+#define DHT11_LOW_POWER_FLUSH_INTERVAL_MS (15 * 60 * 1000)
@@ -0,0 +1,156 @@
+/**
+ * @file low_power_view.c
+ * @brief Low-power logging status view implementation
+ */
+
+#include "low_power_view.h"
+#include "app.h"
+#include "format.h"
+
+struct DHT11LowPowerView {
+    View* view;                         /**< Underlying view */
+    DHT11LowPowerViewCallback callback; /**< Input callback */
+    void* context;                      /**< Context for the callback */
+};
+
+/**
+ * @brief Draw callback
+ * 
+ * @param canvas Canvas to draw on
+ * @param _model DHT11LowPowerStatus
+ */
+static void dht11_low_power_view_draw(Canvas* canvas, void* _model) {
+    DHT11LowPowerStatus* status = _model;
+    char buffer[40];
+    
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+    
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str_aligned(canvas, 64, 2, AlignCenter, AlignTop, "Low Power Logging");
+    
+    canvas_set_font(canvas, FontSecondary);
+    uint32_t minutes = status->elapsed_s / 60;
+    if(status->period_s % 60 == 0) {
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "Every %lu min, up %luh %02lum",
+            (unsigned long)(status->period_s / 60),
+            (unsigned long)(minutes / 60),
+            (unsigned long)(minutes % 60));
+    } else {
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "Every %lus, up %luh %02lum",
+            (unsigned long)status->period_s,
+            (unsigned long)(minutes / 60),
+            (unsigned long)(minutes % 60));
+    }
+    canvas_draw_str_aligned(canvas, 2, 16, AlignLeft, AlignTop, buffer);
+    
+    canvas_draw_str_aligned(
+        canvas,
+        2,
+        26,
+        AlignLeft,
+        AlignTop,
+        status->switched ? "Sensor power: per read" : "Sensor power: always on");
+    
+    if(status->logging) {
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "Logged %lu, lost %lu",
+            (unsigned long)status->logged,
+            (unsigned long)status->lost);
+    } else {
+        snprintf(buffer, sizeof(buffer), "SD log not running!");
+    }
+    canvas_draw_str_aligned(canvas, 2, 36, AlignLeft, AlignTop, buffer);
+    
+    if(!status->have_sample) {
+        snprintf(buffer, sizeof(buffer), "%s: no sample yet", status->name);
+    } else if(!status->sample.ok) {
+        snprintf(buffer, sizeof(buffer), "%s: read error", status->name);
+    } else {
+        char temperature[DHT11_FORMAT_TEMPERATURE_SIZE];
+        char humidity[DHT11_FORMAT_FIXED_SIZE];
+        dht11_format_temperature(temperature, sizeof(temperature), status->sample.temperature, status->imperial);
+        dht11_format_fixed(humidity, sizeof(humidity), status->sample.humidity, 1);
+        snprintf(buffer, sizeof(buffer), "%s: %s %s%%", status->name, temperature, humidity);
+    }
+    canvas_draw_str_aligned(canvas, 2, 46, AlignLeft, AlignTop, buffer);
+    
+    canvas_draw_str_aligned(canvas, 64, 63, AlignCenter, AlignBottom, "Any key: refresh  Back: stop");
+}
+
+/**
+ * @brief Input callback
+ * 
+ * @param event Input event
+ * @param context DHT11LowPowerView
+ * @return true if the event was consumed
+ */
+static bool dht11_low_power_view_input(InputEvent* event, void* context) {
+    DHT11LowPowerView* low_power_view = context;
+    
+    // Back leaves the mode through the scene manager
+    if(event->key == InputKeyBack || !low_power_view->callback) {
+        return false;
+    }
+    
+    if(event->type == InputTypePress) {
+        low_power_view->callback(DHT11CustomEventWake, low_power_view->context);
+    }
+    return true;
+}
+
+DHT11LowPowerView* dht11_low_power_view_alloc(void) {
+    DHT11LowPowerView* low_power_view = malloc(sizeof(DHT11LowPowerView));
+    low_power_view->callback = NULL;
+    low_power_view->context = NULL;
+    
+    low_power_view->view = view_alloc();
+    view_allocate_model(low_power_view->view, ViewModelTypeLocking, sizeof(DHT11LowPowerStatus));
+    view_set_context(low_power_view->view, low_power_view);
+    view_set_draw_callback(low_power_view->view, dht11_low_power_view_draw);
+    view_set_input_callback(low_power_view->view, dht11_low_power_view_input);
+    
+    with_view_model(
+        low_power_view->view,
+        DHT11LowPowerStatus * model,
+        {
+            memset(model, 0, sizeof(DHT11LowPowerStatus));
+        },
+        false);
+    
+    return low_power_view;
+}
+
+void dht11_low_power_view_free(DHT11LowPowerView* low_power_view) {
+    furi_assert(low_power_view);
+    view_free(low_power_view->view);
+    free(low_power_view);
+}
+
+View* dht11_low_power_view_get_view(DHT11LowPowerView* low_power_view) {
+    furi_assert(low_power_view);
+    return low_power_view->view;
+}
+
+void dht11_low_power_view_set_callback(
+    DHT11LowPowerView* low_power_view,
+    DHT11LowPowerViewCallback callback,
+    void* context) {
+    furi_assert(low_power_view);
+    low_power_view->callback = callback;
+    low_power_view->context = context;
+}
+
+void dht11_low_power_view_set_status(DHT11LowPowerView* low_power_view, const DHT11LowPowerStatus* status) {
+    furi_assert(low_power_view);
+    with_view_model(
+        low_power_view->view, DHT11LowPowerStatus * model, { *model = *status; }, true);
+}
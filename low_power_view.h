@@ -0,0 +1,82 @@
+/**
+ * @file low_power_view.h
+ * @brief Low-power logging status view
+ * 
+ * A static status page. It is only redrawn when the scene pushes a new
+ * status, which the low-power scene does on a key press, so the GUI stays
+ * idle while samples are being logged.
+ */
+
+#pragma once
+
+#include <gui/view.h>
+#include "sample_buffer.h"
+
+/**
+ * @brief Input callback, invoked with DHT11CustomEventWake
+ * 
+ * @param event Custom event for the pressed key
+ * @param context User context
+ */
+typedef void (*DHT11LowPowerViewCallback)(uint32_t event, void* context);
+
+/**
+ * @brief Status shown by the view
+ */
+typedef struct {
+    uint32_t period_s;          /**< Sampling period */
+    uint32_t elapsed_s;         /**< Time spent in low-power mode */
+    bool switched;              /**< Sensor supply is switched between reads */
+    bool logging;               /**< SD logger is running */
+    uint32_t logged;            /**< Samples written by the logger */
+    uint32_t lost;              /**< Samples the logger missed */
+    bool have_sample;           /**< sample is valid */
+    DHT11Sample sample;         /**< Newest sample of the selected sensor */
+    char name[4];               /**< Data pin name of the selected sensor */
+    bool imperial;              /**< Show Fahrenheit */
+} DHT11LowPowerStatus;
+
+/** @brief Low-power view instance */
+typedef struct DHT11LowPowerView DHT11LowPowerView;
+
+/**
+ * @brief Allocate the low-power view
+ * 
+ * @return Pointer to the allocated view
+ */
+DHT11LowPowerView* dht11_low_power_view_alloc(void);
+
+/**
+ * @brief Free the low-power view
+ * 
+ * @param low_power_view Pointer to the view
+ */
+void dht11_low_power_view_free(DHT11LowPowerView* low_power_view);
+
+/**
+ * @brief Get the underlying View for the view dispatcher
+ * 
+ * @param low_power_view Pointer to the view
+ * @return View instance
+ */
+View* dht11_low_power_view_get_view(DHT11LowPowerView* low_power_view);
+
+/**
+ * @brief Set the function called on any key but Back
+ * 
+ * @param low_power_view Pointer to the view
+ * @param callback Callback receiving DHT11CustomEventWake
+ * @param context Context passed to the callback
+ */
+void dht11_low_power_view_set_callback(
+    DHT11LowPowerView* low_power_view,
+    DHT11LowPowerViewCallback callback,
+    void* context);
+
+/**
+ * @brief Show a status and redraw
+ * 
+ * @param low_power_view Pointer to the view
+ * @param status Status to show
+ */
+void dht11_low_power_view_set_status(DHT11LowPowerView* low_power_view, const DHT11LowPowerStatus* status);
@@ -6,6 +6,64 @@
 #include "app.h"
 #include "main_menu.h"
 #include "scenes.h"
+#include "scene_views.h"
+#include "sensor.h"
+
+static void dht11_main_menu_callback(void* context, uint32_t index);
+
+/** @brief USB stream item label, indexed by DHT11UsbStreamMode */
+static const char* const dht11_main_menu_usb_stream_labels[] = {
+    [DHT11UsbStreamModeOff] = "USB Stream: OFF",
+    [DHT11UsbStreamModeData] = "USB Stream: DATA",
+    [DHT11UsbStreamModeTimings] = "USB Stream: +TRACE",
+};
+
+/**
+ * @brief Populate the main menu
+ * 
+ * @param app Application context
+ */
+static void dht11_main_menu_build(DHT11App* app) {
+    submenu_reset(app->submenu);
+    submenu_add_item(app->submenu, "Read Sensor", DHT11MainMenuIndexReadSensor, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "About", DHT11MainMenuIndexAbout, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "Debug", DHT11MainMenuIndexDebug, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "Statistics", DHT11MainMenuIndexStats, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "History Graph", DHT11MainMenuIndexGraph, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "Low Power Log", DHT11MainMenuIndexLowPower, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "Settings", DHT11MainMenuIndexSettings, dht11_main_menu_callback, app);
+    submenu_add_item(app->submenu, "Benchmark", DHT11MainMenuIndexBenchmark, dht11_main_menu_callback, app);
+    submenu_add_item(
+        app->submenu,
+        dht11_sensor_is_trace_enabled(app) ? "Trace Log: ON" : "Trace Log: OFF",
+        DHT11MainMenuIndexTrace,
+        dht11_main_menu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        dht11_logger_is_running(app->logger) ? "SD Log: ON" : "SD Log: OFF",
+        DHT11MainMenuIndexLog,
+        dht11_main_menu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        dht11_beacon_is_running(app->beacon) ? "BLE Beacon: ON" : "BLE Beacon: OFF",
+        DHT11MainMenuIndexBeacon,
+        dht11_main_menu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        app->alerts->enabled ? "Alerts: ON" : "Alerts: OFF",
+        DHT11MainMenuIndexAlerts,
+        dht11_main_menu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        dht11_main_menu_usb_stream_labels[dht11_sensor_get_usb_stream(app)],
+        DHT11MainMenuIndexUsbStream,
+        dht11_main_menu_callback,
+        app);
+}
 
 /**
  * @brief Main menu callback handler
@@ -28,16 +86,72 @@ static void dht11_main_menu_callback(void* context, uint32_t index) {
     case DHT11MainMenuIndexDebug:
         scene_manager_next_scene(app->scene_manager, DHT11SceneDebug);
         break;
+    case DHT11MainMenuIndexStats:
+        scene_manager_next_scene(app->scene_manager, DHT11SceneStats);
+        break;
+    case DHT11MainMenuIndexGraph:
+        scene_manager_next_scene(app->scene_manager, DHT11SceneGraph);
+        break;
+    case DHT11MainMenuIndexLowPower:
+        scene_manager_next_scene(app->scene_manager, DHT11SceneLowPower);
+        break;
+    case DHT11MainMenuIndexSettings:
+        scene_manager_next_scene(app->scene_manager, DHT11SceneSettings);
+        break;
+    case DHT11MainMenuIndexBenchmark:
+        scene_manager_next_scene(app->scene_manager, DHT11SceneBenchmark);
+        break;
+    case DHT11MainMenuIndexTrace:
+        if(!dht11_sensor_set_trace_enabled(app, !dht11_sensor_is_trace_enabled(app))) {
+            notification_message(app->notifications, &sequence_error);
+        }
+        dht11_main_menu_build(app);
+        submenu_set_selected_item(app->submenu, DHT11MainMenuIndexTrace);
+        break;
+    case DHT11MainMenuIndexLog:
+        if(dht11_logger_is_running(app->logger)) {
+            dht11_logger_stop(app->logger);
+        } else if(!dht11_logger_start(app->logger, DHT11_LOGGER_DEFAULT_PATH, DHT11_LOGGER_DEFAULT_FORMAT)) {
+            notification_message(app->notifications, &sequence_error);
+        }
+        dht11_main_menu_build(app);
+        submenu_set_selected_item(app->submenu, DHT11MainMenuIndexLog);
+        break;
+    case DHT11MainMenuIndexBeacon:
+        // Advertises the sensor currently selected on the Read Sensor screen
+        if(dht11_beacon_is_running(app->beacon)) {
+            dht11_beacon_stop(app->beacon);
+        } else if(!dht11_beacon_start(app->beacon, app->selected_sensor)) {
+            notification_message(app->notifications, &sequence_error);
+        }
+        dht11_main_menu_build(app);
+        submenu_set_selected_item(app->submenu, DHT11MainMenuIndexBeacon);
+        break;
+    case DHT11MainMenuIndexAlerts:
+        app->settings.alerts = !app->alerts->enabled;
+        dht11_alert_set_enabled(app->alerts, app->settings.alerts);
+        dht11_main_menu_build(app);
+        submenu_set_selected_item(app->submenu, DHT11MainMenuIndexAlerts);
+        break;
+    case DHT11MainMenuIndexUsbStream: {
+        // Off, data only, data with timings, off again
+        DHT11UsbStreamMode mode =
+            (dht11_sensor_get_usb_stream(app) + 1) % COUNT_OF(dht11_main_menu_usb_stream_labels);
+        if(!dht11_sensor_set_usb_stream(app, mode)) {
+            notification_message(app->notifications, &sequence_error);
+        }
+        dht11_main_menu_build(app);
+        submenu_set_selected_item(app->submenu, DHT11MainMenuIndexUsbStream);
+        break;
+    }
     }
 }
 
 void dht11_scene_main_menu_on_enter(void* context) {
     DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneMainMenu);
     
-    submenu_reset(app->submenu);
-    submenu_add_item(app->submenu, "Read Sensor", DHT11MainMenuIndexReadSensor, dht11_main_menu_callback, app);
-    submenu_add_item(app->submenu, "About", DHT11MainMenuIndexAbout, dht11_main_menu_callback, app);
-    submenu_add_item(app->submenu, "Debug", DHT11MainMenuIndexDebug, dht11_main_menu_callback, app);
+    dht11_main_menu_build(app);
     
     view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneMainMenu);
 }
@@ -51,4 +165,5 @@ bool dht11_scene_main_menu_on_event(void* context, SceneManagerEvent event) {
 void dht11_scene_main_menu_on_exit(void* context) {
     DHT11App* app = context;
     submenu_reset(app->submenu);
+    dht11_scene_view_release(app, DHT11SceneMainMenu);
 }
\ No newline at end of file
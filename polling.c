@@ -0,0 +1,75 @@
+/**
+ * @file polling.c
+ * @brief Busy-wait transfer receiver implementation
+ */
+
+#include "polling.h"
+#include "timing.h"
+
+void dht11_polling_receive(DHT11HalPin pin, bool pull_up, DHT11Transfer* transfer) {
+    const DHT11Timing* timing = &dht11_timing;
+    uint32_t edge = 0;
+    uint32_t now = 0;
+    
+    // Pull high for 20-40us then release to input mode
+    dht11_hal_pin_write(pin, true);
+    dht11_timing_delay(timing->release);
+    
+    // Switch to input mode
+    dht11_hal_pin_release(pin, pull_up);
+    edge = dht11_timing_now();
+    
+    // DHT11 response sequence:
+    // 1. DHT11 pulls low for 80us
+    bool ok = dht11_timing_wait_while(pin, true, edge, timing->response_timeout, &now);
+    transfer->trace[DHT11_TRACE_WAIT_RESPONSE] = dht11_trace_delta(edge, now);
+    edge = now;
+    if(!ok) {
+        transfer->status = DHT11StatusNoResponse;
+        return;
+    }
+    transfer->trace_length = 1;
+    
+    // 2. DHT11 pulls high for 80us
+    ok = dht11_timing_wait_while(pin, false, edge, timing->response_timeout, &now);
+    transfer->trace[DHT11_TRACE_RESPONSE_LOW] = dht11_trace_delta(edge, now);
+    edge = now;
+    if(!ok) {
+        transfer->status = DHT11StatusResponseLow;
+        return;
+    }
+    transfer->trace_length = 2;
+    
+    // 3. Wait for end of response high period
+    ok = dht11_timing_wait_while(pin, true, edge, timing->response_timeout, &now);
+    transfer->trace[DHT11_TRACE_RESPONSE_HIGH] = dht11_trace_delta(edge, now);
+    edge = now;
+    if(!ok) {
+        transfer->status = DHT11StatusResponseHigh;
+        return;
+    }
+    transfer->trace_length = 3;
+    
+    // Read 40 bits of data (5 bytes)
+    for(int i = 0; i < DHT11_BIT_COUNT; i++) {
+        // Wait for bit start (low period ~50us)
+        ok = dht11_timing_wait_while(pin, false, edge, timing->bit_timeout, &now);
+        transfer->trace[DHT11_TRACE_BIT_LOW(i)] = dht11_trace_delta(edge, now);
+        edge = now;
+        
+        // High period: ~26-28us for a '0', ~70us for a '1'
+        if(ok) {
+            ok = dht11_timing_wait_while(pin, true, edge, timing->bit_timeout, &now);
+            transfer->trace[DHT11_TRACE_BIT_HIGH(i)] = dht11_trace_delta(edge, now);
+            edge = now;
+        }
+        if(!ok) {
+            transfer->status = DHT11StatusBitTimeout;
+            transfer->failed_bit = i;
+            return;
+        }
+        
+        transfer->trace_length = DHT11_TRACE_BIT_HIGH(i) + 1;
+        transfer->bits_read = i + 1;
+    }
+}
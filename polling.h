@@ -0,0 +1,26 @@
+/**
+ * @file polling.h
+ * @brief Busy-wait transfer receiver
+ * 
+ * The protocol half of the polling read backend. It only uses hal.h and
+ * timing.h, so it builds unchanged for the device and for a desktop host.
+ */
+
+#pragma once
+
+#include "hal.h"
+#include "decoder.h"
+
+/**
+ * @brief Busy-wait through all phases of a transfer
+ * 
+ * Sends the release part of the start signal and polls all 40 bits. Must
+ * run with interrupts disabled; the line must already be held low for the
+ * start pulse. Every phase is timed against a precomputed cycle deadline;
+ * only raw timings are recorded here and decoding happens afterwards.
+ * 
+ * @param pin Data line
+ * @param pull_up Release the line with the internal pull-up enabled
+ * @param transfer Transfer record to fill
+ */
+void dht11_polling_receive(DHT11HalPin pin, bool pull_up, DHT11Transfer* transfer);
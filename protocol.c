@@ -0,0 +1,63 @@
+/**
+ * @file protocol.c
+ * @brief Sensor family descriptor table and value conversion
+ */
+
+#include "protocol.h"
+
+const DHT11Protocol dht11_protocols[DHT11ProtocolCount] = {
+    // Datasheet asks for at least 18ms; 20ms leaves margin
+    [DHT11ProtocolDht11] = {
+        .name = "DHT11",
+        .start_ms = 20,
+        .threshold_us = 40,
+        .min_interval_ms = 1000,
+        .high_weight = 10,
+        .sign_mask = 0x80,
+        .temperature_min = -400,
+        .temperature_max = 600,
+        .humidity_max = 1000,
+    },
+    // 0.8ms to 20ms are accepted
+    [DHT11ProtocolDht22] = {
+        .name = "DHT22",
+        .start_ms = 2,
+        .threshold_us = 40,
+        .min_interval_ms = 2000,
+        .high_weight = 256,
+        .sign_mask = 0x80,
+        .temperature_min = -400,
+        .temperature_max = 800,
+        .humidity_max = 1000,
+    },
+    [DHT11ProtocolDht21] = {
+        .name = "DHT21",
+        .start_ms = 2,
+        .threshold_us = 40,
+        .min_interval_ms = 2000,
+        .high_weight = 256,
+        .sign_mask = 0x80,
+        .temperature_min = -400,
+        .temperature_max = 800,
+        .humidity_max = 1000,
+    },
+};
+
+bool dht11_protocol_convert(
+    const DHT11Protocol* protocol,
+    const uint8_t* data,
+    int16_t* temperature,
+    uint16_t* humidity) {
+    uint16_t humidity_tenths = data[0] * protocol->high_weight + data[1];
+    int16_t temperature_tenths = (data[2] & ~protocol->sign_mask) * protocol->high_weight + data[3];
+    if(data[2] & protocol->sign_mask) {
+        temperature_tenths = -temperature_tenths;
+    }
+    
+    *humidity = humidity_tenths;
+    *temperature = temperature_tenths;
+    
+    return humidity_tenths <= protocol->humidity_max &&
+           temperature_tenths >= protocol->temperature_min &&
+           temperature_tenths <= protocol->temperature_max;
+}
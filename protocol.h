@@ -0,0 +1,66 @@
+/**
+ * @file protocol.h
+ * @brief Sensor family descriptors
+ * 
+ * The DHT11, DHT22/AM2302 and DHT21/AM2301 share the single-wire framing:
+ * a host start pulse, an 80us response and 40 bits told apart by the
+ * length of their high phase. They differ in the start pulse they need,
+ * the time they want between transactions and how the five data bytes
+ * encode the values. Those differences are data in a descriptor, so every
+ * read backend and the bit decoder stay the same for all of them; the
+ * family only matters once the bytes are converted.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Supported sensor families
+ */
+typedef enum {
+    DHT11ProtocolDht11,     /**< DHT11, 1 degree resolution */
+    DHT11ProtocolDht22,     /**< DHT22 and AM2302, 0.1 degree resolution */
+    DHT11ProtocolDht21,     /**< DHT21 and AM2301, 0.1 degree resolution */
+    DHT11ProtocolCount,     /**< Number of families */
+} DHT11ProtocolType;
+
+/**
+ * @brief Description of one sensor family
+ * 
+ * Both values are sent as a high and a low byte. In tenths, a value is
+ * high * high_weight + low, where the DHT11 sends whole units and tenths
+ * (weight 10) and the others a 16-bit word (weight 256). The temperature
+ * is negative when sign_mask is set in its high byte, which is then
+ * masked off: sign-magnitude in both cases.
+ */
+typedef struct {
+    const char* name;               /**< Part name for display */
+    uint8_t start_ms;               /**< Length of the host start pulse */
+    uint8_t threshold_us;           /**< Bit threshold until the sensor is calibrated */
+    uint16_t min_interval_ms;       /**< Minimum time between two transactions */
+    uint16_t high_weight;           /**< Weight of a value's high byte in tenths */
+    uint8_t sign_mask;              /**< Sign bit in the temperature high byte */
+    int16_t temperature_min;        /**< Lowest plausible temperature in tenths */
+    int16_t temperature_max;        /**< Highest plausible temperature in tenths */
+    uint16_t humidity_max;          /**< Highest plausible humidity in tenths */
+} DHT11Protocol;
+
+/** @brief Descriptor table, indexed by DHT11ProtocolType */
+extern const DHT11Protocol dht11_protocols[DHT11ProtocolCount];
+
+/**
+ * @brief Convert the data bytes of a transfer
+ * 
+ * @param protocol Family of the sensor that sent the bytes
+ * @param data The five data bytes, checksum already verified
+ * @param temperature Output for the temperature in tenths of a degree Celsius
+ * @param humidity Output for the relative humidity in tenths of a percent
+ * @return true if both values are within the family's plausible range
+ */
+bool dht11_protocol_convert(
+    const DHT11Protocol* protocol,
+    const uint8_t* data,
+    int16_t* temperature,
+    uint16_t* humidity);
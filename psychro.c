@@ -0,0 +1,42 @@
+/**
+ * @file psychro.c
+ * @brief Psychrometric table lookup implementation
+ */
+
+#include "psychro.h"
+#include "psychro_tables.h"
+
+bool dht11_psychro_lookup(uint8_t humidity, uint8_t temperature, DHT11Psychro* psychro) {
+    uint8_t t = temperature - DHT11_PSYCHRO_TEMP_MIN;
+    uint8_t h = humidity - DHT11_PSYCHRO_HUMIDITY_MIN;
+    
+    // Values below the minimum wrap around; a set sign bit lands outside as well
+    if(t >= DHT11_PSYCHRO_TEMPS || h >= DHT11_PSYCHRO_HUMIDITIES) {
+        return false;
+    }
+    
+    int16_t tenths = temperature * 10;
+    
+    if(temperature >= DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN && humidity >= DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN) {
+        psychro->heat_index = dht11_psychro_heat_index[temperature - DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN]
+                                                      [humidity - DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN];
+    } else {
+        psychro->heat_index = tenths;
+    }
+    
+    uint8_t depression = dht11_psychro_dew_point_depression[t][h];
+    psychro->dew_point =
+        tenths - (depression * 10 + DHT11_PSYCHRO_DEW_POINT_SCALE / 2) / DHT11_PSYCHRO_DEW_POINT_SCALE;
+    
+    // Vapour density is proportional to relative humidity at a given temperature
+    psychro->absolute_humidity = ((uint32_t)dht11_psychro_saturation_density[t] * humidity + 50) / 100;
+    return true;
+}
+
+bool dht11_psychro_lookup_tenths(uint16_t humidity, int16_t temperature, DHT11Psychro* psychro) {
+    // Rounded values past a byte would wrap back into the tables
+    if(temperature < 0 || temperature > 2545 || humidity > 2545) {
+        return false;
+    }
+    return dht11_psychro_lookup((humidity + 5) / 10, (temperature + 5) / 10, psychro);
+}
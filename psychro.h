@@ -0,0 +1,48 @@
+/**
+ * @file psychro.h
+ * @brief Heat index, dew point and absolute humidity from table lookups
+ * 
+ * The DHT11 only reports whole degrees and whole percent, so every derived
+ * value within its specified range is precomputed by tools/psychro_tables.py.
+ * A lookup is indexed directly on the raw humidity and temperature bytes
+ * and costs a few loads instead of a float polynomial.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Values derived from one reading, in fixed point
+ */
+typedef struct {
+    int16_t heat_index;             /**< Apparent temperature in tenths of a degree Celsius */
+    int16_t dew_point;              /**< Dew point in tenths of a degree Celsius */
+    uint16_t absolute_humidity;     /**< Water vapour density in hundredths of g/m^3 */
+} DHT11Psychro;
+
+/**
+ * @brief Look up the derived values of a reading
+ * 
+ * Below 27°C or 40% the heat index equals the air temperature, as in the
+ * NOAA definition.
+ * 
+ * @param humidity Integral humidity byte, data[0] of the transfer
+ * @param temperature Integral temperature byte, data[2] of the transfer
+ * @param psychro Output for the derived values
+ * @return false if the reading lies outside 0-50°C or 20-90%
+ */
+bool dht11_psychro_lookup(uint8_t humidity, uint8_t temperature, DHT11Psychro* psychro);
+
+/**
+ * @brief Look up the derived values of a reading in tenths
+ * 
+ * Rounds to the whole degree and percent the tables are indexed on.
+ * 
+ * @param humidity Relative humidity in tenths of a percent
+ * @param temperature Temperature in tenths of a degree Celsius
+ * @param psychro Output for the derived values
+ * @return false if the reading lies outside the tables
+ */
+bool dht11_psychro_lookup_tenths(uint16_t humidity, int16_t temperature, DHT11Psychro* psychro);
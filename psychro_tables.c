@@ -0,0 +1,622 @@
+/**
+ * @file psychro_tables.c
+ * @brief Precomputed psychrometric tables
+ * 
+ * Generated by tools/psychro_tables.py, do not edit.
+ */
+
+#include "psychro_tables.h"
+
+const uint16_t dht11_psychro_heat_index[DHT11_PSYCHRO_HEAT_INDEX_TEMPS][DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES] = {
+    // 27 C
+    {
+        269, 269, 270, 270, 271, 271, 272, 272, 273, 274, 274, 275,
+        275, 276, 277, 277, 278, 279, 279, 280, 281, 282, 282, 283,
+        284, 285, 285, 286, 287, 288, 289, 289, 290, 291, 292, 293,
+        294, 295, 296, 296, 297, 298, 299, 300, 301, 302, 303, 304,
+        305, 306, 307,
+    },
+    // 28 C
+    {
+        277, 277, 278, 279, 280, 280, 281, 282, 283, 284, 284, 285,
+        286, 287, 288, 289, 290, 291, 292, 293, 294, 296, 297, 298,
+        299, 300, 302, 303, 304, 305, 307, 308, 309, 311, 312, 314,
+        315, 316, 318, 319, 321, 323, 324, 326, 327, 329, 331, 332,
+        334, 336, 337,
+    },
+    // 29 C
+    {
+        286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 297, 298,
+        299, 300, 302, 303, 304, 306, 307, 309, 310, 312, 313, 315,
+        317, 318, 320, 322, 324, 325, 327, 329, 331, 333, 335, 337,
+        339, 341, 343, 345, 347, 350, 352, 354, 356, 359, 361, 363,
+        366, 368, 371,
+    },
+    // 30 C
+    {
+        297, 298, 299, 301, 302, 303, 305, 306, 307, 309, 310, 312,
+        314, 315, 317, 319, 321, 323, 324, 326, 328, 330, 332, 334,
+        337, 339, 341, 343, 346, 348, 350, 353, 355, 358, 360, 363,
+        366, 368, 371, 374, 377, 380, 382, 385, 388, 391, 394, 398,
+        401, 404, 407,
+    },
+    // 31 C
+    {
+        309, 311, 312, 314, 315, 317, 319, 321, 322, 324, 326, 328,
+        330, 332, 334, 337, 339, 341, 344, 346, 348, 351, 354, 356,
+        359, 362, 364, 367, 370, 373, 376, 379, 382, 385, 388, 392,
+        395, 398, 402, 405, 409, 412, 416, 420, 423, 427, 431, 435,
+        439, 443, 447,
+    },
+    // 32 C
+    {
+        323, 325, 326, 328, 330, 332, 335, 337, 339, 341, 344, 346,
+        349, 351, 354, 356, 359, 362, 365, 368, 371, 374, 377, 380,
+        383, 387, 390, 393, 397, 400, 404, 408, 412, 415, 419, 423,
+        427, 431, 435, 439, 444, 448, 452, 457, 461, 466, 470, 475,
+        480, 485, 490,
+    },
+    // 33 C
+    {
+        338, 340, 342, 345, 347, 349, 352, 355, 357, 360, 363, 366,
+        369, 372, 375, 378, 381, 385, 388, 392, 395, 399, 403, 406,
+        410, 414, 418, 422, 426, 430, 435, 439, 443, 448, 453, 457,
+        462, 467, 472, 476, 481, 487, 492, 497, 502, 508, 513, 518,
+        524, 530, 535,
+    },
+    // 34 C
+    {
+        354, 357, 360, 362, 365, 368, 371, 374, 377, 381, 384, 387,
+        391, 394, 398, 402, 406, 410, 414, 418, 422, 426, 430, 435,
+        439, 444, 448, 453, 458, 463, 468, 473, 478, 483, 489, 494,
+        499, 505, 511, 516, 522, 528, 534, 540, 546, 552, 559, 565,
+        571, 578, 584,
+    },
+    // 35 C
+    {
+        372, 375, 378, 382, 385, 388, 392, 395, 399, 403, 407, 411,
+        415, 419, 423, 427, 432, 436, 441, 446, 451, 455, 460, 465,
+        471, 476, 481, 487, 492, 498, 503, 509, 515, 521, 527, 533,
+        540, 546, 552, 559, 565, 572, 579, 586, 593, 600, 607, 614,
+        622, 629, 637,
+    },
+    // 36 C
+    {
+        391, 395, 399, 402, 406, 410, 414, 418, 423, 427, 431, 436,
+        441, 445, 450, 455, 460, 465, 471, 476, 481, 487, 493, 498,
+        504, 510, 516, 522, 529, 535, 542, 548, 555, 562, 568, 575,
+        582, 590, 597, 604, 612, 619, 627, 635, 643, 651, 659, 667,
+        675, 684, 692,
+    },
+    // 37 C
+    {
+        412, 416, 420, 425, 429, 434, 438, 443, 448, 453, 458, 463,
+        468, 474, 479, 485, 490, 496, 502, 508, 514, 521, 527, 534,
+        540, 547, 554, 561, 568, 575, 582, 589, 597, 605, 612, 620,
+        628, 636, 644, 652, 661, 669, 678, 687, 695, 704, 713, 722,
+        732, 741, 751,
+    },
+    // 38 C
+    {
+        434, 439, 444, 448, 453, 459, 464, 469, 475, 480, 486, 492,
+        498, 504, 510, 516, 523, 529, 536, 543, 550, 557, 564, 571,
+        578, 586, 594, 601, 609, 617, 625, 633, 642, 650, 659, 667,
+        676, 685, 694, 703, 713, 722, 732, 741, 751, 761, 771, 781,
+        791, 802, 812,
+    },
+    // 39 C
+    {
+        458, 463, 468, 474, 479, 485, 491, 497, 503, 510, 516, 522,
+        529, 536, 543, 550, 557, 564, 572, 579, 587, 595, 603, 611,
+        619, 627, 636, 644, 653, 662, 671, 680, 689, 698, 708, 718,
+        727, 737, 747, 757, 768, 778, 788, 799, 810, 821, 832, 843,
+        854, 866, 877,
+    },
+    // 40 C
+    {
+        483, 489, 495, 501, 507, 513, 520, 527, 534, 541, 548, 555,
+        562, 570, 578, 585, 593, 601, 610, 618, 626, 635, 644, 653,
+        662, 671, 680, 690, 699, 709, 719, 729, 739, 749, 760, 770,
+        781, 792, 803, 814, 825, 836, 848, 860, 871, 883, 895, 908,
+        920, 932, 945,
+    },
+    // 41 C
+    {
+        509, 516, 522, 529, 536, 543, 551, 558, 566, 573, 581, 589,
+        597, 606, 614, 623, 632, 640, 650, 659, 668, 678, 687, 697,
+        707, 717, 727, 738, 748, 759, 770, 780, 792, 803, 814, 826,
+        837, 849, 861, 873, 886, 898, 911, 923, 936, 949, 962, 975,
+        989, 1002, 1016,
+    },
+    // 42 C
+    {
+        537, 544, 551, 559, 567, 575, 583, 591, 599, 608, 617, 625,
+        634, 644, 653, 662, 672, 682, 692, 702, 712, 722, 733, 743,
+        754, 765, 776, 788, 799, 811, 823, 835, 847, 859, 871, 884,
+        896, 909, 922, 935, 949, 962, 976, 990, 1004, 1018, 1032, 1046,
+        1061, 1076, 1090,
+    },
+    // 43 C
+    {
+        566, 574, 582, 590, 599, 608, 617, 626, 635, 644, 654, 663,
+        673, 683, 693, 704, 714, 725, 736, 747, 758, 769, 781, 792,
+        804, 816, 828, 840, 853, 865, 878, 891, 904, 918, 931, 945,
+        958, 972, 986, 1001, 1015, 1029, 1044, 1059, 1074, 1089, 1105, 1120,
+        1136, 1152, 1168,
+    },
+    // 44 C
+    {
+        596, 605, 614, 623, 633, 642, 652, 662, 672, 682, 693, 703,
+        714, 725, 736, 747, 759, 770, 782, 794, 806, 818, 831, 843,
+        856, 869, 882, 895, 909, 922, 936, 950, 964, 979, 993, 1008,
+        1023, 1038, 1053, 1068, 1084, 1100, 1115, 1131, 1148, 1164, 1181, 1197,
+        1214, 1231, 1249,
+    },
+    // 45 C
+    {
+        628, 638, 648, 658, 668, 679, 689, 700, 711, 722, 733, 745,
+        756, 768, 780, 792, 805, 817, 830, 843, 856, 869, 883, 896,
+        910, 924, 938, 953, 967, 982, 997, 1012, 1027, 1043, 1058, 1074,
+        1090, 1106, 1122, 1139, 1156, 1172, 1190, 1207, 1224, 1242, 1259, 1277,
+        1296, 1314, 1332,
+    },
+    // 46 C
+    {
+        662, 672, 683, 694, 705, 716, 728, 740, 751, 763, 776, 788,
+        801, 814, 827, 840, 853, 867, 880, 894, 909, 923, 937, 952,
+        967, 982, 997, 1013, 1028, 1044, 1060, 1076, 1093, 1109, 1126, 1143,
+        1160, 1177, 1195, 1212, 1230, 1248, 1267, 1285, 1304, 1322, 1341, 1361,
+        1380, 1399, 1419,
+    },
+    // 47 C
+    {
+        696, 708, 720, 731, 744, 756, 768, 781, 794, 807, 820, 833,
+        847, 861, 875, 889, 903, 918, 933, 948, 963, 978, 994, 1010,
+        1026, 1042, 1058, 1075, 1092, 1108, 1126, 1143, 1160, 1178, 1196, 1214,
+        1232, 1251, 1270, 1289, 1308, 1327, 1346, 1366, 1386, 1406, 1426, 1447,
+        1467, 1488, 1509,
+    },
+    // 48 C
+    {
+        733, 745, 758, 771, 784, 797, 810, 824, 838, 852, 866, 881,
+        895, 910, 925, 940, 956, 971, 987, 1003, 1020, 1036, 1053, 1070,
+        1087, 1104, 1122, 1139, 1157, 1175, 1194, 1212, 1231, 1250, 1269, 1288,
+        1308, 1328, 1347, 1368, 1388, 1408, 1429, 1450, 1471, 1493, 1514, 1536,
+        1558, 1580, 1602,
+    },
+    // 49 C
+    {
+        770, 784, 797, 811, 825, 839, 854, 869, 883, 899, 914, 929,
+        945, 961, 977, 994, 1010, 1027, 1044, 1061, 1079, 1096, 1114, 1132,
+        1150, 1169, 1187, 1206, 1225, 1245, 1264, 1284, 1304, 1324, 1344, 1365,
+        1386, 1407, 1428, 1449, 1471, 1493, 1515, 1537, 1560, 1582, 1605, 1628,
+        1652, 1675, 1699,
+    },
+    // 50 C
+    {
+        809, 824, 838, 853, 868, 884, 899, 915, 931, 947, 964, 980,
+        997, 1014, 1031, 1049, 1067, 1084, 1103, 1121, 1140, 1158, 1177, 1197,
+        1216, 1236, 1256, 1276, 1296, 1317, 1337, 1358, 1380, 1401, 1423, 1444,
+        1467, 1489, 1511, 1534, 1557, 1580, 1604, 1627, 1651, 1675, 1699, 1724,
+        1748, 1773, 1798,
+    },
+};
+
+const uint8_t dht11_psychro_dew_point_depression[DHT11_PSYCHRO_TEMPS][DHT11_PSYCHRO_HUMIDITIES] = {
+    // 0 C
+    {
+        81, 79, 77, 75, 73, 71, 69, 67, 66, 64, 62, 61, 59, 58, 56, 55,
+        53, 52, 51, 49, 48, 47, 46, 44, 43, 42, 41, 40, 39, 38, 37, 36,
+        35, 34, 33, 32, 31, 30, 29, 28, 27, 27, 26, 25, 24, 23, 22, 22,
+        21, 20, 19, 19, 18, 17, 16, 16, 15, 14, 14, 13, 12, 11, 11, 10,
+        10, 9, 8, 8, 7, 6, 6,
+    },
+    // 1 C
+    {
+        82, 80, 78, 75, 73, 71, 70, 68, 66, 64, 63, 61, 60, 58, 57, 55,
+        54, 52, 51, 50, 48, 47, 46, 45, 44, 43, 41, 40, 39, 38, 37, 36,
+        35, 34, 33, 32, 31, 30, 29, 29, 28, 27, 26, 25, 24, 23, 23, 22,
+        21, 20, 19, 19, 18, 17, 16, 16, 15, 14, 14, 13, 12, 12, 11, 10,
+        10, 9, 8, 8, 7, 6, 6,
+    },
+    // 2 C
+    {
+        83, 80, 78, 76, 74, 72, 70, 68, 67, 65, 63, 62, 60, 58, 57, 56,
+        54, 53, 51, 50, 49, 48, 46, 45, 44, 43, 42, 41, 40, 38, 37, 36,
+        35, 34, 33, 32, 31, 31, 30, 29, 28, 27, 26, 25, 24, 24, 23, 22,
+        21, 20, 20, 19, 18, 17, 17, 16, 15, 14, 14, 13, 12, 12, 11, 10,
+        10, 9, 8, 8, 7, 6, 6,
+    },
+    // 3 C
+    {
+        83, 81, 79, 77, 75, 73, 71, 69, 67, 65, 64, 62, 60, 59, 57, 56,
+        55, 53, 52, 51, 49, 48, 47, 46, 44, 43, 42, 41, 40, 39, 38, 37,
+        36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 25, 24, 23, 22,
+        21, 21, 20, 19, 18, 17, 17, 16, 15, 15, 14, 13, 12, 12, 11, 10,
+        10, 9, 8, 8, 7, 7, 6,
+    },
+    // 4 C
+    {
+        84, 82, 79, 77, 75, 73, 71, 69, 68, 66, 64, 63, 61, 59, 58, 56,
+        55, 54, 52, 51, 50, 48, 47, 46, 45, 44, 42, 41, 40, 39, 38, 37,
+        36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 27, 26, 25, 24, 23, 22,
+        22, 21, 20, 19, 18, 18, 17, 16, 15, 15, 14, 13, 13, 12, 11, 11,
+        10, 9, 9, 8, 7, 7, 6,
+    },
+    // 5 C
+    {
+        85, 82, 80, 78, 76, 74, 72, 70, 68, 66, 65, 63, 61, 60, 58, 57,
+        55, 54, 53, 51, 50, 49, 47, 46, 45, 44, 43, 42, 40, 39, 38, 37,
+        36, 35, 34, 33, 32, 31, 30, 29, 29, 28, 27, 26, 25, 24, 23, 22,
+        22, 21, 20, 19, 19, 18, 17, 16, 16, 15, 14, 13, 13, 12, 11, 11,
+        10, 9, 9, 8, 7, 7, 6,
+    },
+    // 6 C
+    {
+        85, 83, 81, 78, 76, 74, 72, 71, 69, 67, 65, 64, 62, 60, 59, 57,
+        56, 54, 53, 52, 50, 49, 48, 47, 45, 44, 43, 42, 41, 40, 39, 38,
+        37, 35, 34, 33, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 24, 23,
+        22, 21, 20, 19, 19, 18, 17, 16, 16, 15, 14, 13, 13, 12, 11, 11,
+        10, 9, 9, 8, 7, 7, 6,
+    },
+    // 7 C
+    {
+        86, 84, 81, 79, 77, 75, 73, 71, 69, 67, 66, 64, 62, 61, 59, 58,
+        56, 55, 53, 52, 51, 50, 48, 47, 46, 45, 43, 42, 41, 40, 39, 38,
+        37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 25, 24, 23,
+        22, 21, 20, 20, 19, 18, 17, 17, 16, 15, 14, 14, 13, 12, 11, 11,
+        10, 9, 9, 8, 7, 7, 6,
+    },
+    // 8 C
+    {
+        87, 84, 82, 80, 78, 75, 74, 72, 70, 68, 66, 65, 63, 61, 60, 58,
+        57, 55, 54, 53, 51, 50, 49, 47, 46, 45, 44, 43, 41, 40, 39, 38,
+        37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 26, 25, 24, 23,
+        22, 21, 21, 20, 19, 18, 17, 17, 16, 15, 14, 14, 13, 12, 12, 11,
+        10, 9, 9, 8, 7, 7, 6,
+    },
+    // 9 C
+    {
+        87, 85, 83, 80, 78, 76, 74, 72, 70, 68, 67, 65, 63, 62, 60, 59,
+        57, 56, 54, 53, 52, 50, 49, 48, 46, 45, 44, 43, 42, 41, 40, 38,
+        37, 36, 35, 34, 33, 32, 31, 30, 29, 29, 28, 27, 26, 25, 24, 23,
+        22, 22, 21, 20, 19, 18, 18, 17, 16, 15, 15, 14, 13, 12, 12, 11,
+        10, 10, 9, 8, 8, 7, 6,
+    },
+    // 10 C
+    {
+        88, 85, 83, 81, 79, 77, 75, 73, 71, 69, 67, 66, 64, 62, 61, 59,
+        58, 56, 55, 53, 52, 51, 49, 48, 47, 46, 44, 43, 42, 41, 40, 39,
+        38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23,
+        23, 22, 21, 20, 19, 18, 18, 17, 16, 15, 15, 14, 13, 12, 12, 11,
+        10, 10, 9, 8, 8, 7, 6,
+    },
+    // 11 C
+    {
+        89, 86, 84, 82, 79, 77, 75, 73, 71, 70, 68, 66, 64, 63, 61, 60,
+        58, 57, 55, 54, 52, 51, 50, 48, 47, 46, 45, 44, 42, 41, 40, 39,
+        38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 24,
+        23, 22, 21, 20, 19, 19, 18, 17, 16, 16, 15, 14, 13, 13, 12, 11,
+        10, 10, 9, 8, 8, 7, 6,
+    },
+    // 12 C
+    {
+        89, 87, 84, 82, 80, 78, 76, 74, 72, 70, 68, 67, 65, 63, 62, 60,
+        59, 57, 56, 54, 53, 51, 50, 49, 48, 46, 45, 44, 43, 42, 40, 39,
+        38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 26, 25, 24,
+        23, 22, 21, 20, 20, 19, 18, 17, 16, 16, 15, 14, 13, 13, 12, 11,
+        10, 10, 9, 8, 8, 7, 6,
+    },
+    // 13 C
+    {
+        90, 87, 85, 83, 81, 78, 76, 74, 72, 71, 69, 67, 65, 64, 62, 61,
+        59, 57, 56, 55, 53, 52, 51, 49, 48, 47, 45, 44, 43, 42, 41, 40,
+        39, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 28, 27, 26, 25, 24,
+        23, 22, 21, 21, 20, 19, 18, 17, 17, 16, 15, 14, 13, 13, 12, 11,
+        11, 10, 9, 8, 8, 7, 6,
+    },
+    // 14 C
+    {
+        91, 88, 86, 83, 81, 79, 77, 75, 73, 71, 69, 68, 66, 64, 63, 61,
+        59, 58, 56, 55, 54, 52, 51, 50, 48, 47, 46, 45, 43, 42, 41, 40,
+        39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24,
+        23, 22, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14, 14, 13, 12, 11,
+        11, 10, 9, 9, 8, 7, 6,
+    },
+    // 15 C
+    {
+        91, 89, 86, 84, 82, 80, 78, 76, 74, 72, 70, 68, 66, 65, 63, 61,
+        60, 58, 57, 55, 54, 53, 51, 50, 49, 47, 46, 45, 44, 43, 41, 40,
+        39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24,
+        23, 23, 22, 21, 20, 19, 18, 18, 17, 16, 15, 14, 14, 13, 12, 11,
+        11, 10, 9, 9, 8, 7, 7,
+    },
+    // 16 C
+    {
+        92, 89, 87, 85, 82, 80, 78, 76, 74, 72, 70, 69, 67, 65, 63, 62,
+        60, 59, 57, 56, 54, 53, 52, 50, 49, 48, 47, 45, 44, 43, 42, 41,
+        39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 25,
+        24, 23, 22, 21, 20, 19, 19, 18, 17, 16, 15, 15, 14, 13, 12, 12,
+        11, 10, 9, 9, 8, 7, 7,
+    },
+    // 17 C
+    {
+        93, 90, 88, 85, 83, 81, 79, 77, 75, 73, 71, 69, 67, 66, 64, 62,
+        61, 59, 58, 56, 55, 53, 52, 51, 49, 48, 47, 46, 44, 43, 42, 41,
+        40, 39, 38, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 27, 26, 25,
+        24, 23, 22, 21, 20, 20, 19, 18, 17, 16, 15, 15, 14, 13, 12, 12,
+        11, 10, 9, 9, 8, 7, 7,
+    },
+    // 18 C
+    {
+        93, 91, 88, 86, 84, 81, 79, 77, 75, 73, 71, 70, 68, 66, 64, 63,
+        61, 60, 58, 57, 55, 54, 52, 51, 50, 48, 47, 46, 45, 44, 42, 41,
+        40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25,
+        24, 23, 22, 21, 21, 20, 19, 18, 17, 16, 16, 15, 14, 13, 12, 12,
+        11, 10, 10, 9, 8, 7, 7,
+    },
+    // 19 C
+    {
+        94, 91, 89, 87, 84, 82, 80, 78, 76, 74, 72, 70, 68, 67, 65, 63,
+        62, 60, 59, 57, 56, 54, 53, 51, 50, 49, 48, 46, 45, 44, 43, 41,
+        40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25,
+        24, 23, 22, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14, 13, 13, 12,
+        11, 10, 10, 9, 8, 7, 7,
+    },
+    // 20 C
+    {
+        95, 92, 90, 87, 85, 83, 80, 78, 76, 74, 72, 71, 69, 67, 65, 64,
+        62, 61, 59, 58, 56, 55, 53, 52, 51, 49, 48, 47, 45, 44, 43, 42,
+        41, 40, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25,
+        24, 23, 23, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14, 13, 13, 12,
+        11, 10, 10, 9, 8, 7, 7,
+    },
+    // 21 C
+    {
+        95, 93, 90, 88, 85, 83, 81, 79, 77, 75, 73, 71, 69, 68, 66, 64,
+        63, 61, 59, 58, 56, 55, 54, 52, 51, 50, 48, 47, 46, 45, 43, 42,
+        41, 40, 39, 38, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25,
+        25, 24, 23, 22, 21, 20, 19, 18, 18, 17, 16, 15, 14, 14, 13, 12,
+        11, 10, 10, 9, 8, 8, 7,
+    },
+    // 22 C
+    {
+        96, 93, 91, 88, 86, 84, 82, 79, 77, 75, 74, 72, 70, 68, 66, 65,
+        63, 61, 60, 58, 57, 55, 54, 53, 51, 50, 49, 47, 46, 45, 44, 42,
+        41, 40, 39, 38, 37, 36, 35, 34, 32, 31, 30, 29, 29, 28, 27, 26,
+        25, 24, 23, 22, 21, 20, 19, 19, 18, 17, 16, 15, 14, 14, 13, 12,
+        11, 11, 10, 9, 8, 8, 7,
+    },
+    // 23 C
+    {
+        97, 94, 92, 89, 87, 84, 82, 80, 78, 76, 74, 72, 70, 69, 67, 65,
+        64, 62, 60, 59, 57, 56, 54, 53, 52, 50, 49, 48, 46, 45, 44, 43,
+        42, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26,
+        25, 24, 23, 22, 21, 20, 20, 19, 18, 17, 16, 15, 15, 14, 13, 12,
+        11, 11, 10, 9, 8, 8, 7,
+    },
+    // 24 C
+    {
+        97, 95, 92, 90, 87, 85, 83, 81, 79, 77, 75, 73, 71, 69, 67, 66,
+        64, 62, 61, 59, 58, 56, 55, 53, 52, 51, 49, 48, 47, 46, 44, 43,
+        42, 41, 40, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26,
+        25, 24, 23, 22, 21, 21, 20, 19, 18, 17, 16, 15, 15, 14, 13, 12,
+        11, 11, 10, 9, 8, 8, 7,
+    },
+    // 25 C
+    {
+        98, 95, 93, 90, 88, 86, 83, 81, 79, 77, 75, 73, 71, 70, 68, 66,
+        64, 63, 61, 60, 58, 57, 55, 54, 52, 51, 50, 48, 47, 46, 45, 43,
+        42, 41, 40, 39, 38, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26,
+        25, 24, 23, 23, 22, 21, 20, 19, 18, 17, 16, 16, 15, 14, 13, 12,
+        12, 11, 10, 9, 9, 8, 7,
+    },
+    // 26 C
+    {
+        99, 96, 94, 91, 89, 86, 84, 82, 80, 78, 76, 74, 72, 70, 68, 67,
+        65, 63, 62, 60, 59, 57, 56, 54, 53, 51, 50, 49, 47, 46, 45, 44,
+        42, 41, 40, 39, 38, 37, 36, 35, 33, 32, 31, 30, 29, 28, 27, 26,
+        25, 25, 24, 23, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14, 13, 12,
+        12, 11, 10, 9, 9, 8, 7,
+    },
+    // 27 C
+    {
+        100, 97, 94, 92, 89, 87, 85, 82, 80, 78, 76, 74, 72, 71, 69, 67,
+        65, 64, 62, 61, 59, 58, 56, 55, 53, 52, 50, 49, 48, 47, 45, 44,
+        43, 42, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27,
+        26, 25, 24, 23, 22, 21, 20, 19, 18, 18, 17, 16, 15, 14, 13, 13,
+        12, 11, 10, 9, 9, 8, 7,
+    },
+    // 28 C
+    {
+        100, 97, 95, 92, 90, 87, 85, 83, 81, 79, 77, 75, 73, 71, 69, 68,
+        66, 64, 63, 61, 59, 58, 56, 55, 54, 52, 51, 49, 48, 47, 46, 44,
+        43, 42, 41, 40, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27,
+        26, 25, 24, 23, 22, 21, 20, 19, 19, 18, 17, 16, 15, 14, 13, 13,
+        12, 11, 10, 9, 9, 8, 7,
+    },
+    // 29 C
+    {
+        101, 98, 96, 93, 90, 88, 86, 84, 81, 79, 77, 75, 73, 72, 70, 68,
+        66, 65, 63, 61, 60, 58, 57, 55, 54, 53, 51, 50, 48, 47, 46, 45,
+        43, 42, 41, 40, 39, 38, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27,
+        26, 25, 24, 23, 22, 21, 20, 20, 19, 18, 17, 16, 15, 14, 14, 13,
+        12, 11, 10, 10, 9, 8, 7,
+    },
+    // 30 C
+    {
+        102, 99, 96, 94, 91, 89, 86, 84, 82, 80, 78, 76, 74, 72, 70, 69,
+        67, 65, 63, 62, 60, 59, 57, 56, 54, 53, 52, 50, 49, 48, 46, 45,
+        44, 43, 41, 40, 39, 38, 37, 36, 34, 33, 32, 31, 30, 29, 28, 27,
+        26, 25, 24, 23, 22, 21, 21, 20, 19, 18, 17, 16, 15, 14, 14, 13,
+        12, 11, 10, 10, 9, 8, 7,
+    },
+    // 31 C
+    {
+        102, 100, 97, 94, 92, 89, 87, 85, 83, 80, 78, 76, 75, 73, 71, 69,
+        67, 66, 64, 62, 61, 59, 58, 56, 55, 53, 52, 51, 49, 48, 47, 45,
+        44, 43, 42, 40, 39, 38, 37, 36, 35, 34, 33, 31, 30, 29, 28, 27,
+        26, 25, 24, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 15, 14, 13,
+        12, 11, 10, 10, 9, 8, 7,
+    },
+    // 32 C
+    {
+        103, 100, 98, 95, 92, 90, 88, 85, 83, 81, 79, 77, 75, 73, 71, 70,
+        68, 66, 64, 63, 61, 60, 58, 57, 55, 54, 52, 51, 50, 48, 47, 46,
+        44, 43, 42, 41, 40, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28,
+        27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 16, 15, 14, 13,
+        12, 11, 11, 10, 9, 8, 7,
+    },
+    // 33 C
+    {
+        104, 101, 98, 96, 93, 91, 88, 86, 84, 82, 80, 78, 76, 74, 72, 70,
+        68, 67, 65, 63, 62, 60, 58, 57, 56, 54, 53, 51, 50, 49, 47, 46,
+        45, 43, 42, 41, 40, 39, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28,
+        27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14, 13,
+        12, 11, 11, 10, 9, 8, 7,
+    },
+    // 34 C
+    {
+        105, 102, 99, 96, 94, 91, 89, 87, 84, 82, 80, 78, 76, 74, 72, 70,
+        69, 67, 65, 64, 62, 60, 59, 57, 56, 54, 53, 52, 50, 49, 48, 46,
+        45, 44, 42, 41, 40, 39, 38, 37, 35, 34, 33, 32, 31, 30, 29, 28,
+        27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 18, 17, 16, 15, 14, 13,
+        12, 12, 11, 10, 9, 8, 8,
+    },
+    // 35 C
+    {
+        105, 102, 100, 97, 94, 92, 89, 87, 85, 83, 81, 79, 77, 75, 73, 71,
+        69, 67, 66, 64, 62, 61, 59, 58, 56, 55, 53, 52, 51, 49, 48, 47,
+        45, 44, 43, 42, 40, 39, 38, 37, 36, 35, 33, 32, 31, 30, 29, 28,
+        27, 26, 25, 24, 23, 22, 21, 20, 19, 19, 18, 17, 16, 15, 14, 13,
+        12, 12, 11, 10, 9, 8, 8,
+    },
+    // 36 C
+    {
+        106, 103, 100, 98, 95, 92, 90, 88, 86, 83, 81, 79, 77, 75, 73, 71,
+        70, 68, 66, 65, 63, 61, 60, 58, 57, 55, 54, 52, 51, 50, 48, 47,
+        46, 44, 43, 42, 41, 39, 38, 37, 36, 35, 34, 33, 32, 30, 29, 28,
+        27, 26, 25, 24, 23, 22, 21, 21, 20, 19, 18, 17, 16, 15, 14, 13,
+        13, 12, 11, 10, 9, 8, 8,
+    },
+    // 37 C
+    {
+        107, 104, 101, 98, 96, 93, 91, 88, 86, 84, 82, 80, 78, 76, 74, 72,
+        70, 68, 67, 65, 63, 62, 60, 59, 57, 56, 54, 53, 51, 50, 49, 47,
+        46, 45, 43, 42, 41, 40, 39, 37, 36, 35, 34, 33, 32, 31, 30, 29,
+        28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13,
+        13, 12, 11, 10, 9, 8, 8,
+    },
+    // 38 C
+    {
+        107, 104, 102, 99, 96, 94, 91, 89, 87, 84, 82, 80, 78, 76, 74, 72,
+        71, 69, 67, 65, 64, 62, 61, 59, 57, 56, 55, 53, 52, 50, 49, 48,
+        46, 45, 44, 42, 41, 40, 39, 38, 36, 35, 34, 33, 32, 31, 30, 29,
+        28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 14,
+        13, 12, 11, 10, 9, 9, 8,
+    },
+    // 39 C
+    {
+        108, 105, 102, 100, 97, 94, 92, 90, 87, 85, 83, 81, 79, 77, 75, 73,
+        71, 69, 68, 66, 64, 63, 61, 59, 58, 56, 55, 53, 52, 51, 49, 48,
+        47, 45, 44, 43, 42, 40, 39, 38, 37, 36, 34, 33, 32, 31, 30, 29,
+        28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 15, 14,
+        13, 12, 11, 10, 9, 9, 8,
+    },
+    // 40 C
+    {
+        109, 106, 103, 100, 98, 95, 93, 90, 88, 86, 83, 81, 79, 77, 75, 73,
+        72, 70, 68, 66, 65, 63, 61, 60, 58, 57, 55, 54, 52, 51, 50, 48,
+        47, 46, 44, 43, 42, 41, 39, 38, 37, 36, 35, 34, 32, 31, 30, 29,
+        28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 16, 15, 14,
+        13, 12, 11, 10, 9, 9, 8,
+    },
+    // 41 C
+    {
+        110, 107, 104, 101, 98, 96, 93, 91, 88, 86, 84, 82, 80, 78, 76, 74,
+        72, 70, 69, 67, 65, 63, 62, 60, 59, 57, 56, 54, 53, 51, 50, 49,
+        47, 46, 45, 43, 42, 41, 40, 38, 37, 36, 35, 34, 33, 32, 30, 29,
+        28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 17, 16, 15, 14,
+        13, 12, 11, 10, 10, 9, 8,
+    },
+    // 42 C
+    {
+        110, 107, 104, 102, 99, 96, 94, 91, 89, 87, 85, 82, 80, 78, 76, 74,
+        73, 71, 69, 67, 66, 64, 62, 61, 59, 58, 56, 55, 53, 52, 50, 49,
+        48, 46, 45, 44, 42, 41, 40, 39, 38, 36, 35, 34, 33, 32, 31, 30,
+        29, 27, 26, 25, 24, 23, 22, 21, 20, 20, 19, 18, 17, 16, 15, 14,
+        13, 12, 11, 10, 10, 9, 8,
+    },
+    // 43 C
+    {
+        111, 108, 105, 102, 100, 97, 94, 92, 90, 87, 85, 83, 81, 79, 77, 75,
+        73, 71, 69, 68, 66, 64, 63, 61, 59, 58, 56, 55, 53, 52, 51, 49,
+        48, 47, 45, 44, 43, 41, 40, 39, 38, 37, 35, 34, 33, 32, 31, 30,
+        29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,
+        13, 12, 11, 11, 10, 9, 8,
+    },
+    // 44 C
+    {
+        112, 109, 106, 103, 100, 98, 95, 93, 90, 88, 86, 84, 81, 79, 77, 75,
+        74, 72, 70, 68, 66, 65, 63, 61, 60, 58, 57, 55, 54, 52, 51, 50,
+        48, 47, 46, 44, 43, 42, 40, 39, 38, 37, 36, 34, 33, 32, 31, 30,
+        29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,
+        13, 12, 11, 11, 10, 9, 8,
+    },
+    // 45 C
+    {
+        113, 109, 107, 104, 101, 98, 96, 93, 91, 89, 86, 84, 82, 80, 78, 76,
+        74, 72, 70, 69, 67, 65, 64, 62, 60, 59, 57, 56, 54, 53, 51, 50,
+        49, 47, 46, 45, 43, 42, 41, 39, 38, 37, 36, 35, 34, 32, 31, 30,
+        29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,
+        13, 12, 12, 11, 10, 9, 8,
+    },
+    // 46 C
+    {
+        113, 110, 107, 104, 102, 99, 96, 94, 91, 89, 87, 85, 83, 81, 78, 77,
+        75, 73, 71, 69, 67, 66, 64, 62, 61, 59, 58, 56, 55, 53, 52, 50,
+        49, 48, 46, 45, 44, 42, 41, 40, 39, 37, 36, 35, 34, 33, 32, 30,
+        29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,
+        13, 13, 12, 11, 10, 9, 8,
+    },
+    // 47 C
+    {
+        114, 111, 108, 105, 102, 100, 97, 95, 92, 90, 87, 85, 83, 81, 79, 77,
+        75, 73, 71, 70, 68, 66, 64, 63, 61, 60, 58, 56, 55, 53, 52, 51,
+        49, 48, 46, 45, 44, 43, 41, 40, 39, 38, 36, 35, 34, 33, 32, 31,
+        30, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14,
+        14, 13, 12, 11, 10, 9, 8,
+    },
+    // 48 C
+    {
+        115, 112, 109, 106, 103, 100, 98, 95, 93, 90, 88, 86, 84, 82, 80, 78,
+        76, 74, 72, 70, 68, 67, 65, 63, 62, 60, 58, 57, 55, 54, 52, 51,
+        50, 48, 47, 45, 44, 43, 42, 40, 39, 38, 37, 35, 34, 33, 32, 31,
+        30, 29, 28, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 15,
+        14, 13, 12, 11, 10, 9, 8,
+    },
+    // 49 C
+    {
+        116, 112, 109, 106, 104, 101, 98, 96, 93, 91, 89, 86, 84, 82, 80, 78,
+        76, 74, 72, 71, 69, 67, 65, 64, 62, 60, 59, 57, 56, 54, 53, 51,
+        50, 48, 47, 46, 44, 43, 42, 41, 39, 38, 37, 36, 35, 33, 32, 31,
+        30, 29, 28, 27, 26, 25, 24, 22, 21, 20, 19, 18, 18, 17, 16, 15,
+        14, 13, 12, 11, 10, 9, 8,
+    },
+    // 50 C
+    {
+        116, 113, 110, 107, 104, 102, 99, 96, 94, 92, 89, 87, 85, 83, 81, 79,
+        77, 75, 73, 71, 69, 67, 66, 64, 62, 61, 59, 58, 56, 55, 53, 52,
+        50, 49, 47, 46, 45, 43, 42, 41, 40, 38, 37, 36, 35, 34, 32, 31,
+        30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15,
+        14, 13, 12, 11, 10, 9, 8,
+    },
+};
+
+const uint16_t dht11_psychro_saturation_density[DHT11_PSYCHRO_TEMPS] = {
+    485, 519, 556, 595, 636, 679, 725, 774, 826, 881, 938, 1000,
+    1064, 1132, 1204, 1280, 1360, 1444, 1533, 1626, 1725, 1828, 1937, 2051,
+    2171, 2297, 2430, 2568, 2714, 2867, 3027, 3195, 3370, 3554, 3747, 3948,
+    4158, 4378, 4608, 4848, 5099, 5361, 5634, 5919, 6216, 6526, 6849, 7185,
+    7536, 7900, 8280,
+};
@@ -0,0 +1,32 @@
+/**
+ * @file psychro_tables.h
+ * @brief Precomputed psychrometric tables
+ * 
+ * Generated by tools/psychro_tables.py, do not edit.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define DHT11_PSYCHRO_TEMP_MIN 0
+#define DHT11_PSYCHRO_TEMP_MAX 50
+#define DHT11_PSYCHRO_HUMIDITY_MIN 20
+#define DHT11_PSYCHRO_HUMIDITY_MAX 90
+#define DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN 27
+#define DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN 40
+#define DHT11_PSYCHRO_DEW_POINT_SCALE 4
+
+#define DHT11_PSYCHRO_TEMPS (DHT11_PSYCHRO_TEMP_MAX - DHT11_PSYCHRO_TEMP_MIN + 1)
+#define DHT11_PSYCHRO_HUMIDITIES (DHT11_PSYCHRO_HUMIDITY_MAX - DHT11_PSYCHRO_HUMIDITY_MIN + 1)
+#define DHT11_PSYCHRO_HEAT_INDEX_TEMPS (DHT11_PSYCHRO_TEMP_MAX - DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN + 1)
+#define DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES (DHT11_PSYCHRO_HUMIDITY_MAX - DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN + 1)
+
+/** @brief Heat index in tenths of a degree Celsius, where NOAA applies */
+extern const uint16_t dht11_psychro_heat_index[DHT11_PSYCHRO_HEAT_INDEX_TEMPS][DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES];
+
+/** @brief Temperature minus dew point, in steps of 1/DHT11_PSYCHRO_DEW_POINT_SCALE degree */
+extern const uint8_t dht11_psychro_dew_point_depression[DHT11_PSYCHRO_TEMPS][DHT11_PSYCHRO_HUMIDITIES];
+
+/** @brief Saturation vapour density in hundredths of g/m^3 */
+extern const uint16_t dht11_psychro_saturation_density[DHT11_PSYCHRO_TEMPS];
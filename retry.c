@@ -0,0 +1,39 @@
+/**
+ * @file retry.c
+ * @brief Retry and backoff policy implementation
+ */
+
+#include "retry.h"
+#include <furi.h>
+
+void dht11_retry_reset(DHT11Retry* retry) {
+    memset(retry, 0, sizeof(DHT11Retry));
+}
+
+uint32_t dht11_retry_record(DHT11Retry* retry, DHT11Status status, uint32_t period, uint32_t min_interval) {
+    retry->delay = 0;
+    
+    if(status == DHT11StatusOk) {
+        retry->quick_retries = 0;
+        retry->silent = 0;
+    } else if(status == DHT11StatusNoResponse) {
+        // A single miss may be a loose contact; back off from the second one
+        retry->quick_retries = 0;
+        if(retry->silent < UINT8_MAX) {
+            retry->silent++;
+        }
+        if(retry->silent > 1) {
+            uint32_t limit = MAX(furi_ms_to_ticks(DHT11_RETRY_BACKOFF_MAX_MS), period);
+            uint8_t shift = MIN(retry->silent - 1, 16);
+            retry->delay = period > (limit >> shift) ? limit : period << shift;
+        }
+    } else {
+        retry->silent = 0;
+        if(retry->quick_retries < DHT11_RETRY_QUICK_LIMIT) {
+            retry->quick_retries++;
+            retry->delay = min_interval;
+        }
+    }
+    
+    return retry->delay;
+}
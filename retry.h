@@ -0,0 +1,50 @@
+/**
+ * @file retry.h
+ * @brief Retry and backoff policy for failed reads
+ * 
+ * Failures fall into two groups. A garbled transfer (bad response timing,
+ * a missing bit, checksum or range error) means a sensor is there and
+ * merely had a bad moment, so it is retried as soon as its minimum
+ * interval allows instead of waiting a whole period, a few times in a
+ * row at most. No response at all usually means nothing is plugged in,
+ * and every further silent read doubles the time until the next attempt
+ * so dead pins do not keep the bus and the battery busy.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "decoder.h"
+
+/** @brief Quick retries after garbled transfers before falling back to the period */
+#define DHT11_RETRY_QUICK_LIMIT 2
+
+/** @brief Longest time between attempts on a sensor that does not answer */
+#define DHT11_RETRY_BACKOFF_MAX_MS (5 * 60 * 1000)
+
+/**
+ * @brief Retry state of one sensor
+ */
+typedef struct {
+    uint8_t quick_retries;      /**< Quick retries since the last good or silent read */
+    uint8_t silent;             /**< Consecutive reads without a response */
+    uint32_t delay;             /**< Ticks until the next attempt, 0 for the regular period */
+} DHT11Retry;
+
+/**
+ * @brief Clear the retry state
+ * 
+ * @param retry Pointer to the retry state
+ */
+void dht11_retry_reset(DHT11Retry* retry);
+
+/**
+ * @brief Account for a read and decide when to try next
+ * 
+ * @param retry Pointer to the retry state
+ * @param status Outcome of the read
+ * @param period Regular read period in ticks
+ * @param min_interval Sensor's minimum interval between reads in ticks
+ * @return Ticks until the next attempt, or 0 to keep the regular schedule
+ */
+uint32_t dht11_retry_record(DHT11Retry* retry, DHT11Status status, uint32_t period, uint32_t min_interval);
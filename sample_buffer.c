@@ -0,0 +1,93 @@
+/**
+ * @file sample_buffer.c
+ * @brief Lock-free sample ring buffer implementation
+ * 
+ * The producer fills a slot and only then publishes it by advancing head.
+ * Readers copy a slot and then re-check head: if the producer has wrapped
+ * around onto that slot in the meantime, the copy is discarded.
+ */
+
+#include "sample_buffer.h"
+#include <string.h>
+
+#define DHT11_SAMPLE_BUFFER_MASK (DHT11_SAMPLE_BUFFER_SIZE - 1)
+
+_Static_assert(
+    (DHT11_SAMPLE_BUFFER_SIZE & DHT11_SAMPLE_BUFFER_MASK) == 0,
+    "DHT11_SAMPLE_BUFFER_SIZE must be a power of two");
+
+/**
+ * @brief Copy a slot if it still holds the requested sequence
+ * 
+ * @param buffer Pointer to the sample buffer
+ * @param sequence Sequence number to copy
+ * @param sample Output for the sample
+ * @return true if the copy is consistent
+ */
+static bool dht11_sample_buffer_copy(const DHT11SampleBuffer* buffer, uint32_t sequence, DHT11Sample* sample) {
+    memcpy(sample, &buffer->slots[sequence & DHT11_SAMPLE_BUFFER_MASK], sizeof(DHT11Sample));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    
+    // The producer may be rewriting this slot once head reaches sequence + SIZE
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED);
+    return (head - sequence) < DHT11_SAMPLE_BUFFER_SIZE && sample->sequence == sequence;
+}
+
+void dht11_sample_buffer_reset(DHT11SampleBuffer* buffer) {
+    memset(buffer, 0, sizeof(DHT11SampleBuffer));
+}
+
+void dht11_sample_buffer_push(DHT11SampleBuffer* buffer, const DHT11Sample* sample) {
+    uint32_t head = buffer->head;
+    DHT11Sample* slot = &buffer->slots[head & DHT11_SAMPLE_BUFFER_MASK];
+    
+    memcpy(slot, sample, sizeof(DHT11Sample));
+    slot->sequence = head;
+    
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+bool dht11_sample_buffer_latest(const DHT11SampleBuffer* buffer, DHT11Sample* sample) {
+    while(true) {
+        uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+        if(head == 0) {
+            return false;
+        }
+        if(dht11_sample_buffer_copy(buffer, head - 1, sample)) {
+            return true;
+        }
+    }
+}
+
+bool dht11_sample_buffer_latest_for(const DHT11SampleBuffer* buffer, uint8_t sensor, DHT11Sample* sample) {
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    uint32_t oldest = head > DHT11_SAMPLE_BUFFER_SIZE ? head - DHT11_SAMPLE_BUFFER_SIZE : 0;
+    
+    // Walk back from the newest sample; entries lost to a wrap-around are skipped
+    for(uint32_t sequence = head; sequence > oldest; sequence--) {
+        if(dht11_sample_buffer_copy(buffer, sequence - 1, sample) && sample->sensor == sensor) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool dht11_sample_buffer_read(const DHT11SampleBuffer* buffer, uint32_t* cursor, DHT11Sample* sample) {
+    while(true) {
+        uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+        if(*cursor == head) {
+            return false;
+        }
+        
+        // Skip samples that have already been overwritten
+        if(head - *cursor > DHT11_SAMPLE_BUFFER_SIZE) {
+            *cursor = head - DHT11_SAMPLE_BUFFER_SIZE;
+        }
+        
+        if(dht11_sample_buffer_copy(buffer, *cursor, sample)) {
+            *cursor += 1;
+            return true;
+        }
+    }
+}
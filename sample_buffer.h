@@ -0,0 +1,90 @@
+/**
+ * @file sample_buffer.h
+ * @brief Fixed-size lock-free ring buffer of sensor samples
+ * 
+ * Written by a single producer (the acquisition thread) and read by any
+ * number of consumers without locks. When full, the oldest samples are
+ * overwritten; readers detect this and skip ahead.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Number of samples kept, must be a power of two */
+#define DHT11_SAMPLE_BUFFER_SIZE 32
+
+/**
+ * @brief A single timestamped sensor reading
+ */
+typedef struct {
+    uint32_t sequence;      /**< Position in the stream, assigned on push */
+    uint32_t tick;          /**< System tick at which the reading was taken */
+    int16_t temperature;    /**< Temperature in tenths of a degree Celsius, valid if ok */
+    uint16_t humidity;      /**< Relative humidity in tenths of a percent, valid if ok */
+    uint8_t sensor;         /**< Index of the sensor in DHT11App.sensors */
+    bool ok;                /**< Flag indicating the read succeeded */
+    uint8_t status;         /**< DHT11Status of the read */
+    uint8_t failed_bit;     /**< Bit that did not start, for DHT11StatusBitTimeout */
+    uint8_t recovered_bits; /**< Bits flipped to pass the checksum, 0 if none */
+} DHT11Sample;
+
+/**
+ * @brief Sample ring buffer
+ */
+typedef struct {
+    DHT11Sample slots[DHT11_SAMPLE_BUFFER_SIZE];   /**< Sample storage */
+    volatile uint32_t head;                         /**< Number of samples ever pushed */
+} DHT11SampleBuffer;
+
+/**
+ * @brief Empty the buffer
+ * 
+ * Must not be called while the producer or a reader is active.
+ * 
+ * @param buffer Pointer to the sample buffer
+ */
+void dht11_sample_buffer_reset(DHT11SampleBuffer* buffer);
+
+/**
+ * @brief Append a sample, overwriting the oldest one when full
+ * 
+ * Only the producer thread may call this.
+ * 
+ * @param buffer Pointer to the sample buffer
+ * @param sample Sample to append; its sequence field is ignored
+ */
+void dht11_sample_buffer_push(DHT11SampleBuffer* buffer, const DHT11Sample* sample);
+
+/**
+ * @brief Copy the most recent sample
+ * 
+ * @param buffer Pointer to the sample buffer
+ * @param sample Output for the newest sample
+ * @return true if a sample was available
+ */
+bool dht11_sample_buffer_latest(const DHT11SampleBuffer* buffer, DHT11Sample* sample);
+
+/**
+ * @brief Copy the most recent sample of one sensor
+ * 
+ * @param buffer Pointer to the sample buffer
+ * @param sensor Sensor index to look for
+ * @param sample Output for the newest sample of that sensor
+ * @return true if the buffer holds a sample of that sensor
+ */
+bool dht11_sample_buffer_latest_for(const DHT11SampleBuffer* buffer, uint8_t sensor, DHT11Sample* sample);
+
+/**
+ * @brief Copy the next unread sample for a consumer
+ * 
+ * Each consumer keeps its own cursor, initialized to 0 or to the current
+ * head. Samples overwritten before the consumer got to them are skipped.
+ * 
+ * @param buffer Pointer to the sample buffer
+ * @param cursor Consumer cursor, advanced past the returned sample
+ * @param sample Output for the next sample
+ * @return true if a sample was returned, false if the consumer is up to date
+ */
+bool dht11_sample_buffer_read(const DHT11SampleBuffer* buffer, uint32_t* cursor, DHT11Sample* sample);
@@ -0,0 +1,179 @@
+/**
+ * @file scene_views.c
+ * @brief Per-scene view registry implementation
+ */
+
+#include "scene_views.h"
+#include "stats_scene.h"
+#include "benchmark_scene.h"
+
+/**
+ * @brief How one scene's view is allocated and freed
+ */
+typedef struct {
+    View* (*alloc)(DHT11App* app);  /**< Allocate the view and its buffers, return the view */
+    void (*free)(DHT11App* app);    /**< Free everything alloc allocated */
+    bool resident;                  /**< Keep the view once allocated */
+} DHT11SceneView;
+
+// Allocation and release of each scene's view, in DHT11Scene order
+
+static View* dht11_scene_views_main_menu_alloc(DHT11App* app) {
+    app->submenu = submenu_alloc();
+    return submenu_get_view(app->submenu);
+}
+
+static void dht11_scene_views_main_menu_free(DHT11App* app) {
+    submenu_free(app->submenu);
+    app->submenu = NULL;
+}
+
+static View* dht11_scene_views_read_sensor_alloc(DHT11App* app) {
+    app->sensor_view = dht11_sensor_view_alloc();
+    return dht11_sensor_view_get_view(app->sensor_view);
+}
+
+static void dht11_scene_views_read_sensor_free(DHT11App* app) {
+    dht11_sensor_view_free(app->sensor_view);
+    app->sensor_view = NULL;
+}
+
+static View* dht11_scene_views_about_alloc(DHT11App* app) {
+    app->about_text_box = text_box_alloc();
+    return text_box_get_view(app->about_text_box);
+}
+
+static void dht11_scene_views_about_free(DHT11App* app) {
+    text_box_free(app->about_text_box);
+    app->about_text_box = NULL;
+}
+
+static View* dht11_scene_views_debug_alloc(DHT11App* app) {
+    app->debug_text_box = text_box_alloc();
+    app->debug_text = furi_string_alloc();
+    return text_box_get_view(app->debug_text_box);
+}
+
+static void dht11_scene_views_debug_free(DHT11App* app) {
+    text_box_free(app->debug_text_box);
+    furi_string_free(app->debug_text);
+    app->debug_text_box = NULL;
+    app->debug_text = NULL;
+}
+
+static View* dht11_scene_views_stats_alloc(DHT11App* app) {
+    app->stats_text_box = text_box_alloc();
+    app->stats_text = malloc(DHT11_STATS_TEXT_SIZE);
+    app->stats_text[0] = '\0';
+    return text_box_get_view(app->stats_text_box);
+}
+
+static void dht11_scene_views_stats_free(DHT11App* app) {
+    text_box_free(app->stats_text_box);
+    free(app->stats_text);
+    app->stats_text_box = NULL;
+    app->stats_text = NULL;
+}
+
+static View* dht11_scene_views_graph_alloc(DHT11App* app) {
+    app->graph_view = dht11_graph_view_alloc(app->history);
+    return dht11_graph_view_get_view(app->graph_view);
+}
+
+static void dht11_scene_views_graph_free(DHT11App* app) {
+    dht11_graph_view_free(app->graph_view);
+    app->graph_view = NULL;
+}
+
+static View* dht11_scene_views_low_power_alloc(DHT11App* app) {
+    app->low_power_view = dht11_low_power_view_alloc();
+    return dht11_low_power_view_get_view(app->low_power_view);
+}
+
+static void dht11_scene_views_low_power_free(DHT11App* app) {
+    dht11_low_power_view_free(app->low_power_view);
+    app->low_power_view = NULL;
+}
+
+static View* dht11_scene_views_settings_alloc(DHT11App* app) {
+    app->settings_list = variable_item_list_alloc();
+    return variable_item_list_get_view(app->settings_list);
+}
+
+static void dht11_scene_views_settings_free(DHT11App* app) {
+    variable_item_list_free(app->settings_list);
+    app->settings_list = NULL;
+}
+
+static View* dht11_scene_views_benchmark_alloc(DHT11App* app) {
+    app->benchmark_text_box = text_box_alloc();
+    app->benchmark_text = malloc(DHT11_BENCHMARK_TEXT_SIZE);
+    app->benchmark_text[0] = '\0';
+    return text_box_get_view(app->benchmark_text_box);
+}
+
+static void dht11_scene_views_benchmark_free(DHT11App* app) {
+    text_box_free(app->benchmark_text_box);
+    free(app->benchmark_text);
+    app->benchmark_text_box = NULL;
+    app->benchmark_text = NULL;
+}
+
+/**
+ * @brief Registry, indexed by DHT11Scene
+ * 
+ * The menu, the reading and the graph keep their selection and are
+ * visited often; the text screens and lists are rebuilt on every visit
+ * anyway and are freed when left.
+ */
+static const DHT11SceneView dht11_scene_views[DHT11SceneCount] = {
+    [DHT11SceneMainMenu] = {dht11_scene_views_main_menu_alloc, dht11_scene_views_main_menu_free, true},
+    [DHT11SceneReadSensor] = {dht11_scene_views_read_sensor_alloc, dht11_scene_views_read_sensor_free, true},
+    [DHT11SceneAbout] = {dht11_scene_views_about_alloc, dht11_scene_views_about_free, false},
+    [DHT11SceneDebug] = {dht11_scene_views_debug_alloc, dht11_scene_views_debug_free, false},
+    [DHT11SceneStats] = {dht11_scene_views_stats_alloc, dht11_scene_views_stats_free, false},
+    [DHT11SceneGraph] = {dht11_scene_views_graph_alloc, dht11_scene_views_graph_free, true},
+    [DHT11SceneLowPower] = {dht11_scene_views_low_power_alloc, dht11_scene_views_low_power_free, false},
+    [DHT11SceneSettings] = {dht11_scene_views_settings_alloc, dht11_scene_views_settings_free, false},
+    [DHT11SceneBenchmark] = {dht11_scene_views_benchmark_alloc, dht11_scene_views_benchmark_free, false},
+};
+
+void dht11_scene_view_acquire(DHT11App* app, DHT11Scene scene) {
+    furi_check(scene < DHT11SceneCount);
+    
+    if(app->scene_views & (1 << scene)) {
+        return;
+    }
+    
+    View* view = dht11_scene_views[scene].alloc(app);
+    view_dispatcher_add_view(app->view_dispatcher, scene, view);
+    app->scene_views |= (1 << scene);
+}
+
+/**
+ * @brief Remove a scene's view from the dispatcher and free it
+ * 
+ * @param app Pointer to the application instance
+ * @param scene Scene whose view is allocated
+ */
+static void dht11_scene_view_free(DHT11App* app, DHT11Scene scene) {
+    view_dispatcher_remove_view(app->view_dispatcher, scene);
+    dht11_scene_views[scene].free(app);
+    app->scene_views &= ~(1 << scene);
+}
+
+void dht11_scene_view_release(DHT11App* app, DHT11Scene scene) {
+    furi_check(scene < DHT11SceneCount);
+    
+    if((app->scene_views & (1 << scene)) && !dht11_scene_views[scene].resident) {
+        dht11_scene_view_free(app, scene);
+    }
+}
+
+void dht11_scene_views_free(DHT11App* app) {
+    for(uint8_t scene = 0; scene < DHT11SceneCount; scene++) {
+        if(app->scene_views & (1 << scene)) {
+            dht11_scene_view_free(app, scene);
+        }
+    }
+}
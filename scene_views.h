@@ -0,0 +1,43 @@
+/**
+ * @file scene_views.h
+ * @brief Per-scene view registry
+ * 
+ * Nothing is allocated for a scene at launch. A scene's view and the
+ * buffers behind it are allocated on its first on_enter and added to
+ * the view dispatcher under the scene's id. Views that keep a selection
+ * worth coming back to stay resident afterwards; the heavy, stateless
+ * ones are removed and freed again on on_exit. Startup time and the
+ * resident heap therefore stay flat as scenes are added.
+ */
+
+#pragma once
+
+#include "app.h"
+
+/**
+ * @brief Make sure a scene's view is allocated and added to the dispatcher
+ * 
+ * Call first thing in on_enter.
+ * 
+ * @param app Pointer to the application instance
+ * @param scene Scene being entered
+ */
+void dht11_scene_view_acquire(DHT11App* app, DHT11Scene scene);
+
+/**
+ * @brief Free a scene's view unless it is resident
+ * 
+ * Call last thing in on_exit. Removing the current view is fine: the
+ * next scene switches to its own view straight after.
+ * 
+ * @param app Pointer to the application instance
+ * @param scene Scene being left
+ */
+void dht11_scene_view_release(DHT11App* app, DHT11Scene scene);
+
+/**
+ * @brief Remove and free every view still allocated
+ * 
+ * @param app Pointer to the application instance
+ */
+void dht11_scene_views_free(DHT11App* app);
@@ -12,6 +12,11 @@ void (*const dht11_on_enter_handlers[])(void*) = {
     [DHT11SceneReadSensor] = dht11_scene_read_sensor_on_enter,
     [DHT11SceneAbout] = dht11_scene_about_on_enter,
     [DHT11SceneDebug] = dht11_scene_debug_on_enter,
+    [DHT11SceneStats] = dht11_scene_stats_on_enter,
+    [DHT11SceneGraph] = dht11_scene_graph_on_enter,
+    [DHT11SceneLowPower] = dht11_scene_low_power_on_enter,
+    [DHT11SceneSettings] = dht11_scene_settings_on_enter,
+    [DHT11SceneBenchmark] = dht11_scene_benchmark_on_enter,
 };
 
 // Scene on_event handlers
@@ -20,6 +25,11 @@ bool (*const dht11_on_event_handlers[])(void*, SceneManagerEvent) = {
     [DHT11SceneReadSensor] = dht11_scene_read_sensor_on_event,
     [DHT11SceneAbout] = dht11_scene_about_on_event,
     [DHT11SceneDebug] = dht11_scene_debug_on_event,
+    [DHT11SceneStats] = dht11_scene_stats_on_event,
+    [DHT11SceneGraph] = dht11_scene_graph_on_event,
+    [DHT11SceneLowPower] = dht11_scene_low_power_on_event,
+    [DHT11SceneSettings] = dht11_scene_settings_on_event,
+    [DHT11SceneBenchmark] = dht11_scene_benchmark_on_event,
 };
 
 // Scene on_exit handlers
@@ -28,6 +38,11 @@ void (*const dht11_on_exit_handlers[])(void*) = {
     [DHT11SceneReadSensor] = dht11_scene_read_sensor_on_exit,
     [DHT11SceneAbout] = dht11_scene_about_on_exit,
     [DHT11SceneDebug] = dht11_scene_debug_on_exit,
+    [DHT11SceneStats] = dht11_scene_stats_on_exit,
+    [DHT11SceneGraph] = dht11_scene_graph_on_exit,
+    [DHT11SceneLowPower] = dht11_scene_low_power_on_exit,
+    [DHT11SceneSettings] = dht11_scene_settings_on_exit,
+    [DHT11SceneBenchmark] = dht11_scene_benchmark_on_exit,
 };
 
 // Scene handler table for Flipper's scene manager
@@ -34,3 +34,23 @@ void dht11_scene_about_on_exit(void* context);
 void dht11_scene_debug_on_enter(void* context);
 bool dht11_scene_debug_on_event(void* context, SceneManagerEvent event);
 void dht11_scene_debug_on_exit(void* context);
+
+void dht11_scene_stats_on_enter(void* context);
+bool dht11_scene_stats_on_event(void* context, SceneManagerEvent event);
+void dht11_scene_stats_on_exit(void* context);
+
+void dht11_scene_graph_on_enter(void* context);
+bool dht11_scene_graph_on_event(void* context, SceneManagerEvent event);
+void dht11_scene_graph_on_exit(void* context);
+
+void dht11_scene_low_power_on_enter(void* context);
+bool dht11_scene_low_power_on_event(void* context, SceneManagerEvent event);
+void dht11_scene_low_power_on_exit(void* context);
+
+void dht11_scene_settings_on_enter(void* context);
+bool dht11_scene_settings_on_event(void* context, SceneManagerEvent event);
+void dht11_scene_settings_on_exit(void* context);
+
+void dht11_scene_benchmark_on_enter(void* context);
+bool dht11_scene_benchmark_on_event(void* context, SceneManagerEvent event);
+void dht11_scene_benchmark_on_exit(void* context);
@@ -0,0 +1,93 @@
+/**
+ * @file scheduler.c
+ * @brief Interleaved round-robin read scheduler implementation
+ * 
+ * Tick arithmetic is done on wrapping differences so the scheduler keeps
+ * working across tick counter overflow.
+ */
+
+#include "scheduler.h"
+#include <string.h>
+
+void dht11_scheduler_init(
+    DHT11Scheduler* scheduler,
+    uint8_t count,
+    uint32_t period,
+    const uint32_t* min_intervals,
+    uint32_t now,
+    bool stagger) {
+    memset(scheduler, 0, sizeof(DHT11Scheduler));
+    scheduler->count = count > DHT11_SCHEDULER_MAX_SENSORS ? DHT11_SCHEDULER_MAX_SENSORS : count;
+    scheduler->period = period;
+    
+    // Spread the first reads evenly over one period
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        scheduler->min_interval[i] = min_intervals[i];
+        scheduler->next_due[i] = stagger ? now + (period * i) / scheduler->count : now;
+        scheduler->last_read[i] = now - min_intervals[i];
+    }
+}
+
+uint8_t dht11_scheduler_next(const DHT11Scheduler* scheduler, uint32_t* due) {
+    uint8_t next = 0;
+    
+    for(uint8_t i = 1; i < scheduler->count; i++) {
+        if((int32_t)(scheduler->next_due[i] - scheduler->next_due[next]) < 0) {
+            next = i;
+        }
+    }
+    
+    *due = scheduler->next_due[next];
+    return next;
+}
+
+uint8_t dht11_scheduler_due_mask(const DHT11Scheduler* scheduler, uint32_t now) {
+    uint8_t mask = 0;
+    
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        if((int32_t)(scheduler->next_due[i] - now) <= 0) {
+            mask |= (1 << i);
+        }
+    }
+    
+    return mask;
+}
+
+void dht11_scheduler_complete(DHT11Scheduler* scheduler, uint8_t index, uint32_t started) {
+    uint32_t next = scheduler->next_due[index] + scheduler->period;
+    uint32_t earliest = started + scheduler->min_interval[index];
+    
+    // Keep the slot in phase when on time; re-anchor after falling a period behind
+    if((int32_t)(next - started) <= 0) {
+        next = started + scheduler->period;
+    }
+    
+    // Never read the sensor sooner than its minimum interval
+    if((int32_t)(next - earliest) < 0) {
+        next = earliest;
+    }
+    
+    scheduler->last_read[index] = started;
+    scheduler->next_due[index] = next;
+}
+
+void dht11_scheduler_defer(DHT11Scheduler* scheduler, uint8_t index, uint32_t started, uint32_t delay) {
+    scheduler->last_read[index] = started;
+    uint32_t min_interval = scheduler->min_interval[index];
+    scheduler->next_due[index] = started + (delay > min_interval ? delay : min_interval);
+}
+
+void dht11_scheduler_postpone(DHT11Scheduler* scheduler, uint8_t index, uint32_t now, uint32_t delay) {
+    scheduler->next_due[index] = now + delay;
+}
+
+void dht11_scheduler_trigger(DHT11Scheduler* scheduler, uint32_t now) {
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        uint32_t earliest = scheduler->last_read[i] + scheduler->min_interval[i];
+        scheduler->next_due[i] = (int32_t)(earliest - now) > 0 ? earliest : now;
+    }
+}
+
+void dht11_scheduler_set_period(DHT11Scheduler* scheduler, uint32_t period) {
+    scheduler->period = period;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file scheduler.h
+ * @brief Interleaved round-robin read scheduler for multiple sensors
+ * 
+ * Every sensor is read once per period, with the sensors' deadlines spread
+ * evenly across the period. Each sensor individually respects its own
+ * minimum interval between transactions, so total throughput grows with the number
+ * of sensors instead of being serialized behind a single cooldown.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Maximum number of sensors handled by the scheduler */
+#define DHT11_SCHEDULER_MAX_SENSORS 8
+
+/**
+ * @brief Scheduler state, all times in system ticks
+ */
+typedef struct {
+    uint8_t count;                                      /**< Number of scheduled sensors */
+    uint32_t period;                                    /**< Read period of each sensor */
+    uint32_t min_interval[DHT11_SCHEDULER_MAX_SENSORS]; /**< Minimum time between reads of each sensor */
+    uint32_t next_due[DHT11_SCHEDULER_MAX_SENSORS];     /**< Next deadline of each sensor */
+    uint32_t last_read[DHT11_SCHEDULER_MAX_SENSORS];    /**< Start of each sensor's last read */
+} DHT11Scheduler;
+
+/**
+ * @brief Initialize the scheduler
+ * 
+ * With stagger set, the first deadlines are spread evenly over one
+ * period so reads interleave; otherwise all sensors fall due together
+ * and can be read as one batch.
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param count Number of sensors, at most DHT11_SCHEDULER_MAX_SENSORS
+ * @param period Read period of each sensor
+ * @param min_intervals Minimum time between two reads of each sensor
+ * @param now Current tick
+ * @param stagger Interleave the sensors' deadlines
+ */
+void dht11_scheduler_init(
+    DHT11Scheduler* scheduler,
+    uint8_t count,
+    uint32_t period,
+    const uint32_t* min_intervals,
+    uint32_t now,
+    bool stagger);
+
+/**
+ * @brief Find the sensor with the earliest deadline
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param due Output for that sensor's deadline
+ * @return Index of the sensor to read next
+ */
+uint8_t dht11_scheduler_next(const DHT11Scheduler* scheduler, uint32_t* due);
+
+/**
+ * @brief Collect every sensor whose deadline has passed
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param now Current tick
+ * @return Bit mask of sensor indices that are due
+ */
+uint8_t dht11_scheduler_due_mask(const DHT11Scheduler* scheduler, uint32_t now);
+
+/**
+ * @brief Record that a sensor has been read and schedule its next read
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param index Sensor that was read
+ * @param started Tick at which the read started
+ */
+void dht11_scheduler_complete(DHT11Scheduler* scheduler, uint8_t index, uint32_t started);
+
+/**
+ * @brief Record a read and schedule the next one after a fixed delay
+ * 
+ * Used instead of dht11_scheduler_complete() for retries and backoff; the
+ * sensor leaves its slot in the period and is re-anchored on the delay.
+ * Never earlier than the sensor's minimum interval.
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param index Sensor that was read
+ * @param started Tick at which the read started
+ * @param delay Ticks from started until the next read
+ */
+void dht11_scheduler_defer(DHT11Scheduler* scheduler, uint8_t index, uint32_t started, uint32_t delay);
+
+/**
+ * @brief Move a sensor's deadline without recording a read
+ * 
+ * Used when a due sensor stayed off the bus because its previous
+ * transaction was too recent, so it is tried again once it may be read
+ * rather than a whole period later.
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param index Sensor that was not read
+ * @param now Current tick
+ * @param delay Ticks from now until the next attempt
+ */
+void dht11_scheduler_postpone(DHT11Scheduler* scheduler, uint8_t index, uint32_t now, uint32_t delay);
+
+/**
+ * @brief Bring every sensor's deadline forward to the earliest allowed time
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param now Current tick
+ */
+void dht11_scheduler_trigger(DHT11Scheduler* scheduler, uint32_t now);
+
+/**
+ * @brief Change the read period
+ * 
+ * Takes effect as each sensor completes its next read.
+ * 
+ * @param scheduler Pointer to the scheduler state
+ * @param period New read period of each sensor
+ */
+void dht11_scheduler_set_period(DHT11Scheduler* scheduler, uint32_t period);
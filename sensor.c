@@ -5,349 +5,482 @@
  * @date 2025
  * @version 1.0.0
  * 
- * Professional DHT11 sensor driver with high-precision timing using DWT cycle counter.
- * Implements the complete DHT11 communication protocol with comprehensive error handling
- * and debug logging capabilities.
+ * App-side layer over the handle-based driver in driver.c. Every attached
+ * sensor owns a driver handle; this file configures the handles from the
+ * settings and attaches what the app wants around each transaction
+ * through the driver's hooks.
  * 
  * Key features:
- * - Microsecond-precision timing using DWT cycle counter
- * - Comprehensive error handling and validation
- * - Debug mode with detailed protocol analysis
- * - Temperature range validation and checksum verification
+ * - DHT11, DHT22/AM2302 and DHT21/AM2301 on the same read engine, the
+ *   family being a per-handle descriptor used only around the transfer
+ * - Selectable read backend: polling or interrupt-driven edge capture
+ * - Batch reads of several sensors sharing one start pulse and one
+ *   sampling window per GPIO port
+ * - Single read core shared by normal and debug reads; debug reads are
+ *   recorded as compact events after the transfer and formatted on display
+ * - Read LED and sensor supply switched from the indicator hook, outside
+ *   the timed section
+ * - Learned bit thresholds kept on the SD card between sessions
+ * - Instrumentation, edge traces and USB streaming from the observer hook:
+ *   outcome counters, latency histogram and longest interrupts-disabled
+ *   window
  * 
  * @see https://github.com/Hypirae/dht11
  */
 
 #include "sensor.h"
+#include "timing.h"
 #include <furi_hal.h>
 
-bool dht11_sensor_read(DHT11App* app) {
-    uint8_t data[5] = {0};
-    uint32_t timeout = 0;
-    
-    // Flash blue LED to indicate sensor reading
-    notification_message(app->notifications, &sequence_blink_start_blue);
-    
-    // DHT11 requires at least 1s between readings
-    // Send start signal: pull low for at least 18ms
-    furi_hal_gpio_init(DHT11_PIN, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
-    furi_hal_gpio_write(DHT11_PIN, false);
-    furi_delay_ms(20); // 20ms low to ensure proper start signal
-    
-    // Critical: Disable interrupts during timing-sensitive communication
-    FURI_CRITICAL_ENTER();
-    
-    // Pull high for 20-40us then release to input mode
-    furi_hal_gpio_write(DHT11_PIN, true);
-    furi_delay_us(30); // 30us high
-    
-    // Switch to input mode with pull-up
-    furi_hal_gpio_init(DHT11_PIN, GpioModeInput, GpioPullUp, GpioSpeedLow);
-    
-    // DHT11 response sequence:
-    // 1. DHT11 pulls low for 80us
-    timeout = 0;
-    while(furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
-    }
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        return false; // No response from DHT11
+const DHT11HeaderPinDef dht11_header_pins[DHT11HeaderPinCount] = {
+    [DHT11HeaderPinA7] = {&gpio_ext_pa7, "A7"},
+    [DHT11HeaderPinA6] = {&gpio_ext_pa6, "A6"},
+    [DHT11HeaderPinA4] = {&gpio_ext_pa4, "A4"},
+    [DHT11HeaderPinB3] = {&gpio_ext_pb3, "B3"},
+    [DHT11HeaderPinB2] = {&gpio_ext_pb2, "B2"},
+    [DHT11HeaderPinC3] = {&gpio_ext_pc3, "C3"},
+    [DHT11HeaderPinC1] = {&gpio_ext_pc1, "C1"},
+    [DHT11HeaderPinC0] = {&gpio_ext_pc0, "C0"},
+};
+
+/**
+ * @brief Load or store the learned thresholds of the learning sensors
+ * 
+ * Sensors on a fixed threshold are left out, so their stored entries
+ * neither override the setting nor get lost.
+ * 
+ * @param app Pointer to the application instance
+ * @param save true to store, false to load
+ */
+static void dht11_sensor_calibration_io(DHT11App* app, bool save) {
+    DHT11Calibration* calibrations[DHT11_MAX_SENSORS];
+    const char* names[DHT11_MAX_SENSORS];
+    uint8_t count = 0;
+    bool dirty = false;
+    
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        DHT11Driver* driver = app->sensors[i].driver;
+        if(!driver->adaptive) {
+            continue;
+        }
+        calibrations[count] = &driver->calibration;
+        names[count] = app->sensors[i].name;
+        dirty |= calibrations[count]->dirty;
+        count++;
     }
     
-    // 2. DHT11 pulls high for 80us
-    timeout = 0;
-    while(!furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
+    if(count == 0) {
+        return;
+    } else if(!save) {
+        dht11_calibration_load(DHT11_CALIBRATION_PATH, calibrations, names, count);
+    } else if(dirty) {
+        dht11_calibration_save(DHT11_CALIBRATION_PATH, calibrations, names, count);
     }
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        return false; // Invalid response
+}
+
+/**
+ * @brief Make sure the sensors are powered before a transaction
+ * 
+ * After a power-up the data lines are pulled high again and the sensors
+ * are given their warm-up time.
+ * 
+ * @param app Pointer to the application instance
+ */
+static void dht11_sensor_power_begin(DHT11App* app) {
+    if(app->power.on) {
+        return;
     }
     
-    // 3. Wait for end of response high period
-    timeout = 0;
-    while(furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        furi_hal_gpio_init(app->sensors[i].driver->pin, GpioModeInput, GpioPullUp, GpioSpeedLow);
     }
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        return false; // Response too long
+    dht11_sensor_power_on(&app->power);
+}
+
+/**
+ * @brief Power the sensors down after a transaction in low-power mode
+ * 
+ * The data lines are left floating so the pull-ups cannot feed an
+ * unpowered sensor through its data pin.
+ * 
+ * @param app Pointer to the application instance
+ */
+static void dht11_sensor_power_end(DHT11App* app) {
+    if(!app->power_saving || !dht11_sensor_power_is_switchable(&app->power)) {
+        return;
     }
     
-    // Read 40 bits of data (5 bytes)
-    for(int i = 0; i < 40; i++) {
-        // Wait for bit start (low period ~50us)
-        timeout = 0;
-        while(!furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-            furi_delay_us(1);
-            timeout++;
-        }
-        if(timeout >= 200) {
-            FURI_CRITICAL_EXIT();
-            notification_message(app->notifications, &sequence_blink_stop);
-            return false;
-        }
-        
-        // Measure high period using DWT cycle counter for microsecond precision
-        // Enable DWT cycle counter if not already enabled
-        if(!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
-            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
-        }
-        
-        uint32_t start_cycles = DWT->CYCCNT;
-        while(furi_hal_gpio_read(DHT11_PIN)) {
-            uint32_t elapsed_cycles = DWT->CYCCNT - start_cycles;
-            // Flipper Zero runs at 64MHz, so 64 cycles = 1μs
-            uint32_t elapsed_us = elapsed_cycles / 64;
-            if(elapsed_us > 200) break; // 200μs timeout
-        }
-        uint32_t end_cycles = DWT->CYCCNT;
-        uint32_t pulse_duration_us = (end_cycles - start_cycles) / 64;
-        
-        // Bit value based on high period duration
-        // For DHT11: Logic '1' is ~70us, Logic '0' is ~26-28us
-        if(pulse_duration_us > 40) { // Logic '1' (~70us) with proper threshold
-            uint8_t byte_idx = i / 8;
-            uint8_t bit_idx = 7 - (i % 8);
-            data[byte_idx] |= (1 << bit_idx);
-        }
-        // Logic '0' (~26-28us) - bit remains 0 (no action needed)
+    dht11_sensor_power_off(&app->power);
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        furi_hal_gpio_init(app->sensors[i].driver->pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
     }
+}
+
+/**
+ * @brief Indicator hook: supply and read LED around a transaction
+ * 
+ * Runs with the driver lock held, inside the app's sensor lock.
+ * 
+ * @param context Pointer to the application instance
+ * @param active true when a transaction starts
+ */
+static void dht11_sensor_indicate(void* context, bool active) {
+    DHT11App* app = context;
     
-    FURI_CRITICAL_EXIT();
+    // The warm-up after a power-up delays the transaction
+    if(active) {
+        dht11_sensor_power_begin(app);
+    }
     
-    // Verify checksum
-    uint8_t checksum = data[0] + data[1] + data[2] + data[3];
-    if(checksum != data[4]) {
-        // Turn off LED and return false for checksum error
-        notification_message(app->notifications, &sequence_blink_stop);
-        return false; // Checksum mismatch
+    // Flash blue LED to indicate sensor reading, unless in low-power mode
+    if(!app->power_saving) {
+        notification_message(app->notifications, active ? &sequence_blink_start_blue : &sequence_blink_stop);
     }
     
-    // Convert data according to DHT11 format
-    // DHT11 provides integer values only, fractional bytes should be 0
-    app->humidity = (float)data[0];
-    app->temperature = (float)data[2];
+    if(!active) {
+        dht11_sensor_power_end(app);
+    }
+}
+
+/**
+ * @brief Observer hook: record a finished transaction
+ * 
+ * Trace recording, streaming and the read path statistics.
+ * 
+ * @param context Pointer to the application instance
+ * @param driver Handle that was read
+ * @param transaction The finished transaction
+ */
+static void dht11_sensor_observe(void* context, DHT11Driver* driver, const DHT11DriverTransaction* transaction) {
+    DHT11App* app = context;
+    const DHT11Transfer* transfer = transaction->transfer;
     
-    // Handle negative temperatures (if MSB of data[2] is set)
-    if(data[2] & 0x80) {
-        app->temperature = -((float)(data[2] & 0x7F));
+    uint8_t index = 0;
+    while(index < app->sensor_count && app->sensors[index].driver != driver) {
+        index++;
     }
+    furi_check(index < app->sensor_count);
     
-    // Validate reasonable ranges
-    if(app->humidity > 100.0f || app->temperature > 60.0f || app->temperature < -40.0f) {
-        // Turn off LED and return false for range error
-        notification_message(app->notifications, &sequence_blink_stop);
-        return false; // Values out of reasonable range
+    // Record the waveform together with the final outcome
+    if(app->trace_log) {
+        dht11_trace_log_append(app->trace_log, transaction->tick, app->sensors[index].name, transfer);
+    }
+    if(app->usb_stream) {
+        dht11_usb_stream_push(
+            app->usb_stream, transaction->tick, index, driver->protocol - dht11_protocols, transfer);
     }
     
-    // Turn off LED - successful read
-    notification_message(app->notifications, &sequence_blink_stop);
-    return true;
+    dht11_stats_record(
+        &app->stats,
+        transfer->status,
+        transfer->recovered_bits > 0,
+        transaction->latency_us,
+        transaction->irq_off_us,
+        transaction->start_ms * 1000);
 }
 
-// DHT11 debug sensor reading function with detailed logging
-bool dht11_sensor_debug_read(DHT11App* app) {
-    uint8_t data[5] = {0};
-    uint32_t timeout = 0;
-    char temp_msg[128];
-    
-    // Clear debug log
-    app->debug_log[0] = '\0';
-    size_t log_pos = 0;
-    
-    // Start logging
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "=== DHT11 Debug Log ===\n");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "Pin: C0 (GPIO 16)\n\n");
-    
-    // Flash blue LED to indicate sensor reading
-    notification_message(app->notifications, &sequence_blink_start_blue);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "1. LED: Blue flash started\n");
-    
-    // Initial pin state check
-    snprintf(temp_msg, sizeof(temp_msg), "2. Initial pin state: %s\n", 
-             furi_hal_gpio_read(DHT11_PIN) ? "HIGH" : "LOW");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    // Send start signal: pull low for at least 18ms
-    furi_hal_gpio_init(DHT11_PIN, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
-    furi_hal_gpio_write(DHT11_PIN, false);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "3. Start signal: Pin LOW for 20ms\n");
-    furi_delay_ms(20);
-    
-    // Critical: Disable interrupts during timing-sensitive communication
-    FURI_CRITICAL_ENTER();
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "4. Critical section: Interrupts disabled\n");
-    
-    // Pull high for 20-40us then release to input mode
-    furi_hal_gpio_write(DHT11_PIN, true);
-    furi_delay_us(30);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "5. Release signal: Pin HIGH for 30us\n");
-    
-    // Switch to input mode with pull-up
-    furi_hal_gpio_init(DHT11_PIN, GpioModeInput, GpioPullUp, GpioSpeedLow);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "6. Input mode: Pull-up enabled\n");
-    
-    // DHT11 response sequence:
-    // 1. DHT11 pulls low for 80us
-    timeout = 0;
-    while(furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
+void dht11_sensor_init(DHT11App* app, DHT11ReadBackend backend) {
+    furi_assert(app);
+    
+    // Streams report the cycle rate even when no sensor is attached
+    dht11_timing_init();
+    
+    app->sensor_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    app->trace_log = NULL;
+    app->usb_stream = NULL;
+    dht11_stats_reset(&app->stats, furi_get_tick());
+    app->debug_events = NULL;
+    
+    // A supply pin cannot double as a data line
+    const DHT11Settings* settings = &app->settings;
+    uint32_t pins = settings->sensor_pins;
+    if(DHT11_SENSOR_POWER_SOURCE == DHT11SensorPowerGpio) {
+        pins &= ~(1 << DHT11_SENSOR_POWER_PIN);
     }
-    snprintf(temp_msg, sizeof(temp_msg), "7. Wait for LOW: %lums timeout=%d\n", (unsigned long)timeout, timeout >= 200 ? 1 : 0);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "ERROR: No response from DHT11\n");
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "Check: VCC->3.3V, GND->GND, DATA->C0\n");
-        return false;
+    dht11_sensor_power_init(
+        &app->power, DHT11_SENSOR_POWER_SOURCE, dht11_header_pins[DHT11_SENSOR_POWER_PIN].pin);
+    app->power_saving = false;
+    
+    const DHT11DriverHooks hooks = {
+        .indicate = dht11_sensor_indicate,
+        .observe = dht11_sensor_observe,
+        .context = app,
+    };
+    
+    app->sensor_count = 0;
+    app->selected_sensor = 0;
+    for(uint8_t i = 0; i < DHT11HeaderPinCount && app->sensor_count < DHT11_MAX_SENSORS; i++) {
+        if(!(pins & (1 << i))) {
+            continue;
+        }
+        
+        DHT11ProtocolType type = DHT11ProtocolDht11;
+        if(settings->dht22_pins & (1 << i)) {
+            type = DHT11ProtocolDht22;
+        } else if(settings->dht21_pins & (1 << i)) {
+            type = DHT11ProtocolDht21;
+        }
+        
+        DHT11Sensor* sensor = &app->sensors[app->sensor_count++];
+        sensor->name = dht11_header_pins[i].name;
+        sensor->driver = dht11_driver_alloc(dht11_header_pins[i].pin, type);
+        dht11_driver_set_backend(sensor->driver, backend);
+        dht11_driver_set_start_ms(sensor->driver, settings->start_ms);
+        dht11_driver_set_threshold(sensor->driver, settings->threshold_us);
+        // A threshold chosen in the settings is used as is and not learned
+        dht11_driver_set_adaptive(sensor->driver, settings->threshold_us == 0);
+        dht11_driver_set_hooks(sensor->driver, &hooks);
     }
     
-    // 2. DHT11 pulls high for 80us
-    timeout = 0;
-    while(!furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
+    dht11_sensor_calibration_io(app, false);
+}
+
+void dht11_sensor_deinit(DHT11App* app) {
+    furi_assert(app);
+    
+    // Keep what was learned this session
+    dht11_sensor_calibration_io(app, true);
+    
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        dht11_driver_free(app->sensors[i].driver);
+        app->sensors[i].driver = NULL;
     }
-    snprintf(temp_msg, sizeof(temp_msg), "8. Response LOW: %lums\n", (unsigned long)timeout);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "ERROR: Invalid response timing\n");
-        return false;
+    if(app->trace_log) {
+        dht11_trace_log_close(app->trace_log);
+        app->trace_log = NULL;
+    }
+    if(app->usb_stream) {
+        dht11_usb_stream_close(app->usb_stream);
+        app->usb_stream = NULL;
+    }
+    if(app->debug_events) {
+        free(app->debug_events);
+        app->debug_events = NULL;
+    }
+    dht11_sensor_power_deinit(&app->power);
+    furi_mutex_free(app->sensor_mutex);
+}
+
+bool dht11_sensor_get_reading(DHT11App* app, DHT11Sensor* sensor, DHT11Reading* reading) {
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    bool valid = dht11_driver_read(sensor->driver, reading);
+    furi_mutex_release(app->sensor_mutex);
+    return valid;
+}
+
+DHT11Result dht11_sensor_read(DHT11App* app, DHT11Sensor* sensor) {
+    DHT11Reading reading;
+    dht11_sensor_get_reading(app, sensor, &reading);
+    return reading.last;
+}
+
+uint8_t dht11_sensor_read_batch(
+    DHT11App* app,
+    uint8_t sensor_mask,
+    uint8_t* read_mask,
+    DHT11Reading* readings) {
+    DHT11Driver* drivers[DHT11_MAX_SENSORS];
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        drivers[i] = app->sensors[i].driver;
+    }
+    
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t ok_mask = dht11_driver_read_batch(drivers, app->sensor_count, sensor_mask, read_mask, readings);
+    furi_mutex_release(app->sensor_mutex);
+    
+    return ok_mask;
+}
+
+/**
+ * @brief Record a finished transaction in the debug event log
+ * 
+ * Runs after the transfer with interrupts enabled, so recording has no
+ * influence on the measured timings. Only numbers are stored; the text is
+ * produced by dht11_debug_log_format() when the debug screen is shown.
+ * 
+ * @param app Pointer to the application instance
+ * @param sensor Sensor that was read
+ * @param initial_pin_state Data line level before the start signal
+ */
+static void dht11_sensor_record_debug_events(
+    DHT11App* app,
+    const DHT11Sensor* sensor,
+    bool initial_pin_state) {
+    DHT11DebugLog* log = app->debug_events;
+    const DHT11Driver* driver = sensor->driver;
+    const DHT11Transfer* transfer = &driver->transfer;
+    const uint16_t* trace = transfer->trace;
+    uint32_t cycles_per_us = dht11_timing.cycles_per_us;
+    uint8_t threshold_us = driver->calibration.threshold_us;
+    DHT11Status status = transfer->status;
+    
+    // Timestamps are cycle offsets from the release of the line
+    uint32_t elapsed = trace[DHT11_TRACE_WAIT_RESPONSE];
+    
+    dht11_debug_log_begin(log, sensor->name, initial_pin_state, driver->start_ms);
+    dht11_debug_log_push(log, DHT11DebugStepBackend, 0, driver->backend == DHT11ReadBackendPolling, 0);
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepWaitResponse,
+        elapsed,
+        trace[DHT11_TRACE_WAIT_RESPONSE] / cycles_per_us,
+        status == DHT11StatusNoResponse);
+    if(status == DHT11StatusNoResponse) {
+        return;
     }
     
-    // 3. Wait for end of response high period
-    timeout = 0;
-    while(furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-        furi_delay_us(1);
-        timeout++;
+    elapsed += trace[DHT11_TRACE_RESPONSE_LOW];
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepResponseLow,
+        elapsed,
+        trace[DHT11_TRACE_RESPONSE_LOW] / cycles_per_us,
+        status == DHT11StatusResponseLow);
+    if(status == DHT11StatusResponseLow) {
+        return;
     }
-    snprintf(temp_msg, sizeof(temp_msg), "9. Response HIGH: %lums\n", (unsigned long)timeout);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    if(timeout >= 200) {
-        FURI_CRITICAL_EXIT();
-        notification_message(app->notifications, &sequence_blink_stop);
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "ERROR: Response too long\n");
-        return false;
+    
+    elapsed += trace[DHT11_TRACE_RESPONSE_HIGH];
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepResponseHigh,
+        elapsed,
+        trace[DHT11_TRACE_RESPONSE_HIGH] / cycles_per_us,
+        status == DHT11StatusResponseHigh);
+    if(status == DHT11StatusResponseHigh) {
+        return;
     }
     
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "10. Data transmission started\n");
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepThreshold,
+        elapsed,
+        threshold_us | (driver->calibration.learned ? 0x100 : 0),
+        MIN(driver->calibration.samples, UINT16_MAX));
     
-    // Read 40 bits of data (5 bytes)
-    uint8_t bits_read = 0;
-    for(int i = 0; i < 40; i++) {
-        // Wait for bit start (low period ~50us)
-        timeout = 0;
-        while(!furi_hal_gpio_read(DHT11_PIN) && timeout < 200) {
-            furi_delay_us(1);
-            timeout++;
-        }
-        if(timeout >= 200) {
-            FURI_CRITICAL_EXIT();
-            notification_message(app->notifications, &sequence_blink_stop);
-            snprintf(temp_msg, sizeof(temp_msg), "ERROR: Bit %d start timeout\n", i);
-            log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-            return false;
-        }
-        
-        // Measure high period using DWT cycle counter for microsecond precision
-        // Enable DWT cycle counter if not already enabled
-        if(!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
-            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
-        }
+    for(uint8_t i = 0; i < transfer->bits_read; i++) {
+        elapsed += trace[DHT11_TRACE_BIT_LOW(i)] + trace[DHT11_TRACE_BIT_HIGH(i)];
         
-        uint32_t start_cycles = DWT->CYCCNT;
-        while(furi_hal_gpio_read(DHT11_PIN)) {
-            uint32_t elapsed_cycles = DWT->CYCCNT - start_cycles;
-            // Flipper Zero runs at 64MHz, so 64 cycles = 1μs
-            uint32_t elapsed_us = elapsed_cycles / 64;
-            if(elapsed_us > 200) break; // 200μs timeout
-        }
-        uint32_t end_cycles = DWT->CYCCNT;
-        uint32_t pulse_duration_us = (end_cycles - start_cycles) / 64; // Convert cycles to μs
-        
-        // Bit value based on high period duration
-        // For DHT11: Logic '1' is ~70us, Logic '0' is ~26-28us  
-        // Use cycle-based measurement for accurate timing
-        bool bit_value = pulse_duration_us > 40;
-        if(bit_value) {
-            uint8_t byte_idx = i / 8;
-            uint8_t bit_idx = 7 - (i % 8);
-            data[byte_idx] |= (1 << bit_idx);
-        }
-        // Logic '0' (~26-28us) - bit remains 0 (no action needed)
-        bits_read++;
-        
-        // Log ALL bits to understand timing patterns - log every bit for first 16
-        if(i < 16) { // Log first 16 bits to see timing patterns
-            snprintf(temp_msg, sizeof(temp_msg), "Bit %d: %lums = %d (th:40)\n", i, (unsigned long)pulse_duration_us, bit_value ? 1 : 0);
-            log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-        } else if((i % 8) == 7) { // Every 8th bit after that
-            snprintf(temp_msg, sizeof(temp_msg), "Bit %d: %lums = %d\n", i, (unsigned long)pulse_duration_us, bit_value ? 1 : 0);
-            log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
+        // Record every bit for the first 16 to show timing patterns, then every 8th
+        if(i < 16 || (i % 8) == 7) {
+            uint32_t pulse_duration_us = trace[DHT11_TRACE_BIT_HIGH(i)] / cycles_per_us;
+            bool bit_value = pulse_duration_us > threshold_us;
+            dht11_debug_log_push(log, DHT11DebugStepBit, elapsed, pulse_duration_us, i | (bit_value << 7));
         }
     }
     
-    FURI_CRITICAL_EXIT();
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "11. Critical section: Interrupts enabled\n");
-    
-    snprintf(temp_msg, sizeof(temp_msg), "12. Bits read: %d/40\n", bits_read);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    // Add timing analysis
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "Timing Analysis:\n");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "- Using DWT cycle counter (64MHz = 1us)\n");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "- Current threshold: 40us\n");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "- Expected: 0=26-28us, 1=70us\n");
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "- High precision cycle counting\n");
-    
-    // Show raw data
-    snprintf(temp_msg, sizeof(temp_msg), "13. Raw data: %02X %02X %02X %02X %02X\n", 
-             data[0], data[1], data[2], data[3], data[4]);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    // Verify checksum
-    uint8_t checksum = data[0] + data[1] + data[2] + data[3];
-    snprintf(temp_msg, sizeof(temp_msg), "14. Checksum calc: %02X, received: %02X\n", checksum, data[4]);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    
-    if(checksum != data[4]) {
-        notification_message(app->notifications, &sequence_blink_stop);
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "ERROR: Checksum mismatch\n");
-        return false;
+    if(status == DHT11StatusBitTimeout) {
+        dht11_debug_log_push(log, DHT11DebugStepBitTimeout, elapsed, 0, transfer->failed_bit);
+        return;
+    }
+    
+    dht11_debug_log_push(log, DHT11DebugStepComplete, elapsed, transfer->bits_read, cycles_per_us);
+    
+    const uint8_t* data = transfer->data;
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepRawData,
+        elapsed,
+        ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3],
+        data[4]);
+    if(status == DHT11StatusChecksum) {
+        return;
     }
     
-    // Convert data
-    app->humidity = (float)data[0];
-    app->temperature = (float)data[2];
+    // Converted again rather than kept: the cache only holds good readings
+    int16_t temperature = 0;
+    uint16_t humidity = 0;
+    dht11_protocol_convert(driver->protocol, data, &temperature, &humidity);
+    dht11_debug_log_push(
+        log,
+        DHT11DebugStepValues,
+        elapsed,
+        humidity,
+        (uint16_t)temperature);
+    dht11_debug_log_push(log, DHT11DebugStepResult, elapsed, status, transfer->recovered_bits);
+}
+
+bool dht11_sensor_debug_read(DHT11App* app, DHT11Sensor* sensor) {
+    DHT11Reading reading;
+    
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    
+    // Most sessions never open the debug screen: the log is allocated on first use
+    if(!app->debug_events) {
+        app->debug_events = malloc(sizeof(DHT11DebugLog));
+        dht11_debug_log_reset(app->debug_events);
+    }
+    
+    dht11_sensor_power_begin(app);
+    bool initial_pin_state = furi_hal_gpio_read(sensor->driver->pin);
+    
+    // Same core as a normal read: debug timings match production timings.
+    // A debug read always shows a transaction, so it waits out the interval.
+    bool ok = dht11_driver_read_fresh(sensor->driver, &reading);
+    
+    // All recording happens after the transfer, with interrupts enabled
+    dht11_sensor_record_debug_events(app, sensor, initial_pin_state);
+    
+    furi_mutex_release(app->sensor_mutex);
+    return ok;
+}
+
+bool dht11_sensor_set_trace_enabled(DHT11App* app, bool enabled) {
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    
+    if(enabled && !app->trace_log) {
+        app->trace_log = dht11_trace_log_open(DHT11_TRACE_LOG_PATH);
+    } else if(!enabled && app->trace_log) {
+        dht11_trace_log_close(app->trace_log);
+        app->trace_log = NULL;
+    }
+    bool result = (app->trace_log != NULL) == enabled;
+    
+    furi_mutex_release(app->sensor_mutex);
+    return result;
+}
+
+bool dht11_sensor_is_trace_enabled(DHT11App* app) {
+    return app->trace_log != NULL;
+}
+
+bool dht11_sensor_set_usb_stream(DHT11App* app, DHT11UsbStreamMode mode) {
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
     
-    snprintf(temp_msg, sizeof(temp_msg), "15. Humidity: %.1f%%\n", (double)app->humidity);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
-    snprintf(temp_msg, sizeof(temp_msg), "16. Temperature: %.1f°C\n", (double)app->temperature);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "%s", temp_msg);
+    // Frame contents are fixed per stream: a mode change reopens it
+    if(app->usb_stream && app->usb_stream->mode != mode) {
+        dht11_usb_stream_close(app->usb_stream);
+        app->usb_stream = NULL;
+    }
+    if(mode != DHT11UsbStreamModeOff && !app->usb_stream) {
+        app->usb_stream = dht11_usb_stream_open(mode);
+    }
+    bool result = dht11_sensor_get_usb_stream(app) == mode;
     
-    // Validate ranges
-    if(app->humidity > 100.0f || app->temperature > 60.0f || app->temperature < -40.0f) {
-        notification_message(app->notifications, &sequence_blink_stop);
-        log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "ERROR: Values out of range\n");
-        return false;
+    furi_mutex_release(app->sensor_mutex);
+    return result;
+}
+
+DHT11UsbStreamMode dht11_sensor_get_usb_stream(DHT11App* app) {
+    return app->usb_stream ? app->usb_stream->mode : DHT11UsbStreamModeOff;
+}
+
+bool dht11_sensor_set_low_power(DHT11App* app, bool enabled) {
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    
+    // Leaving low-power mode, the next transaction powers up and stays powered
+    app->power_saving = enabled;
+    if(enabled) {
+        dht11_sensor_power_end(app);
     }
+    bool switching = dht11_sensor_power_is_switchable(&app->power);
     
-    notification_message(app->notifications, &sequence_blink_stop);
-    log_pos += snprintf(app->debug_log + log_pos, sizeof(app->debug_log) - log_pos, "17. SUCCESS: Read completed\n");
-    return true;
+    furi_mutex_release(app->sensor_mutex);
+    return switching;
+}
+
+void dht11_sensor_get_stats(DHT11App* app, DHT11Stats* stats) {
+    furi_check(furi_mutex_acquire(app->sensor_mutex, FuriWaitForever) == FuriStatusOk);
+    *stats = app->stats;
+    furi_mutex_release(app->sensor_mutex);
 }
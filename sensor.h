@@ -3,7 +3,9 @@
  * @brief DHT11 sensor driver interface
  * 
  * This file contains the interface for reading data from the DHT11
- * temperature and humidity sensor.
+ * temperature and humidity sensor. The read path itself is the
+ * handle-based driver in driver.h; these functions run it for the app's
+ * sensors.
  */
 
 #pragma once
@@ -11,28 +13,201 @@
 #include <furi_hal_gpio.h>
 #include "app.h"
 
-/** @brief GPIO pin connected to DHT11 data line */
-#define DHT11_PIN &gpio_ext_pc0
+/**
+ * @brief GPIO header pins usable as DHT11 data lines
+ * 
+ * In header order; the value is also the bit position in the pin masks.
+ */
+typedef enum {
+    DHT11HeaderPinA7,       /**< Pin 2 */
+    DHT11HeaderPinA6,       /**< Pin 3 */
+    DHT11HeaderPinA4,       /**< Pin 4 */
+    DHT11HeaderPinB3,       /**< Pin 5 */
+    DHT11HeaderPinB2,       /**< Pin 6 */
+    DHT11HeaderPinC3,       /**< Pin 7 */
+    DHT11HeaderPinC1,       /**< Pin 15 */
+    DHT11HeaderPinC0,       /**< Pin 16 */
+    DHT11HeaderPinCount,    /**< Total number of usable pins */
+} DHT11HeaderPin;
+
+/**
+ * @brief GPIO header pin description
+ */
+typedef struct {
+    const GpioPin* pin;     /**< GPIO pin */
+    const char* name;       /**< Name as printed on the header */
+} DHT11HeaderPinDef;
+
+/** @brief Header pin table, indexed by DHT11HeaderPin */
+extern const DHT11HeaderPinDef dht11_header_pins[DHT11HeaderPinCount];
+
+/** @brief Bit mask of header pins with a sensor attached, unless set in the settings file */
+#define DHT11_SENSOR_PINS (1 << DHT11HeaderPinC0)
+
+/** @brief Pins of DHT11_SENSOR_PINS with a DHT22 or AM2302 attached */
+#define DHT11_SENSOR_DHT22_PINS 0
+
+/** @brief Pins of DHT11_SENSOR_PINS with a DHT21 or AM2301 attached; all others are DHT11s */
+#define DHT11_SENSOR_DHT21_PINS 0
+
+/** @brief Read backend selected at startup */
+#define DHT11_DEFAULT_BACKEND DHT11ReadBackendCapture
+
+/** @brief Where the sensors' VCC is wired */
+#define DHT11_SENSOR_POWER_SOURCE DHT11SensorPowerAlways
+
+/** @brief Header pin supplying the sensors with DHT11SensorPowerGpio */
+#define DHT11_SENSOR_POWER_PIN DHT11HeaderPinC1
+
+/**
+ * @brief Initialize the sensor driver
+ * 
+ * Enables the DWT cycle counter and allocates a driver handle for every
+ * pin in the settings' sensor mask, with its family taken from the
+ * per-family pin masks and the start pulse and threshold from the
+ * settings. The handles' hooks drive the read LED, the sensor supply,
+ * the statistics, trace recording and USB streaming.
+ * 
+ * @param app Pointer to the application instance
+ * @param backend Read backend used for all subsequent readings
+ */
+void dht11_sensor_init(DHT11App* app, DHT11ReadBackend backend);
+
+/**
+ * @brief Release resources held by the sensor driver
+ * 
+ * @param app Pointer to the application instance
+ */
+void dht11_sensor_deinit(DHT11App* app);
+
+/**
+ * @brief Get a reading, touching the bus only when the sensor allows it
+ * 
+ * Starts a transaction if the sensor family's minimum interval has passed
+ * since the sensor's previous one; otherwise answers from the cache without
+ * disturbing the sensor or its last status. Either way the newest good
+ * reading is returned with its age, so callers may poll freely. Safe to
+ * call from any thread; concurrent reads are serialized on the driver's
+ * bus lock.
+ * 
+ * @param app Pointer to the application instance
+ * @param sensor Sensor to read
+ * @param reading Output for the reading; fresh is set if the bus was used
+ * @return true if a good reading is available
+ */
+bool dht11_sensor_get_reading(DHT11App* app, DHT11Sensor* sensor, DHT11Reading* reading);
 
 /**
  * @brief Read temperature and humidity from DHT11 sensor
  * 
- * Performs a standard sensor reading operation and updates the app's
- * temperature and humidity values if successful.
+ * Read-through like dht11_sensor_get_reading(); the values end up in the
+ * sensor's cache.
  * 
  * @param app Pointer to the application instance
- * @return true if reading was successful, false otherwise
+ * @param sensor Sensor to read
+ * @return Outcome of the sensor's most recent transaction, with its error
+ *         class, failing bit and measured timings
+ */
+DHT11Result dht11_sensor_read(DHT11App* app, DHT11Sensor* sensor);
+
+/**
+ * @brief Read several sensors at once
+ * 
+ * All selected sensors get one shared start pulse, as long as the longest
+ * any of their families needs. Sensors on the same
+ * GPIO port are then received together in a single interrupts-off window
+ * by sampling the port input register, so reading a whole port takes
+ * about as long as reading one sensor. Works independently of the read
+ * backend selected at init. Sensors still inside their minimum interval
+ * are left out and report their cached status.
+ * 
+ * @param app Pointer to the application instance
+ * @param sensor_mask Bit mask of indices into app->sensors to read
+ * @param read_mask Output for the sensors actually read, may be NULL
+ * @param readings Output indexed like app->sensors, filled for every
+ *                 sensor in sensor_mask, may be NULL
+ * @return Bit mask of the sensors whose most recent transaction succeeded
  */
-bool dht11_sensor_read(DHT11App* app);
+uint8_t dht11_sensor_read_batch(
+    DHT11App* app,
+    uint8_t sensor_mask,
+    uint8_t* read_mask,
+    DHT11Reading* readings);
 
 /**
  * @brief Read sensor with detailed debug logging
  * 
- * Performs a sensor reading operation with extensive debug logging
- * for troubleshooting purposes. Updates the app's debug_log buffer
- * with detailed timing and protocol information.
+ * Performs the same transaction as dht11_sensor_read() and then records
+ * its timings as events in the app's debug event log, which the first
+ * debug read allocates. Nothing is recorded while the transfer is in
+ * progress. If the sensor was read more recently
+ * than its minimum interval allows, waits out the remainder first.
  * 
  * @param app Pointer to the application instance
+ * @param sensor Sensor to read
  * @return true if reading was successful, false otherwise
  */
-bool dht11_sensor_debug_read(DHT11App* app);
+bool dht11_sensor_debug_read(DHT11App* app, DHT11Sensor* sensor);
+
+/**
+ * @brief Enable or disable raw edge trace recording
+ * 
+ * While enabled, the cycle deltas of every transaction, normal or debug,
+ * are appended to DHT11_TRACE_LOG_PATH on the SD card.
+ * 
+ * @param app Pointer to the application instance
+ * @param enabled true to start recording, false to stop
+ * @return true if recording is now in the requested state
+ */
+bool dht11_sensor_set_trace_enabled(DHT11App* app, bool enabled);
+
+/**
+ * @brief Check whether edge trace recording is active
+ * 
+ * @param app Pointer to the application instance
+ * @return true if traces are being recorded
+ */
+bool dht11_sensor_is_trace_enabled(DHT11App* app);
+
+/**
+ * @brief Select what is streamed over USB
+ * 
+ * While on, every transaction, normal or debug, is sent as a binary frame
+ * on the second CDC port, with or without its edge trace. Frames the host
+ * does not take in time are dropped, never delaying a read.
+ * 
+ * @param app Pointer to the application instance
+ * @param mode Frame contents, or DHT11UsbStreamModeOff to stop
+ * @return true if the stream is now in the requested mode
+ */
+bool dht11_sensor_set_usb_stream(DHT11App* app, DHT11UsbStreamMode mode);
+
+/**
+ * @brief Check what is being streamed over USB
+ * 
+ * @param app Pointer to the application instance
+ * @return Current frame contents, DHT11UsbStreamModeOff if not streaming
+ */
+DHT11UsbStreamMode dht11_sensor_get_usb_stream(DHT11App* app);
+
+/**
+ * @brief Switch the driver between normal and low-power operation
+ * 
+ * In low-power mode the read LED stays off and, if the supply is wired to
+ * a switchable source, the sensors are powered only around each
+ * transaction. Every transaction then starts with the warm-up of
+ * DHT11_SENSOR_POWER_WARMUP_MS.
+ * 
+ * @param app Pointer to the application instance
+ * @param enabled true for low-power operation
+ * @return true if the sensor supply is switched
+ */
+bool dht11_sensor_set_low_power(DHT11App* app, bool enabled);
+
+/**
+ * @brief Copy the read path statistics
+ * 
+ * @param app Pointer to the application instance
+ * @param stats Output for a consistent snapshot of the counters
+ */
+void dht11_sensor_get_stats(DHT11App* app, DHT11Stats* stats);
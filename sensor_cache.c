@@ -0,0 +1,57 @@
+/**
+ * @file sensor_cache.c
+ * @brief Read-through sensor cache implementation
+ */
+
+#include "sensor_cache.h"
+#include <furi.h>
+
+void dht11_sensor_cache_reset(DHT11SensorCache* cache, uint32_t min_interval_ms) {
+    memset(cache, 0, sizeof(DHT11SensorCache));
+    cache->interval = furi_ms_to_ticks(min_interval_ms);
+}
+
+uint32_t dht11_sensor_cache_wait_ticks(const DHT11SensorCache* cache, uint32_t now) {
+    if(!cache->transacted) {
+        return 0;
+    }
+    
+    uint32_t elapsed = now - cache->last_transaction;
+    return elapsed >= cache->interval ? 0 : cache->interval - elapsed;
+}
+
+void dht11_sensor_cache_store(
+    DHT11SensorCache* cache,
+    uint32_t tick,
+    const DHT11Result* result,
+    int16_t temperature,
+    uint16_t humidity) {
+    cache->last_transaction = tick;
+    cache->transacted = true;
+    cache->last = *result;
+    cache->outcomes[result->status]++;
+    
+    if(result->status == DHT11StatusOk) {
+        cache->last_success = tick;
+        cache->temperature = temperature;
+        cache->humidity = humidity;
+        cache->valid = true;
+    }
+}
+
+bool dht11_sensor_cache_get(const DHT11SensorCache* cache, uint32_t now, DHT11Reading* reading) {
+    reading->temperature = cache->temperature;
+    reading->humidity = cache->humidity;
+    reading->tick = cache->last_success;
+    reading->age_ms = 0;
+    if(cache->valid) {
+        // Split to avoid overflowing for ages of more than an hour
+        uint32_t elapsed = now - cache->last_success;
+        uint32_t frequency = furi_kernel_get_tick_frequency();
+        reading->age_ms = (elapsed / frequency) * 1000 + (elapsed % frequency) * 1000 / frequency;
+    }
+    reading->valid = cache->valid;
+    reading->fresh = false;
+    reading->last = cache->last;
+    return cache->valid;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file sensor_cache.h
+ * @brief Read-through cache in front of the sensor driver
+ * 
+ * A sensor answers garbage when it is started again too soon after its
+ * previous transaction, one second for the DHT11 and two for the DHT22
+ * and DHT21. The cache remembers when each sensor
+ * last touched the bus and its last good reading, so callers can ask for
+ * a reading as often as they like: a request inside the minimum interval
+ * is answered from the cache, together with the reading's age.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "decoder.h"
+
+/** @brief Shortest minimum interval of any supported sensor family */
+#define DHT11_MIN_INTERVAL_MS 1000
+
+/**
+ * @brief A reading as returned to callers
+ */
+typedef struct {
+    int16_t temperature;    /**< Temperature in tenths of a degree Celsius, valid if valid is set */
+    uint16_t humidity;      /**< Relative humidity in tenths of a percent, valid if valid is set */
+    uint32_t tick;          /**< Tick of the transaction that produced the values */
+    uint32_t age_ms;        /**< Time since that transaction */
+    bool valid;             /**< A successful reading is available */
+    bool fresh;             /**< The values come from a transaction made for this request */
+    DHT11Result last;       /**< Outcome of the most recent transaction */
+} DHT11Reading;
+
+/**
+ * @brief Cache state of one sensor
+ */
+typedef struct {
+    uint32_t last_transaction;  /**< Tick at which the last transaction started */
+    uint32_t last_success;      /**< Tick of the last successful transaction */
+    uint32_t interval;          /**< Minimum ticks between two transactions */
+    int16_t temperature;        /**< Last good temperature in tenths of a degree Celsius */
+    uint16_t humidity;          /**< Last good relative humidity in tenths of a percent */
+    bool transacted;            /**< last_transaction is set */
+    bool valid;                 /**< A good reading is stored */
+    DHT11Result last;           /**< Outcome of the last transaction */
+    uint32_t outcomes[DHT11StatusCount];    /**< Transactions by outcome */
+} DHT11SensorCache;
+
+/**
+ * @brief Forget everything cached
+ * 
+ * @param cache Pointer to the cache state
+ * @param min_interval_ms Minimum time between two transactions with the sensor
+ */
+void dht11_sensor_cache_reset(DHT11SensorCache* cache, uint32_t min_interval_ms);
+
+/**
+ * @brief Time until the sensor may be read again
+ * 
+ * @param cache Pointer to the cache state
+ * @param now Current tick
+ * @return Ticks to wait, 0 if a transaction is allowed now
+ */
+uint32_t dht11_sensor_cache_wait_ticks(const DHT11SensorCache* cache, uint32_t now);
+
+/**
+ * @brief Record the outcome of a transaction
+ * 
+ * @param cache Pointer to the cache state
+ * @param tick Tick at which the transaction started
+ * @param result Outcome; values are only stored on success
+ * @param temperature Temperature in tenths of a degree Celsius
+ * @param humidity Relative humidity in tenths of a percent
+ */
+void dht11_sensor_cache_store(
+    DHT11SensorCache* cache,
+    uint32_t tick,
+    const DHT11Result* result,
+    int16_t temperature,
+    uint16_t humidity);
+
+/**
+ * @brief Copy the cached reading
+ * 
+ * @param cache Pointer to the cache state
+ * @param now Current tick, used for the age
+ * @param reading Output reading; fresh is cleared
+ * @return true if a good reading is cached
+ */
+bool dht11_sensor_cache_get(const DHT11SensorCache* cache, uint32_t now, DHT11Reading* reading);
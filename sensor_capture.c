@@ -0,0 +1,90 @@
+/**
+ * @file sensor_capture.c
+ * @brief Interrupt-driven edge capture backend implementation
+ */
+
+#include "sensor_capture.h"
+#include "timing.h"
+#include <furi_hal.h>
+
+/**
+ * @brief EXTI callback recording the timestamp of each edge
+ * 
+ * Runs in interrupt context, so it only stores the cycle counter.
+ * The rising edge caused by releasing the line is ignored; the
+ * transfer starts with the sensor pulling the line low.
+ * 
+ * @param context Pointer to the capture state
+ */
+static void dht11_capture_edge_callback(void* context) {
+    DHT11Capture* capture = context;
+    uint32_t now = dht11_timing_now();
+    uint8_t count = capture->count;
+    
+    if(count >= DHT11_CAPTURE_EDGES) {
+        return;
+    }
+    if(count == 0 && furi_hal_gpio_read(capture->pin)) {
+        return; // Line release, not a sensor edge
+    }
+    
+    capture->edges[count] = now;
+    capture->count = count + 1;
+    
+    if(count + 1 == DHT11_CAPTURE_EDGES) {
+        furi_semaphore_release(capture->done);
+    }
+}
+
+DHT11Capture* dht11_capture_alloc(const GpioPin* pin) {
+    DHT11Capture* capture = malloc(sizeof(DHT11Capture));
+    capture->pin = pin;
+    capture->pull_up = true;
+    capture->count = 0;
+    capture->done = furi_semaphore_alloc(1, 0);
+    return capture;
+}
+
+void dht11_capture_free(DHT11Capture* capture) {
+    furi_assert(capture);
+    furi_semaphore_free(capture->done);
+    free(capture);
+}
+
+bool dht11_capture_run(DHT11Capture* capture, uint32_t timeout_ms) {
+    furi_assert(capture);
+    
+    // Drop a stale completion left over from a previous timed out run
+    furi_semaphore_acquire(capture->done, 0);
+    capture->count = 0;
+    GpioPull pull = capture->pull_up ? GpioPullUp : GpioPullNo;
+    
+    // Releasing the line into interrupt mode ends the start pulse
+    furi_hal_gpio_add_int_callback(capture->pin, dht11_capture_edge_callback, capture);
+    capture->released = dht11_timing_now();
+    furi_hal_gpio_init(capture->pin, GpioModeInterruptRiseFall, pull, GpioSpeedVeryHigh);
+    
+    bool complete = furi_semaphore_acquire(capture->done, furi_ms_to_ticks(timeout_ms)) == FuriStatusOk;
+    
+    furi_hal_gpio_remove_int_callback(capture->pin);
+    furi_hal_gpio_init(capture->pin, GpioModeInput, pull, GpioSpeedLow);
+    
+    return complete;
+}
+
+void dht11_capture_fill_transfer(const DHT11Capture* capture, DHT11Transfer* transfer) {
+    furi_assert(capture);
+    
+    uint8_t count = capture->count;
+    
+    // Edge k ends trace phase k; the release starts the first phase
+    uint32_t previous = capture->released;
+    for(uint8_t k = 0; k < count; k++) {
+        transfer->trace[k] = dht11_trace_delta(previous, capture->edges[k]);
+        previous = capture->edges[k];
+    }
+    transfer->trace_length = count;
+    
+    // Response phases are ~80us; anything past the timeout is not a DHT11
+    dht11_decoder_finish_trace(transfer, dht11_timing.response_timeout);
+}
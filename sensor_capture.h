@@ -0,0 +1,85 @@
+/**
+ * @file sensor_capture.h
+ * @brief Interrupt-driven edge capture backend for the DHT11 driver
+ * 
+ * Instead of polling the data line with interrupts disabled, this backend
+ * timestamps every edge of the transfer with the DWT cycle counter from the
+ * EXTI interrupt of the data pin. The bit timings are derived from the
+ * recorded timestamps once the transfer has finished.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_gpio.h>
+#include "decoder.h"
+
+/**
+ * @brief Number of edges in a complete DHT11 transfer
+ * 
+ * Response low start, response high start, then a falling and a rising
+ * edge per data bit, terminated by the falling edge ending bit 39.
+ */
+#define DHT11_CAPTURE_EDGES DHT11_TRACE_LENGTH
+
+/**
+ * @brief Read backend selection
+ * 
+ * Chosen once when the driver is initialized.
+ */
+typedef enum {
+    DHT11ReadBackendPolling,    /**< Busy-wait bit loop inside a critical section */
+    DHT11ReadBackendCapture,    /**< EXTI edge timestamps, decoded after the transfer */
+} DHT11ReadBackend;
+
+/**
+ * @brief Edge capture state
+ * 
+ * Written from the EXTI interrupt while a transfer is in flight.
+ */
+typedef struct {
+    const GpioPin* pin;                             /**< Data pin being captured */
+    bool pull_up;                                   /**< Internal pull-up enabled on the pin */
+    uint32_t released;                              /**< DWT timestamp of the line release */
+    volatile uint32_t edges[DHT11_CAPTURE_EDGES];   /**< DWT timestamp of each edge */
+    volatile uint8_t count;                         /**< Number of edges recorded so far */
+    FuriSemaphore* done;                            /**< Released when the last edge arrives */
+} DHT11Capture;
+
+/**
+ * @brief Allocate capture state for a data pin
+ * 
+ * @param pin GPIO pin connected to the DHT11 data line
+ * @return Pointer to the allocated capture state
+ */
+DHT11Capture* dht11_capture_alloc(const GpioPin* pin);
+
+/**
+ * @brief Free capture state
+ * 
+ * @param capture Pointer to the capture state
+ */
+void dht11_capture_free(DHT11Capture* capture);
+
+/**
+ * @brief Release the data line and record the sensor's response
+ * 
+ * Must be called right after the start pulse, while the line is still
+ * driven low. Switches the pin to input with an edge interrupt and blocks
+ * until all edges have arrived or the timeout expires.
+ * 
+ * @param capture Pointer to the capture state
+ * @param timeout_ms Maximum time to wait for the transfer
+ * @return true if every edge of the transfer was recorded
+ */
+bool dht11_capture_run(DHT11Capture* capture, uint32_t timeout_ms);
+
+/**
+ * @brief Convert the recorded edge timestamps into a transfer record
+ * 
+ * Works on partial captures too: the status tells how far the transfer got.
+ * 
+ * @param capture Pointer to the capture state after a run
+ * @param transfer Transfer record to fill with response and bit timings
+ */
+void dht11_capture_fill_transfer(const DHT11Capture* capture, DHT11Transfer* transfer);
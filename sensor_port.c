@@ -0,0 +1,97 @@
+/**
+ * @file sensor_port.c
+ * @brief Whole-port sampling backend implementation
+ */
+
+#include "sensor_port.h"
+#include "timing.h"
+#include <furi_hal.h>
+
+/**
+ * @brief Extract each pin's edge trace from the captured port words
+ * 
+ * Edges of all pins are found together with one XOR per word; only the
+ * pins that actually changed are then visited individually.
+ * 
+ * @param words Captured port words
+ * @param mask Port bits of the pins being decoded
+ * @param lane Transfer index for each port bit
+ * @param transfers Transfer record for each pin
+ * @param period_cycles Cycles between two captured words
+ */
+static void dht11_port_extract_edges(
+    const uint16_t* words,
+    uint16_t mask,
+    const uint8_t* lane,
+    DHT11Transfer* const* transfers,
+    uint32_t period_cycles) {
+    uint16_t last_edge[16] = {0};
+    
+    // Every line is high once released; the first change is the sensor pulling low
+    uint16_t previous = mask;
+    
+    for(uint16_t k = 0; k < DHT11_PORT_SAMPLES; k++) {
+        uint16_t changed = (words[k] ^ previous) & mask;
+        previous = words[k];
+        
+        while(changed) {
+            uint8_t bit = __builtin_ctz(changed);
+            changed &= changed - 1;
+            
+            DHT11Transfer* transfer = transfers[lane[bit]];
+            if(transfer->trace_length < DHT11_TRACE_LENGTH) {
+                transfer->trace[transfer->trace_length++] =
+                    dht11_trace_delta(last_edge[bit] * period_cycles, k * period_cycles);
+                last_edge[bit] = k;
+            }
+        }
+    }
+}
+
+uint32_t dht11_port_receive(
+    const GpioPin* const* pins,
+    DHT11Transfer* const* transfers,
+    uint8_t count,
+    uint16_t* words) {
+    furi_assert(count > 0);
+    
+    GPIO_TypeDef* port = pins[0]->port;
+    uint32_t period_cycles = DHT11_PORT_SAMPLE_US * dht11_timing.cycles_per_us;
+    uint16_t mask = 0;
+    uint8_t lane[16] = {0};
+    
+    for(uint8_t i = 0; i < count; i++) {
+        furi_assert(pins[i]->port == port);
+        mask |= pins[i]->pin;
+        lane[__builtin_ctz(pins[i]->pin)] = i;
+    }
+    
+    FURI_CRITICAL_ENTER();
+    uint32_t start = dht11_timing_now();
+    
+    // Release every line of the group; they now share one time base
+    for(uint8_t i = 0; i < count; i++) {
+        furi_hal_gpio_init(pins[i], GpioModeInput, GpioPullUp, GpioSpeedLow);
+    }
+    
+    // Sample the input register on fixed cycle deadlines
+    uint32_t deadline = dht11_timing_now();
+    for(uint16_t k = 0; k < DHT11_PORT_SAMPLES; k++) {
+        while((int32_t)(dht11_timing_now() - deadline) < 0) {
+        }
+        words[k] = (uint16_t)port->IDR;
+        deadline += period_cycles;
+    }
+    
+    uint32_t irq_off = dht11_timing_now() - start;
+    FURI_CRITICAL_EXIT();
+    
+    dht11_port_extract_edges(words, mask, lane, transfers, period_cycles);
+    
+    // Response phases are ~80us; anything past the timeout is not a DHT11
+    for(uint8_t i = 0; i < count; i++) {
+        dht11_decoder_finish_trace(transfers[i], dht11_timing.response_timeout);
+    }
+    
+    return irq_off;
+}
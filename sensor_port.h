@@ -0,0 +1,43 @@
+/**
+ * @file sensor_port.h
+ * @brief Whole-port sampling backend for simultaneous multi-sensor reads
+ * 
+ * Several DHT11s wired to the same GPIO port are read in a single
+ * interrupts-off window: the port input register is sampled at a fixed
+ * cadence timed by the DWT cycle counter, and every pin's edges are
+ * extracted from the captured port words afterwards.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_gpio.h>
+#include "decoder.h"
+
+/** @brief Sampling period of the port input register */
+#define DHT11_PORT_SAMPLE_US 4
+
+/** @brief Length of the sampling window, covers a full transfer */
+#define DHT11_PORT_WINDOW_US 6000
+
+/** @brief Number of port words captured per window */
+#define DHT11_PORT_SAMPLES (DHT11_PORT_WINDOW_US / DHT11_PORT_SAMPLE_US)
+
+/**
+ * @brief Release the data lines of one port and record all responses
+ * 
+ * All pins must be on the same GPIO port and must already be held low
+ * for the start pulse. Interrupts are disabled for the sampling window.
+ * Each transfer record receives the edge trace and status of its pin.
+ * 
+ * @param pins Data pins, all on the same port
+ * @param transfers Transfer record for each pin, reset by the caller
+ * @param count Number of pins
+ * @param words Scratch buffer of DHT11_PORT_SAMPLES port words
+ * @return Cycles spent with interrupts disabled
+ */
+uint32_t dht11_port_receive(
+    const GpioPin* const* pins,
+    DHT11Transfer* const* transfers,
+    uint8_t count,
+    uint16_t* words);
@@ -0,0 +1,74 @@
+/**
+ * @file sensor_power.c
+ * @brief Switchable sensor supply implementation
+ */
+
+#include "sensor_power.h"
+#include <furi.h>
+#include <furi_hal.h>
+
+/**
+ * @brief Drive the supply without any delay
+ * 
+ * @param power Pointer to the supply state
+ * @param on true to switch on
+ */
+static void dht11_sensor_power_set(DHT11SensorPower* power, bool on) {
+    switch(power->source) {
+    case DHT11SensorPowerGpio:
+        furi_hal_gpio_write(power->pin, on);
+        break;
+    case DHT11SensorPowerOtg:
+        if(on) {
+            furi_hal_power_enable_otg();
+        } else {
+            furi_hal_power_disable_otg();
+        }
+        break;
+    default:
+        break;
+    }
+    power->on = on;
+}
+
+void dht11_sensor_power_init(DHT11SensorPower* power, DHT11SensorPowerSource source, const GpioPin* pin) {
+    power->source = source;
+    power->pin = pin;
+    power->otg_was_enabled = source == DHT11SensorPowerOtg && furi_hal_power_is_otg_enabled();
+    
+    if(source == DHT11SensorPowerGpio) {
+        furi_hal_gpio_init(pin, GpioModeOutputPushPull, GpioPullNo, GpioSpeedLow);
+    }
+    dht11_sensor_power_set(power, true);
+}
+
+void dht11_sensor_power_deinit(DHT11SensorPower* power) {
+    if(power->source == DHT11SensorPowerOtg && !power->otg_was_enabled) {
+        furi_hal_power_disable_otg();
+    } else if(power->source == DHT11SensorPowerGpio) {
+        furi_hal_gpio_init(power->pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+    }
+    power->on = false;
+}
+
+bool dht11_sensor_power_is_switchable(const DHT11SensorPower* power) {
+    return power->source == DHT11SensorPowerGpio ||
+           (power->source == DHT11SensorPowerOtg && !power->otg_was_enabled);
+}
+
+void dht11_sensor_power_on(DHT11SensorPower* power) {
+    if(power->on) {
+        return;
+    }
+    
+    dht11_sensor_power_set(power, true);
+    furi_delay_ms(DHT11_SENSOR_POWER_WARMUP_MS);
+}
+
+void dht11_sensor_power_off(DHT11SensorPower* power) {
+    if(!power->on || !dht11_sensor_power_is_switchable(power)) {
+        return;
+    }
+    
+    dht11_sensor_power_set(power, false);
+}
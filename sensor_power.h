@@ -0,0 +1,76 @@
+/**
+ * @file sensor_power.h
+ * @brief Switchable sensor supply
+ * 
+ * The sensors can be powered from a GPIO pin or from the 5V header rail
+ * instead of the always-on 3.3V pin. Either supply can then be switched
+ * off between transactions, which is what the low-power logging mode
+ * does. A DHT11 needs about a second after power-up before it answers,
+ * so switching on includes that warm-up.
+ */
+
+#pragma once
+
+#include <furi_hal_gpio.h>
+
+/** @brief Time a DHT11 needs after power-up before the first transaction */
+#define DHT11_SENSOR_POWER_WARMUP_MS 1000
+
+/**
+ * @brief Where the sensors' VCC is connected
+ */
+typedef enum {
+    DHT11SensorPowerAlways,     /**< 3.3V pin, cannot be switched */
+    DHT11SensorPowerGpio,       /**< A GPIO pin driven high, a few mA at most */
+    DHT11SensorPowerOtg,        /**< 5V pin, supplied by the OTG boost converter */
+} DHT11SensorPowerSource;
+
+/**
+ * @brief Sensor supply state
+ */
+typedef struct {
+    DHT11SensorPowerSource source;  /**< Supply wiring */
+    const GpioPin* pin;             /**< Supply pin for DHT11SensorPowerGpio */
+    bool on;                        /**< Supply currently on */
+    bool otg_was_enabled;           /**< 5V was already on before init, leave it on */
+} DHT11SensorPower;
+
+/**
+ * @brief Switch the supply on and keep it on
+ * 
+ * @param power Pointer to the supply state
+ * @param source Supply wiring
+ * @param pin Supply pin, used with DHT11SensorPowerGpio only
+ */
+void dht11_sensor_power_init(DHT11SensorPower* power, DHT11SensorPowerSource source, const GpioPin* pin);
+
+/**
+ * @brief Release the supply pin or rail
+ * 
+ * @param power Pointer to the supply state
+ */
+void dht11_sensor_power_deinit(DHT11SensorPower* power);
+
+/**
+ * @brief Check whether the supply can be switched at all
+ * 
+ * @param power Pointer to the supply state
+ * @return false for DHT11SensorPowerAlways, or a 5V rail someone else turned on
+ */
+bool dht11_sensor_power_is_switchable(const DHT11SensorPower* power);
+
+/**
+ * @brief Switch the supply on, waiting out the warm-up if it was off
+ * 
+ * @param power Pointer to the supply state
+ */
+void dht11_sensor_power_on(DHT11SensorPower* power);
+
+/**
+ * @brief Switch the supply off
+ * 
+ * Does nothing on an always-on supply.
+ * 
+ * @param power Pointer to the supply state
+ */
+void dht11_sensor_power_off(DHT11SensorPower* power);
@@ -0,0 +1,216 @@
+/**
+ * @file sensor_view.c
+ * @brief Live sensor reading view implementation
+ */
+
+#include "sensor_view.h"
+#include "app.h"
+#include "psychro.h"
+#include "format.h"
+#include <gui/elements.h>
+
+struct DHT11SensorView {
+    View* view;                         /**< Underlying view */
+    DHT11SensorViewCallback callback;   /**< Input callback */
+    void* context;                      /**< Context for the callback */
+};
+
+/**
+ * @brief Model drawn by the view
+ */
+typedef struct {
+    DHT11Sample sample;                 /**< Newest sample */
+    bool have_sample;                   /**< sample is valid */
+    char name[4];                       /**< Data pin name */
+    const char* family;                 /**< Part name, static */
+    uint8_t index;                      /**< Position of the sensor */
+    uint8_t count;                      /**< Number of sensors */
+    bool imperial;                      /**< Show Fahrenheit */
+} DHT11SensorViewModel;
+
+/**
+ * @brief Draw callback
+ * 
+ * Title, readings on the left, Heat Index and dew point on the right and
+ * button hints at the bottom. Only stack buffers are used.
+ * 
+ * @param canvas Canvas to draw on
+ * @param _model DHT11SensorViewModel
+ */
+static void dht11_sensor_view_draw(Canvas* canvas, void* _model) {
+    DHT11SensorViewModel* model = _model;
+    char buffer[32];
+    
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+    
+    // Title
+    canvas_set_font(canvas, FontPrimary);
+    if(model->count > 1) {
+        snprintf(
+            buffer, sizeof(buffer), "%s %s (%d/%d)", model->family, model->name, model->index + 1, model->count);
+        canvas_draw_str_aligned(canvas, 64, 5, AlignCenter, AlignTop, buffer);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s Sensor", model->family);
+        canvas_draw_str_aligned(canvas, 25, 5, AlignLeft, AlignTop, buffer);
+    }
+    
+    canvas_set_font(canvas, FontSecondary);
+    if(model->have_sample && model->sample.ok) {
+        // Readings - left column
+        canvas_draw_str_aligned(canvas, 10, 18, AlignLeft, AlignTop, "Temperature:");
+        dht11_format_temperature(buffer, sizeof(buffer), model->sample.temperature, model->imperial);
+        canvas_draw_str_aligned(canvas, 10, 28, AlignLeft, AlignTop, buffer);
+        
+        canvas_draw_str_aligned(canvas, 10, 38, AlignLeft, AlignTop, "Humidity:");
+        size_t length = dht11_format_fixed(buffer, sizeof(buffer), model->sample.humidity, 1);
+        snprintf(buffer + length, sizeof(buffer) - length, "%%");
+        canvas_draw_str_aligned(canvas, 10, 48, AlignLeft, AlignTop, buffer);
+        
+        // Flag readings that only passed after checksum recovery
+        if(model->sample.recovered_bits > 0) {
+            canvas_draw_str_aligned(canvas, 124, 5, AlignRight, AlignTop, "R");
+        }
+        
+        // Heat Index and dew point - right column; the DHT11 reports whole numbers only
+        DHT11Psychro psychro;
+        bool derived = dht11_psychro_lookup_tenths(model->sample.humidity, model->sample.temperature, &psychro);
+        canvas_draw_str_aligned(canvas, 75, 18, AlignLeft, AlignTop, "Heat Index:");
+        if(derived) {
+            dht11_format_temperature(buffer, sizeof(buffer), psychro.heat_index, model->imperial);
+        } else {
+            snprintf(buffer, sizeof(buffer), "--");
+        }
+        canvas_draw_str_aligned(canvas, 75, 28, AlignLeft, AlignTop, buffer);
+        
+        canvas_draw_str_aligned(canvas, 75, 38, AlignLeft, AlignTop, "Dew Point:");
+        if(derived) {
+            dht11_format_temperature(buffer, sizeof(buffer), psychro.dew_point, model->imperial);
+        } else {
+            snprintf(buffer, sizeof(buffer), "--");
+        }
+        canvas_draw_str_aligned(canvas, 75, 48, AlignLeft, AlignTop, buffer);
+    } else if(model->have_sample) {
+        // Show what went wrong when the reading failed
+        if(model->sample.status == DHT11StatusBitTimeout) {
+            snprintf(buffer, sizeof(buffer), "Error: bit %u timeout", model->sample.failed_bit);
+        } else {
+            snprintf(buffer, sizeof(buffer), "Error: %s", dht11_decoder_status_name(model->sample.status));
+        }
+        canvas_draw_str_aligned(canvas, 64, 25, AlignCenter, AlignTop, buffer);
+        canvas_draw_str_aligned(canvas, 15, 35, AlignLeft, AlignTop, "Check connections in");
+        canvas_draw_str_aligned(canvas, 30, 45, AlignLeft, AlignTop, "About section");
+    } else {
+        // Initial state - no reading yet
+        canvas_draw_str_aligned(canvas, 25, 30, AlignLeft, AlignTop, "Press OK to read");
+        canvas_draw_str_aligned(canvas, 30, 40, AlignLeft, AlignTop, "sensor data");
+    }
+    
+    elements_button_center(canvas, "READ");
+    if(model->count > 1) {
+        elements_button_left(canvas, "Prev");
+        elements_button_right(canvas, "Next");
+    }
+}
+
+/**
+ * @brief Input callback
+ * 
+ * @param event Input event
+ * @param context DHT11SensorView
+ * @return true if the event was consumed
+ */
+static bool dht11_sensor_view_input(InputEvent* event, void* context) {
+    DHT11SensorView* sensor_view = context;
+    
+    if(event->type != InputTypePress || !sensor_view->callback) {
+        return false;
+    }
+    
+    uint8_t count = 0;
+    with_view_model(
+        sensor_view->view, DHT11SensorViewModel * model, { count = model->count; }, false);
+    
+    if(event->key == InputKeyOk) {
+        sensor_view->callback(DHT11CustomEventRead, sensor_view->context);
+        return true;
+    } else if(event->key == InputKeyLeft && count > 1) {
+        sensor_view->callback(DHT11CustomEventPreviousSensor, sensor_view->context);
+        return true;
+    } else if(event->key == InputKeyRight && count > 1) {
+        sensor_view->callback(DHT11CustomEventNextSensor, sensor_view->context);
+        return true;
+    }
+    
+    return false;
+}
+
+DHT11SensorView* dht11_sensor_view_alloc(void) {
+    DHT11SensorView* sensor_view = malloc(sizeof(DHT11SensorView));
+    sensor_view->callback = NULL;
+    sensor_view->context = NULL;
+    
+    sensor_view->view = view_alloc();
+    view_allocate_model(sensor_view->view, ViewModelTypeLocking, sizeof(DHT11SensorViewModel));
+    view_set_context(sensor_view->view, sensor_view);
+    view_set_draw_callback(sensor_view->view, dht11_sensor_view_draw);
+    view_set_input_callback(sensor_view->view, dht11_sensor_view_input);
+    
+    with_view_model(
+        sensor_view->view,
+        DHT11SensorViewModel * model,
+        {
+            memset(model, 0, sizeof(DHT11SensorViewModel));
+            model->family = "DHT";
+        },
+        false);
+    
+    return sensor_view;
+}
+
+void dht11_sensor_view_free(DHT11SensorView* sensor_view) {
+    furi_assert(sensor_view);
+    view_free(sensor_view->view);
+    free(sensor_view);
+}
+
+View* dht11_sensor_view_get_view(DHT11SensorView* sensor_view) {
+    furi_assert(sensor_view);
+    return sensor_view->view;
+}
+
+void dht11_sensor_view_set_callback(
+    DHT11SensorView* sensor_view,
+    DHT11SensorViewCallback callback,
+    void* context) {
+    furi_assert(sensor_view);
+    sensor_view->callback = callback;
+    sensor_view->context = context;
+}
+
+void dht11_sensor_view_set_sample(
+    DHT11SensorView* sensor_view,
+    const char* name,
+    const char* family,
+    uint8_t index,
+    uint8_t count,
+    const DHT11Sample* sample,
+    bool imperial) {
+    furi_assert(sensor_view);
+    
+    with_view_model(
+        sensor_view->view,
+        DHT11SensorViewModel * model,
+        {
+            model->have_sample = sample != NULL;
+            if(sample) {
+                model->sample = *sample;
+            }
+            snprintf(model->name, sizeof(model->name), "%s", name ? name : "");
+            model->family = family ? family : "DHT";
+            model->index = index;
+            model->count = count;
+            model->imperial = imperial;
+        },
+        true);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file sensor_view.h
+ * @brief Live sensor reading view
+ * 
+ * A dedicated View with a locked model holding the latest sample of the
+ * selected sensor. Updating it is a model write and a redraw; nothing is
+ * allocated after the view has been created, so it can refresh at the
+ * acquisition rate without heap churn.
+ */
+
+#pragma once
+
+#include <gui/view.h>
+#include "sample_buffer.h"
+
+/**
+ * @brief Input callback, invoked with a DHT11CustomEvent
+ * 
+ * @param event Custom event for the pressed key
+ * @param context User context
+ */
+typedef void (*DHT11SensorViewCallback)(uint32_t event, void* context);
+
+/** @brief Sensor view instance */
+typedef struct DHT11SensorView DHT11SensorView;
+
+/**
+ * @brief Allocate the sensor view
+ * 
+ * @return Pointer to the allocated view
+ */
+DHT11SensorView* dht11_sensor_view_alloc(void);
+
+/**
+ * @brief Free the sensor view
+ * 
+ * @param sensor_view Pointer to the view
+ */
+void dht11_sensor_view_free(DHT11SensorView* sensor_view);
+
+/**
+ * @brief Get the underlying View for the view dispatcher
+ * 
+ * @param sensor_view Pointer to the view
+ * @return View instance
+ */
+View* dht11_sensor_view_get_view(DHT11SensorView* sensor_view);
+
+/**
+ * @brief Set the function called on OK, Left and Right
+ * 
+ * @param sensor_view Pointer to the view
+ * @param callback Callback receiving DHT11CustomEventRead, PreviousSensor or NextSensor
+ * @param context Context passed to the callback
+ */
+void dht11_sensor_view_set_callback(
+    DHT11SensorView* sensor_view,
+    DHT11SensorViewCallback callback,
+    void* context);
+
+/**
+ * @brief Show a sample
+ * 
+ * @param sensor_view Pointer to the view
+ * @param name Data pin name of the sensor
+ * @param family Part name of the sensor's family, or NULL if unknown
+ * @param index Position of the sensor, from 0
+ * @param count Number of sensors; selection hints are shown if more than one
+ * @param sample Newest sample of the sensor, or NULL if there is none yet
+ * @param imperial Show temperatures in Fahrenheit
+ */
+void dht11_sensor_view_set_sample(
+    DHT11SensorView* sensor_view,
+    const char* name,
+    const char* family,
+    uint8_t index,
+    uint8_t count,
+    const DHT11Sample* sample,
+    bool imperial);
@@ -0,0 +1,203 @@
+/**
+ * @file settings.c
+ * @brief Persisted application settings implementation
+ */
+
+#include "settings.h"
+#include "sensor.h"
+#include <flipper_format/flipper_format.h>
+#include <locale/locale.h>
+#include <math.h>
+
+#define DHT11_SETTINGS_KEY_PINS "Sensor pins"
+#define DHT11_SETTINGS_KEY_DHT22_PINS "DHT22 pins"
+#define DHT11_SETTINGS_KEY_DHT21_PINS "DHT21 pins"
+#define DHT11_SETTINGS_KEY_PERIOD "Period ms"
+#define DHT11_SETTINGS_KEY_THRESHOLD "Threshold us"
+#define DHT11_SETTINGS_KEY_START "Start ms"
+#define DHT11_SETTINGS_KEY_UNITS "Units"
+#define DHT11_SETTINGS_KEY_FILTER_STAGES "Filter stages"
+#define DHT11_SETTINGS_KEY_FILTER_MEDIAN "Filter median"
+#define DHT11_SETTINGS_KEY_FILTER_EMA "Filter EMA alpha"
+#define DHT11_SETTINGS_KEY_FILTER_SPIKE "Filter spike limits"
+#define DHT11_SETTINGS_KEY_LOG "Log"
+#define DHT11_SETTINGS_KEY_ALERTS "Alerts"
+#define DHT11_SETTINGS_KEY_ALERT_ACTIONS "Alert actions"
+#define DHT11_SETTINGS_KEY_ALERT_THRESHOLDS "Alert thresholds"
+
+/** @brief Longest start pulse accepted from the file */
+#define DHT11_SETTINGS_START_MAX_MS 30
+
+/** @brief Largest spike limit accepted from the file, per second */
+#define DHT11_SETTINGS_SPIKE_MAX 1000.0f
+
+void dht11_settings_default(DHT11Settings* settings) {
+    memset(settings, 0, sizeof(DHT11Settings));
+    settings->sensor_pins = DHT11_SENSOR_PINS;
+    settings->dht22_pins = DHT11_SENSOR_DHT22_PINS;
+    settings->dht21_pins = DHT11_SENSOR_DHT21_PINS;
+    settings->period_ms = DHT11_ACQUISITION_PERIOD_MS;
+    settings->units = DHT11UnitsLocale;
+    dht11_filter_config_default(&settings->filter);
+    settings->log = DHT11SettingsLogOff;
+    settings->alerts = false;
+    settings->alert_actions = DHT11_ALERT_DEFAULT_ACTIONS;
+    for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+        settings->alert_thresholds[i] = dht11_alert_default_rules[i].threshold;
+    }
+}
+
+/**
+ * @brief Read one uint32 key, keeping the current value unless it is in range
+ * 
+ * @param file Open settings file
+ * @param key Key name
+ * @param value Current value, replaced on success
+ * @param min Smallest accepted value
+ * @param max Largest accepted value
+ */
+static void dht11_settings_read_uint32(
+    FlipperFormat* file,
+    const char* key,
+    uint32_t* value,
+    uint32_t min,
+    uint32_t max) {
+    uint32_t read = 0;
+    
+    // Keys may appear in any order
+    flipper_format_rewind(file);
+    if(flipper_format_read_uint32(file, key, &read, 1) && read >= min && read <= max) {
+        *value = read;
+    }
+}
+
+bool dht11_settings_load(DHT11Settings* settings, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    uint32_t version = 0;
+    
+    bool ok = flipper_format_file_open_existing(file, path) &&
+              flipper_format_read_header(file, filetype, &version) &&
+              furi_string_equal_str(filetype, DHT11_SETTINGS_FILETYPE) &&
+              version == DHT11_SETTINGS_VERSION;
+    
+    if(ok) {
+        uint32_t all_pins = (1 << DHT11HeaderPinCount) - 1;
+        uint32_t value;
+        
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_PINS, &settings->sensor_pins, 0, all_pins);
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_DHT22_PINS, &settings->dht22_pins, 0, all_pins);
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_DHT21_PINS, &settings->dht21_pins, 0, all_pins);
+        dht11_settings_read_uint32(
+            file, DHT11_SETTINGS_KEY_PERIOD, &settings->period_ms, DHT11_MIN_INTERVAL_MS, UINT32_MAX);
+        dht11_settings_read_uint32(
+            file, DHT11_SETTINGS_KEY_THRESHOLD, &settings->threshold_us, 0, DHT11_CALIBRATION_MAX_US);
+        if(settings->threshold_us < DHT11_CALIBRATION_MIN_US) {
+            settings->threshold_us = 0;
+        }
+        dht11_settings_read_uint32(
+            file, DHT11_SETTINGS_KEY_START, &settings->start_ms, 0, DHT11_SETTINGS_START_MAX_MS);
+        
+        value = settings->units;
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_UNITS, &value, 0, DHT11UnitsCount - 1);
+        settings->units = value;
+        
+        value = settings->filter.stages;
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_FILTER_STAGES, &value, 0, UINT8_MAX);
+        settings->filter.stages = value;
+        value = settings->filter.median_size;
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_FILTER_MEDIAN, &value, 1, DHT11_FILTER_MEDIAN_MAX);
+        settings->filter.median_size = value;
+        
+        // The file keeps readable decimals; the app works in fixed point
+        float alpha = 0.0f;
+        flipper_format_rewind(file);
+        if(flipper_format_read_float(file, DHT11_SETTINGS_KEY_FILTER_EMA, &alpha, 1) && alpha > 0.0f &&
+           alpha <= 1.0f) {
+            settings->filter.ema_alpha = MAX(lroundf(alpha * DHT11_FILTER_EMA_ONE), 1);
+        }
+        float spike[2] = {0};
+        flipper_format_rewind(file);
+        if(flipper_format_read_float(file, DHT11_SETTINGS_KEY_FILTER_SPIKE, spike, 2) && spike[0] >= 0.1f &&
+           spike[1] >= 0.1f && spike[0] <= DHT11_SETTINGS_SPIKE_MAX && spike[1] <= DHT11_SETTINGS_SPIKE_MAX) {
+            settings->filter.spike_temperature = lroundf(spike[0] * 10.0f);
+            settings->filter.spike_humidity = lroundf(spike[1] * 10.0f);
+        }
+        
+        value = settings->log;
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_LOG, &value, 0, DHT11SettingsLogCount - 1);
+        settings->log = value;
+        
+        flipper_format_rewind(file);
+        flipper_format_read_bool(file, DHT11_SETTINGS_KEY_ALERTS, &settings->alerts, 1);
+        dht11_settings_read_uint32(file, DHT11_SETTINGS_KEY_ALERT_ACTIONS, &settings->alert_actions, 0, UINT8_MAX);
+        float thresholds[DHT11_ALERT_MAX_RULES];
+        flipper_format_rewind(file);
+        if(flipper_format_read_float(file, DHT11_SETTINGS_KEY_ALERT_THRESHOLDS, thresholds, DHT11_ALERT_MAX_RULES)) {
+            for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+                float tenths = CLAMP(thresholds[i] * 10.0f, (float)INT16_MAX, (float)INT16_MIN);
+                settings->alert_thresholds[i] = (int16_t)lroundf(tenths);
+            }
+        }
+    }
+    
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+bool dht11_settings_save(const DHT11Settings* settings, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    uint32_t value;
+    
+    bool ok = flipper_format_file_open_always(file, path) &&
+              flipper_format_write_header_cstr(file, DHT11_SETTINGS_FILETYPE, DHT11_SETTINGS_VERSION);
+    
+    ok = ok && flipper_format_write_comment_cstr(file, "Pin masks in header order: A7 A6 A4 B3 B2 C3 C1 C0");
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_PINS, &settings->sensor_pins, 1);
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_DHT22_PINS, &settings->dht22_pins, 1);
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_DHT21_PINS, &settings->dht21_pins, 1);
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_PERIOD, &settings->period_ms, 1);
+    ok = ok && flipper_format_write_comment_cstr(file, "0 uses the sensor family's value");
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_THRESHOLD, &settings->threshold_us, 1);
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_START, &settings->start_ms, 1);
+    value = settings->units;
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_UNITS, &value, 1);
+    value = settings->filter.stages;
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_FILTER_STAGES, &value, 1);
+    value = settings->filter.median_size;
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_FILTER_MEDIAN, &value, 1);
+    float alpha = (float)settings->filter.ema_alpha / DHT11_FILTER_EMA_ONE;
+    ok = ok && flipper_format_write_float(file, DHT11_SETTINGS_KEY_FILTER_EMA, &alpha, 1);
+    float spike[2] = {settings->filter.spike_temperature / 10.0f, settings->filter.spike_humidity / 10.0f};
+    ok = ok && flipper_format_write_float(file, DHT11_SETTINGS_KEY_FILTER_SPIKE, spike, 2);
+    value = settings->log;
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_LOG, &value, 1);
+    ok = ok && flipper_format_write_bool(file, DHT11_SETTINGS_KEY_ALERTS, &settings->alerts, 1);
+    ok = ok && flipper_format_write_uint32(file, DHT11_SETTINGS_KEY_ALERT_ACTIONS, &settings->alert_actions, 1);
+    float thresholds[DHT11_ALERT_MAX_RULES];
+    for(uint8_t i = 0; i < DHT11_ALERT_MAX_RULES; i++) {
+        thresholds[i] = settings->alert_thresholds[i] / 10.0f;
+    }
+    ok = ok && flipper_format_write_float(
+                   file, DHT11_SETTINGS_KEY_ALERT_THRESHOLDS, thresholds, DHT11_ALERT_MAX_RULES);
+    
+    if(!ok) {
+        FURI_LOG_E("DHT11", "Failed to save settings %s", path);
+    }
+    
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+void dht11_settings_refresh_units(DHT11Settings* settings) {
+    if(settings->units == DHT11UnitsLocale) {
+        settings->imperial = locale_get_measurement_unit() == LocaleMeasurementUnitsImperial;
+    } else {
+        settings->imperial = settings->units == DHT11UnitsImperial;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file settings.h
+ * @brief Persisted application settings
+ * 
+ * Everything that used to be fixed at compile time and is worth changing
+ * on the device: attached sensors, sampling period, bit threshold and start
+ * pulse overrides, units, filter chain, logging and alerts. The settings
+ * are read from a FlipperFormat file once at startup into a plain struct
+ * that the rest of the app reads directly. The compile-time values remain
+ * as defaults for missing keys.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "filter.h"
+#include "alert.h"
+
+/** @brief Settings file location */
+#define DHT11_SETTINGS_PATH APP_DATA_PATH("settings.txt")
+
+/** @brief Settings file type */
+#define DHT11_SETTINGS_FILETYPE "DHT11 Settings"
+
+/** @brief Settings file format version */
+#define DHT11_SETTINGS_VERSION 1
+
+/**
+ * @brief Temperature units
+ */
+typedef enum {
+    DHT11UnitsLocale,       /**< Follow the system locale */
+    DHT11UnitsMetric,       /**< Always Celsius */
+    DHT11UnitsImperial,     /**< Always Fahrenheit */
+    DHT11UnitsCount,        /**< Number of choices */
+} DHT11Units;
+
+/**
+ * @brief SD logging started with the app
+ */
+typedef enum {
+    DHT11SettingsLogOff,    /**< Logging is started from the menu only */
+    DHT11SettingsLogCsv,    /**< Start logging CSV */
+    DHT11SettingsLogBinary, /**< Start logging binary records */
+    DHT11SettingsLogArchive, /**< Start logging to the compressed archive */
+    DHT11SettingsLogCount,  /**< Number of choices */
+} DHT11SettingsLog;
+
+/**
+ * @brief Application settings
+ */
+typedef struct {
+    uint32_t sensor_pins;           /**< DHT11HeaderPin mask of attached sensors */
+    uint32_t dht22_pins;            /**< Pins with a DHT22 attached */
+    uint32_t dht21_pins;            /**< Pins with a DHT21 attached */
+    uint32_t period_ms;             /**< Sampling period of each sensor */
+    uint32_t threshold_us;          /**< Fixed bit threshold, 0 to learn it from the family default and calibration file */
+    uint32_t start_ms;              /**< Start pulse length, 0 for the family default */
+    DHT11Units units;               /**< Temperature units */
+    DHT11FilterConfig filter;       /**< Filter chain */
+    DHT11SettingsLog log;           /**< Logging started with the app */
+    bool alerts;                    /**< Alerts enabled at startup */
+    uint32_t alert_actions;         /**< DHT11AlertAction mask */
+    int16_t alert_thresholds[DHT11_ALERT_MAX_RULES];    /**< Trigger level of each alert rule, in tenths */
+    bool imperial;                  /**< Resolved units, cached by dht11_settings_refresh_units() */
+} DHT11Settings;
+
+/**
+ * @brief Fill in the compile-time defaults
+ * 
+ * @param settings Pointer to the settings
+ */
+void dht11_settings_default(DHT11Settings* settings);
+
+/**
+ * @brief Load settings from a file on top of the current values
+ * 
+ * Keys missing from the file keep their current value, so load into
+ * defaults. Out of range values are ignored.
+ * 
+ * @param settings Pointer to the settings
+ * @param path Settings file path
+ * @return true if the file was read
+ */
+bool dht11_settings_load(DHT11Settings* settings, const char* path);
+
+/**
+ * @brief Store the settings in a file
+ * 
+ * @param settings Pointer to the settings
+ * @param path Settings file path
+ * @return true if the file was written
+ */
+bool dht11_settings_save(const DHT11Settings* settings, const char* path);
+
+/**
+ * @brief Resolve the temperature units
+ * 
+ * Looks the locale up when the units follow it. Call after loading and
+ * whenever the units setting changes; everything else reads
+ * settings->imperial.
+ * 
+ * @param settings Pointer to the settings
+ */
+void dht11_settings_refresh_units(DHT11Settings* settings);
@@ -0,0 +1,303 @@
+/**
+ * @file settings_scene.c
+ * @brief Settings scene implementation
+ * 
+ * Units, period, alerts and alert actions take effect at once. A changed
+ * filter restarts the acquisition thread when the scene is left. Sensors,
+ * start-up logging and the bit timing overrides are read at startup and
+ * apply from the next launch.
+ */
+
+#include "settings_scene.h"
+#include "sensor.h"
+#include "scenes.h"
+#include "scene_views.h"
+
+/** @brief Filter chain presets */
+typedef struct {
+    const char* label;      /**< Shown value */
+    uint8_t stages;         /**< DHT11FilterStage mask */
+} DHT11SettingsFilterPreset;
+
+static const char* const dht11_settings_units_labels[DHT11UnitsCount] = {
+    [DHT11UnitsLocale] = "System",
+    [DHT11UnitsMetric] = "°C",
+    [DHT11UnitsImperial] = "°F",
+};
+
+static const uint32_t dht11_settings_periods_s[] = {1, 2, 5, 10, 30, 60, 300};
+static const char* const dht11_settings_period_labels[] = {"1s", "2s", "5s", "10s", "30s", "1m", "5m"};
+
+static const DHT11SettingsFilterPreset dht11_settings_filters[] = {
+    {"Off", DHT11FilterStageStats},
+    {"Median", DHT11FilterStageMedian | DHT11FilterStageStats},
+    {"Spike+Med", DHT11FilterStageSpike | DHT11FilterStageMedian | DHT11FilterStageStats},
+    {"Smooth",
+     DHT11FilterStageSpike | DHT11FilterStageMedian | DHT11FilterStageEma | DHT11FilterStageStats},
+};
+
+static const char* const dht11_settings_log_labels[DHT11SettingsLogCount] = {
+    [DHT11SettingsLogOff] = "Off",
+    [DHT11SettingsLogCsv] = "CSV",
+    [DHT11SettingsLogBinary] = "Binary",
+    [DHT11SettingsLogArchive] = "Archive",
+};
+
+static const uint8_t dht11_settings_actions[] = {
+    DHT11AlertActionVibrate | DHT11AlertActionLed,
+    DHT11AlertActionVibrate | DHT11AlertActionLed | DHT11AlertActionSound,
+    DHT11AlertActionLed,
+};
+static const char* const dht11_settings_action_labels[] = {"Vibro+LED", "+Sound", "LED"};
+
+/** @brief Bit threshold choices, 0 for the family default */
+static const uint8_t dht11_settings_thresholds_us[] = {0, 30, 35, 40, 45, 50, 55};
+static const char* const dht11_settings_threshold_labels[] = {"Auto", "30us", "35us", "40us", "45us", "50us", "55us"};
+
+/** @brief Start pulse choices, 0 for the family default */
+static const uint8_t dht11_settings_starts_ms[] = {0, 1, 2, 5, 10, 18, 20, 25};
+static const char* const dht11_settings_start_labels[] = {"Auto", "1ms", "2ms", "5ms", "10ms", "18ms", "20ms", "25ms"};
+
+/** @brief Family on a header pin */
+static const char* const dht11_settings_pin_labels[] = {"None", "DHT11", "DHT22", "DHT21"};
+
+/** @brief Items before the per-pin items */
+typedef enum {
+    DHT11SettingsItemUnits,
+    DHT11SettingsItemPeriod,
+    DHT11SettingsItemFilter,
+    DHT11SettingsItemAlerts,
+    DHT11SettingsItemActions,
+    DHT11SettingsItemLog,
+    DHT11SettingsItemThreshold,
+    DHT11SettingsItemStart,
+    DHT11SettingsItemPins,
+} DHT11SettingsItem;
+
+/**
+ * @brief Find the choice matching a value
+ * 
+ * @param values Choice values
+ * @param count Number of choices
+ * @param value Value to look for
+ * @return Index of the value, 0 if it is not one of the choices
+ */
+static uint8_t dht11_settings_index_u8(const uint8_t* values, uint8_t count, uint32_t value) {
+    for(uint8_t i = 0; i < count; i++) {
+        if(values[i] == value) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Add an item with its current choice selected
+ * 
+ * @param app Application context
+ * @param label Item label
+ * @param labels Choice labels
+ * @param count Number of choices
+ * @param index Current choice
+ * @param callback Change callback
+ */
+static void dht11_settings_add(
+    DHT11App* app,
+    const char* label,
+    const char* const* labels,
+    uint8_t count,
+    uint8_t index,
+    VariableItemChangeCallback callback) {
+    VariableItem* item = variable_item_list_add(app->settings_list, label, count, callback, app);
+    variable_item_set_current_value_index(item, index);
+    variable_item_set_current_value_text(item, labels[index]);
+}
+
+/*
+ * Change callbacks: each shows the new choice and stores it in the
+ * settings, applying it right away where the setting allows.
+ */
+
+static void dht11_settings_units_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_units_labels[index]);
+    app->settings.units = index;
+    dht11_settings_refresh_units(&app->settings);
+}
+
+static void dht11_settings_period_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_period_labels[index]);
+    app->settings.period_ms = dht11_settings_periods_s[index] * 1000;
+    dht11_acquisition_set_period(app->acquisition, app->settings.period_ms);
+}
+
+static void dht11_settings_filter_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_filters[index].label);
+    app->settings.filter.stages = dht11_settings_filters[index].stages;
+}
+
+static void dht11_settings_alerts_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, index ? "On" : "Off");
+    app->settings.alerts = index;
+    dht11_alert_set_enabled(app->alerts, app->settings.alerts);
+}
+
+static void dht11_settings_actions_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_action_labels[index]);
+    app->settings.alert_actions = dht11_settings_actions[index];
+    app->alerts->actions = app->settings.alert_actions;
+}
+
+static void dht11_settings_log_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_log_labels[index]);
+    app->settings.log = index;
+}
+
+static void dht11_settings_threshold_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_threshold_labels[index]);
+    app->settings.threshold_us = dht11_settings_thresholds_us[index];
+}
+
+static void dht11_settings_start_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_start_labels[index]);
+    app->settings.start_ms = dht11_settings_starts_ms[index];
+}
+
+static void dht11_settings_pin_changed(VariableItem* item) {
+    DHT11App* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, dht11_settings_pin_labels[index]);
+    
+    // The changed item is the selected one; the pin items come last, in header order
+    uint8_t pin = variable_item_list_get_selected_item_index(app->settings_list) - DHT11SettingsItemPins;
+    uint32_t bit = 1 << pin;
+    DHT11Settings* settings = &app->settings;
+    settings->sensor_pins = index ? settings->sensor_pins | bit : settings->sensor_pins & ~bit;
+    settings->dht22_pins = index == 2 ? settings->dht22_pins | bit : settings->dht22_pins & ~bit;
+    settings->dht21_pins = index == 3 ? settings->dht21_pins | bit : settings->dht21_pins & ~bit;
+}
+
+void dht11_scene_settings_on_enter(void* context) {
+    DHT11App* app = context;
+    DHT11Settings* settings = &app->settings;
+    
+    dht11_scene_view_acquire(app, DHT11SceneSettings);
+    VariableItemList* list = app->settings_list;
+    
+    variable_item_list_reset(list);
+    
+    dht11_settings_add(
+        app, "Units", dht11_settings_units_labels, DHT11UnitsCount, settings->units, dht11_settings_units_changed);
+    
+    uint8_t period = 0;
+    for(uint8_t i = 0; i < COUNT_OF(dht11_settings_periods_s); i++) {
+        if(dht11_settings_periods_s[i] * 1000 <= settings->period_ms) {
+            period = i;
+        }
+    }
+    dht11_settings_add(
+        app,
+        "Period",
+        dht11_settings_period_labels,
+        COUNT_OF(dht11_settings_period_labels),
+        period,
+        dht11_settings_period_changed);
+    
+    uint8_t filter = 0;
+    for(uint8_t i = 0; i < COUNT_OF(dht11_settings_filters); i++) {
+        if(dht11_settings_filters[i].stages == settings->filter.stages) {
+            filter = i;
+        }
+    }
+    VariableItem* item = variable_item_list_add(
+        list, "Filter", COUNT_OF(dht11_settings_filters), dht11_settings_filter_changed, app);
+    variable_item_set_current_value_index(item, filter);
+    variable_item_set_current_value_text(item, dht11_settings_filters[filter].label);
+    
+    static const char* const on_off[] = {"Off", "On"};
+    dht11_settings_add(app, "Alerts", on_off, 2, app->alerts->enabled, dht11_settings_alerts_changed);
+    dht11_settings_add(
+        app,
+        "Alert action",
+        dht11_settings_action_labels,
+        COUNT_OF(dht11_settings_action_labels),
+        dht11_settings_index_u8(dht11_settings_actions, COUNT_OF(dht11_settings_actions), settings->alert_actions),
+        dht11_settings_actions_changed);
+    dht11_settings_add(
+        app, "Log at start", dht11_settings_log_labels, DHT11SettingsLogCount, settings->log, dht11_settings_log_changed);
+    dht11_settings_add(
+        app,
+        "Bit threshold",
+        dht11_settings_threshold_labels,
+        COUNT_OF(dht11_settings_threshold_labels),
+        dht11_settings_index_u8(
+            dht11_settings_thresholds_us, COUNT_OF(dht11_settings_thresholds_us), settings->threshold_us),
+        dht11_settings_threshold_changed);
+    dht11_settings_add(
+        app,
+        "Start pulse",
+        dht11_settings_start_labels,
+        COUNT_OF(dht11_settings_start_labels),
+        dht11_settings_index_u8(dht11_settings_starts_ms, COUNT_OF(dht11_settings_starts_ms), settings->start_ms),
+        dht11_settings_start_changed);
+    
+    char label[16];
+    for(uint8_t i = 0; i < DHT11HeaderPinCount; i++) {
+        uint32_t bit = 1 << i;
+        uint8_t family = 0;
+        if(settings->sensor_pins & bit) {
+            family = (settings->dht22_pins & bit) ? 2 : ((settings->dht21_pins & bit) ? 3 : 1);
+        }
+        snprintf(label, sizeof(label), "Pin %s", dht11_header_pins[i].name);
+        dht11_settings_add(
+            app, label, dht11_settings_pin_labels, COUNT_OF(dht11_settings_pin_labels), family, dht11_settings_pin_changed);
+    }
+    
+    // Remember the filter the acquisition thread runs with
+    scene_manager_set_scene_state(app->scene_manager, DHT11SceneSettings, settings->filter.stages);
+    view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneSettings);
+}
+
+bool dht11_scene_settings_on_event(void* context, SceneManagerEvent event) {
+    DHT11App* app = context;
+    bool consumed = false;
+    
+    if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+    
+    return consumed;
+}
+
+void dht11_scene_settings_on_exit(void* context) {
+    DHT11App* app = context;
+    
+    // The filter state belongs to the acquisition thread; swap it while stopped
+    if(app->settings.filter.stages != scene_manager_get_scene_state(app->scene_manager, DHT11SceneSettings)) {
+        dht11_acquisition_stop(app->acquisition);
+        dht11_acquisition_set_filter(app->acquisition, &app->settings.filter);
+        dht11_acquisition_start(app->acquisition);
+    }
+    
+    if(!dht11_settings_save(&app->settings, DHT11_SETTINGS_PATH)) {
+        notification_message(app->notifications, &sequence_error);
+    }
+    variable_item_list_reset(app->settings_list);
+    dht11_scene_view_release(app, DHT11SceneSettings);
+}
@@ -0,0 +1,11 @@
+/**
+ * @file settings_scene.h
+ * @brief Settings scene interface
+ * 
+ * This file contains the interface for the settings scene which edits
+ * the persisted settings and saves them to the SD card on exit.
+ */
+
+#pragma once
+
+#include "app.h"
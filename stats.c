@@ -0,0 +1,58 @@
+/**
+ * @file stats.c
+ * @brief Read path instrumentation implementation
+ */
+
+#include "stats.h"
+#include <furi.h>
+
+void dht11_stats_reset(DHT11Stats* stats, uint32_t now) {
+    memset(stats, 0, sizeof(DHT11Stats));
+    stats->start_tick = now;
+}
+
+void dht11_stats_record(
+    DHT11Stats* stats,
+    DHT11Status status,
+    bool recovered,
+    uint32_t latency_us,
+    uint32_t irq_off_us,
+    uint32_t start_us) {
+    stats->attempts++;
+    if(status == DHT11StatusOk) {
+        stats->successes++;
+        if(recovered) {
+            stats->recovered++;
+        }
+    } else if(status < DHT11StatusCount) {
+        stats->failures[status]++;
+    }
+    
+    uint32_t bin = 0;
+    if(latency_us > start_us) {
+        bin = MIN((latency_us - start_us) / DHT11_STATS_LATENCY_BIN_US, (uint32_t)DHT11_STATS_LATENCY_BINS - 1);
+    }
+    stats->latency[bin]++;
+    
+    stats->latency_max_us = MAX(stats->latency_max_us, latency_us);
+    stats->irq_off_max_us = MAX(stats->irq_off_max_us, irq_off_us);
+    stats->latency_total_us += latency_us;
+    stats->irq_off_total_us += irq_off_us;
+}
+
+uint32_t dht11_stats_samples_per_minute(const DHT11Stats* stats, uint32_t now) {
+    uint32_t elapsed = now - stats->start_tick;
+    uint32_t frequency = furi_kernel_get_tick_frequency();
+    if(elapsed < frequency) {
+        return 0;
+    }
+    return (uint64_t)stats->successes * 600 * frequency / elapsed;
+}
+
+uint32_t dht11_stats_latency_mean_us(const DHT11Stats* stats) {
+    return stats->attempts ? stats->latency_total_us / stats->attempts : 0;
+}
+
+uint32_t dht11_stats_irq_off_mean_us(const DHT11Stats* stats) {
+    return stats->attempts ? stats->irq_off_total_us / stats->attempts : 0;
+}
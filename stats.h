@@ -0,0 +1,89 @@
+/**
+ * @file stats.h
+ * @brief Read path instrumentation counters
+ * 
+ * Running totals fed by the sensor driver after every transaction, used to
+ * compare wiring, pull-up and threshold choices on real hardware.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "decoder.h"
+
+/** @brief Number of transaction latency histogram bins */
+#define DHT11_STATS_LATENCY_BINS 8
+
+/** @brief Width of one latency bin, counted from the end of the start pulse */
+#define DHT11_STATS_LATENCY_BIN_US 1000
+
+/**
+ * @brief Read path counters
+ */
+typedef struct {
+    uint32_t attempts;                              /**< Transactions started */
+    uint32_t successes;                             /**< Transactions with a valid reading */
+    uint32_t recovered;                             /**< Successes that needed checksum recovery */
+    uint32_t failures[DHT11StatusCount];            /**< Failed transactions by status */
+    uint32_t latency[DHT11_STATS_LATENCY_BINS];     /**< Transactions by duration after the start pulse */
+    uint32_t latency_max_us;                        /**< Longest transaction */
+    uint32_t irq_off_max_us;                        /**< Longest interrupts-disabled window */
+    uint64_t latency_total_us;                      /**< Sum of all transaction durations */
+    uint64_t irq_off_total_us;                      /**< Sum of all interrupts-disabled windows */
+    uint32_t start_tick;                            /**< Tick at which counting started */
+} DHT11Stats;
+
+/**
+ * @brief Clear all counters
+ * 
+ * @param stats Pointer to the counters
+ * @param now Current tick, start of the measurement period
+ */
+void dht11_stats_reset(DHT11Stats* stats, uint32_t now);
+
+/**
+ * @brief Account for one finished transaction
+ * 
+ * The histogram bins the time left after the start pulse, so sensors
+ * with different start pulses share the same bins.
+ * 
+ * @param stats Pointer to the counters
+ * @param status Final status of the transaction
+ * @param recovered The reading passed only after flipping bits
+ * @param latency_us Time from start pulse to decoded result
+ * @param irq_off_us Time spent with interrupts disabled, 0 if none
+ * @param start_us Length of the transaction's start pulse
+ */
+void dht11_stats_record(
+    DHT11Stats* stats,
+    DHT11Status status,
+    bool recovered,
+    uint32_t latency_us,
+    uint32_t irq_off_us,
+    uint32_t start_us);
+
+/**
+ * @brief Effective rate of good readings since the counters were reset
+ * 
+ * @param stats Pointer to the counters
+ * @param now Current tick
+ * @return Successful readings per minute, in tenths
+ */
+uint32_t dht11_stats_samples_per_minute(const DHT11Stats* stats, uint32_t now);
+
+/**
+ * @brief Mean transaction duration
+ * 
+ * @param stats Pointer to the counters
+ * @return Mean latency in microseconds, 0 before the first transaction
+ */
+uint32_t dht11_stats_latency_mean_us(const DHT11Stats* stats);
+
+/**
+ * @brief Mean interrupts-disabled window per transaction
+ * 
+ * @param stats Pointer to the counters
+ * @return Mean window in microseconds, 0 before the first transaction
+ */
+uint32_t dht11_stats_irq_off_mean_us(const DHT11Stats* stats);
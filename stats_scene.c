@@ -0,0 +1,210 @@
+/**
+ * @file stats_scene.c
+ * @brief Statistics scene implementation
+ */
+
+#include "stats_scene.h"
+#include "sensor.h"
+#include "scenes.h"
+#include "scene_views.h"
+#include "format.h"
+#include <stdarg.h>
+
+/**
+ * @brief Append formatted text to the statistics buffer
+ * 
+ * @param app Pointer to the application instance
+ * @param pos Current write position, advanced by the appended length
+ * @param format printf-style format string
+ */
+static void dht11_stats_text_append(DHT11App* app, size_t* pos, const char* format, ...) {
+    if(*pos >= DHT11_STATS_TEXT_SIZE - 1) {
+        return;
+    }
+    
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(app->stats_text + *pos, DHT11_STATS_TEXT_SIZE - *pos, format, args);
+    va_end(args);
+    
+    if(written > 0) {
+        *pos = MIN(*pos + written, DHT11_STATS_TEXT_SIZE - 1);
+    }
+}
+
+/**
+ * @brief Append the running statistics of one filtered quantity
+ * 
+ * @param app Pointer to the application instance
+ * @param pos Current write position, advanced by the appended length
+ * @param label Quantity label
+ * @param stats Running statistics, at least one value seen
+ */
+static void dht11_stats_append_filter(DHT11App* app, size_t* pos, const char* label, const DHT11FilterStats* stats) {
+    char min[DHT11_FORMAT_FIXED_SIZE];
+    char mean[DHT11_FORMAT_FIXED_SIZE];
+    char max[DHT11_FORMAT_FIXED_SIZE];
+    char deviation[DHT11_FORMAT_FIXED_SIZE];
+    
+    dht11_format_fixed(min, sizeof(min), stats->min, 1);
+    dht11_format_fixed(mean, sizeof(mean), dht11_filter_stats_mean(stats), 1);
+    dht11_format_fixed(max, sizeof(max), stats->max, 1);
+    dht11_format_fixed(deviation, sizeof(deviation), dht11_filter_stats_deviation(stats), 2);
+    dht11_stats_text_append(app, pos, "  %s %s/%s/%s sd %s\n", label, min, mean, max, deviation);
+}
+
+/**
+ * @brief Render the current counters into the text box
+ * 
+ * @param app Pointer to the application instance
+ */
+static void dht11_stats_scene_update(DHT11App* app) {
+    DHT11Stats stats;
+    uint32_t now = furi_get_tick();
+    size_t pos = 0;
+    
+    dht11_sensor_get_stats(app, &stats);
+    app->stats_text[0] = '\0';
+    
+    uint32_t percent = stats.attempts ? stats.successes * 100 / stats.attempts : 0;
+    uint32_t uptime = (now - stats.start_tick) / furi_kernel_get_tick_frequency();
+    
+    dht11_stats_text_append(app, &pos, "=== Read Statistics ===\n");
+    dht11_stats_text_append(
+        app, &pos, "Uptime: %lum %02lus\n", (unsigned long)(uptime / 60), (unsigned long)(uptime % 60));
+    dht11_stats_text_append(
+        app,
+        &pos,
+        "Reads: %lu ok %lu (%lu%%)\n",
+        (unsigned long)stats.attempts,
+        (unsigned long)stats.successes,
+        (unsigned long)percent);
+    dht11_stats_text_append(app, &pos, "Recovered: %lu\n", (unsigned long)stats.recovered);
+    char rate[DHT11_FORMAT_FIXED_SIZE];
+    dht11_format_fixed(rate, sizeof(rate), dht11_stats_samples_per_minute(&stats, now), 1);
+    dht11_stats_text_append(app, &pos, "Rate: %s samples/min\n", rate);
+    
+    dht11_stats_text_append(app, &pos, "\nFailures:\n");
+    for(uint8_t i = DHT11StatusOk + 1; i < DHT11StatusCount; i++) {
+        dht11_stats_text_append(
+            app, &pos, "- %s: %lu\n", dht11_decoder_status_name(i), (unsigned long)stats.failures[i]);
+    }
+    
+    // Per-sensor outcomes, with the backoff of sensors that stopped answering
+    dht11_stats_text_append(app, &pos, "\nSensors:\n");
+    for(uint8_t i = 0; i < app->sensor_count; i++) {
+        const DHT11SensorCache* cache = &app->sensors[i].driver->cache;
+        const DHT11Retry* retry = &app->acquisition->retry[i];
+        uint32_t failed = 0;
+        for(uint8_t j = DHT11StatusOk + 1; j < DHT11StatusCount; j++) {
+            failed += cache->outcomes[j];
+        }
+        
+        dht11_stats_text_append(
+            app,
+            &pos,
+            "- %s: %lu ok %lu failed\n",
+            app->sensors[i].name,
+            (unsigned long)cache->outcomes[DHT11StatusOk],
+            (unsigned long)failed);
+        if(cache->transacted && cache->last.status != DHT11StatusOk) {
+            dht11_stats_text_append(app, &pos, "  Last: %s\n", dht11_decoder_status_name(cache->last.status));
+        }
+        if(retry->silent > 1) {
+            dht11_stats_text_append(
+                app, &pos, "  Backoff: %lus\n", (unsigned long)(retry->delay / furi_kernel_get_tick_frequency()));
+        }
+        
+        // Running statistics of the filtered stream
+        const DHT11Filter* filter = &app->acquisition->filter[i];
+        if(filter->temperature.stats.count > 0) {
+            dht11_stats_append_filter(app, &pos, "T", &filter->temperature.stats);
+            dht11_stats_append_filter(app, &pos, "H", &filter->humidity.stats);
+        }
+        if(filter->spikes > 0) {
+            dht11_stats_text_append(app, &pos, "  Spikes: %lu\n", (unsigned long)filter->spikes);
+        }
+    }
+    
+    if(app->alerts->enabled) {
+        uint8_t active = 0;
+        for(uint8_t i = 0; i < app->sensor_count; i++) {
+            active += dht11_alert_active_count(app->alerts, i);
+        }
+        dht11_stats_text_append(
+            app,
+            &pos,
+            "\nAlerts: %lu triggered, %u active\n",
+            (unsigned long)app->alerts->triggered,
+            active);
+        if(app->alerts->write_errors > 0) {
+            dht11_stats_text_append(
+                app, &pos, "Event write errors: %lu\n", (unsigned long)app->alerts->write_errors);
+        }
+    }
+    
+    dht11_stats_text_append(app, &pos, "\nLatency after start pulse:\n");
+    for(uint8_t i = 0; i < DHT11_STATS_LATENCY_BINS; i++) {
+        uint32_t from_ms = i * DHT11_STATS_LATENCY_BIN_US / 1000;
+        dht11_stats_text_append(
+            app,
+            &pos,
+            "- %s%lums: %lu\n",
+            i == 0 ? "<" : (i == DHT11_STATS_LATENCY_BINS - 1 ? ">=" : ""),
+            (unsigned long)(i == 0 ? from_ms + DHT11_STATS_LATENCY_BIN_US / 1000 : from_ms),
+            (unsigned long)stats.latency[i]);
+    }
+    dht11_stats_text_append(
+        app,
+        &pos,
+        "Latency: mean %luus max %luus\n",
+        (unsigned long)dht11_stats_latency_mean_us(&stats),
+        (unsigned long)stats.latency_max_us);
+    dht11_stats_text_append(
+        app,
+        &pos,
+        "IRQ off: mean %luus max %luus\n",
+        (unsigned long)dht11_stats_irq_off_mean_us(&stats),
+        (unsigned long)stats.irq_off_max_us);
+    
+    if(app->usb_stream) {
+        DHT11UsbStream* stream = app->usb_stream;
+        dht11_stats_text_append(app, &pos, "\nUSB stream:%s\n", stream->connected ? "" : " no host");
+        dht11_stats_text_append(app, &pos, "- Sent: %lu\n", (unsigned long)stream->sent);
+        dht11_stats_text_append(
+            app, &pos, "- Dropped: %lu\n", (unsigned long)(stream->overflowed + stream->unsent));
+    }
+    
+    text_box_set_text(app->stats_text_box, app->stats_text);
+}
+
+void dht11_scene_stats_on_enter(void* context) {
+    DHT11App* app = context;
+    dht11_scene_view_acquire(app, DHT11SceneStats);
+    
+    text_box_set_font(app->stats_text_box, TextBoxFontText);
+    dht11_stats_scene_update(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, DHT11SceneStats);
+}
+
+bool dht11_scene_stats_on_event(void* context, SceneManagerEvent event) {
+    DHT11App* app = context;
+    bool consumed = false;
+    
+    if(event.type == SceneManagerEventTypeCustom && event.event == DHT11CustomEventSampleReady) {
+        // Counters change with every transaction
+        dht11_stats_scene_update(app);
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_previous_scene(app->scene_manager);
+        consumed = true;
+    }
+    
+    return consumed;
+}
+
+void dht11_scene_stats_on_exit(void* context) {
+    DHT11App* app = context;
+    text_box_reset(app->stats_text_box);
+    dht11_scene_view_release(app, DHT11SceneStats);
+}
@@ -0,0 +1,14 @@
+/**
+ * @file stats_scene.h
+ * @brief Statistics scene interface
+ * 
+ * This file contains the interface for the statistics scene which displays
+ * live read path counters collected by the sensor driver.
+ */
+
+#pragma once
+
+#include "app.h"
+
+/** @brief Size of the statistics text, allocated while the scene is shown */
+#define DHT11_STATS_TEXT_SIZE 2048
@@ -0,0 +1,18 @@
+/**
+ * @file timing.c
+ * @brief Cycle-deadline timing core implementation
+ */
+
+#include "timing.h"
+
+DHT11Timing dht11_timing;
+
+void dht11_timing_init(void) {
+    // Enable the cycle counter used for all pulse timing
+    dht11_hal_clock_init();
+    
+    dht11_timing.cycles_per_us = dht11_hal_clock_hz() / 1000000;
+    dht11_timing.release = DHT11_TIMING_RELEASE_US * dht11_timing.cycles_per_us;
+    dht11_timing.response_timeout = DHT11_TIMING_RESPONSE_TIMEOUT_US * dht11_timing.cycles_per_us;
+    dht11_timing.bit_timeout = DHT11_TIMING_BIT_TIMEOUT_US * dht11_timing.cycles_per_us;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file timing.h
+ * @brief Cycle-deadline timing core shared by the read backends
+ * 
+ * All protocol timings are converted to DWT cycle counts once, from
+ * SystemCoreClock, when the driver starts. Waits then compare raw
+ * DWT->CYCCNT deltas against those precomputed limits, so the hot loops
+ * contain no divisions and a timeout of N microseconds really is N
+ * microseconds regardless of how long a loop iteration takes. Hardware is
+ * only reached through hal.h.
+ */
+
+#pragma once
+
+#include "hal.h"
+
+/** @brief Host release time at the end of the start signal */
+#define DHT11_TIMING_RELEASE_US 30
+
+/** @brief Longest accepted wait for the response and each response phase */
+#define DHT11_TIMING_RESPONSE_TIMEOUT_US 200
+
+/** @brief Longest accepted low or high phase of a data bit */
+#define DHT11_TIMING_BIT_TIMEOUT_US 200
+
+/**
+ * @brief Protocol timings in cycles of the DWT counter
+ */
+typedef struct {
+    uint32_t cycles_per_us;         /**< Counter ticks per microsecond */
+    uint32_t release;               /**< DHT11_TIMING_RELEASE_US */
+    uint32_t response_timeout;      /**< DHT11_TIMING_RESPONSE_TIMEOUT_US */
+    uint32_t bit_timeout;           /**< DHT11_TIMING_BIT_TIMEOUT_US */
+} DHT11Timing;
+
+/** @brief Timings for the current core clock, valid after dht11_timing_init() */
+extern DHT11Timing dht11_timing;
+
+/**
+ * @brief Enable the DWT cycle counter and precompute all timings
+ * 
+ * Must be called again if SystemCoreClock changes.
+ */
+void dht11_timing_init(void);
+
+/**
+ * @brief Current cycle counter value
+ * 
+ * @return DWT cycle count
+ */
+static inline uint32_t dht11_timing_now(void) {
+    return dht11_hal_cycles();
+}
+
+/**
+ * @brief Busy-wait for a number of cycles
+ * 
+ * @param cycles Cycles to wait
+ */
+static inline void dht11_timing_delay(uint32_t cycles) {
+    uint32_t start = dht11_hal_cycles();
+    while(dht11_hal_cycles() - start < cycles) {
+    }
+}
+
+/**
+ * @brief Busy-wait while a pin holds a level
+ * 
+ * @param pin GPIO pin to watch
+ * @param level Level to wait out
+ * @param start Cycle count the timeout is measured from
+ * @param timeout Cycles after start at which to give up
+ * @param edge Output for the cycle count at which the wait ended
+ * @return true if the level changed, false on timeout
+ */
+static inline bool dht11_timing_wait_while(
+    DHT11HalPin pin,
+    bool level,
+    uint32_t start,
+    uint32_t timeout,
+    uint32_t* edge) {
+    while(dht11_hal_pin_read(pin) == level) {
+        if(dht11_hal_cycles() - start > timeout) {
+            *edge = dht11_hal_cycles();
+            return false;
+        }
+    }
+    *edge = dht11_hal_cycles();
+    return true;
+}
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Export a time range of a DHT11 SD archive (log.arc) as CSV.
+
+The archive is the delta-compressed log described in archive.h. Its
+index, log.arc.idx, is used to seek straight to the first block of the
+range, so only the blocks of the range are read however long the log is.
+Blocks missing from the index are scanned from the last indexed one.
+
+    python3 tools/dht11_archive.py log.arc --from 2024-05-01 --to 2024-05-02
+    python3 tools/dht11_archive.py log.arc --sensor 1 > sensor1.csv
+    python3 tools/dht11_archive.py log.arc --info
+
+Times are Unix seconds or ISO 8601 dates. The Flipper's clock keeps local
+time without a zone, so dates without an offset are read as that clock.
+The columns match the CSV log without the tick column.
+"""
+
+import argparse
+import bisect
+import datetime
+import os
+import struct
+import sys
+
+MAGIC = b"DHTZ"
+VERSION = 1
+INDEX_SUFFIX = ".idx"
+
+HEADER = struct.Struct("<4sBBHI")
+BLOCK_HEADER = struct.Struct("<IHH")
+INDEX_ENTRY = struct.Struct("<II")
+
+TAG_SENSOR = 0x07
+TAG_TIME = 0x08
+TEMPERATURE_SHIFT = 4
+HUMIDITY_SHIFT = 6
+
+SENSORS = 8
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def varint(data, position, end):
+    """Read a varint, returning the value and the position after it."""
+    value = 0
+    shift = 0
+    while position < end:
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, position
+        shift += 7
+    raise ValueError("varint runs past the block")
+
+
+def delta(code, data, position, end):
+    if code == 0:
+        return 0, position
+    if code == 1:
+        return 1, position
+    if code == 2:
+        return -1, position
+    field, position = varint(data, position, end)
+    return unzigzag(field), position
+
+
+def decode_block(block, block_size):
+    """Yield (timestamp, sensor, ok, temperature, humidity) of one data block."""
+    timestamp, count, length = BLOCK_HEADER.unpack_from(block)
+    if length > block_size - BLOCK_HEADER.size:
+        return
+    tracks = [[timestamp, 0, 0, 0] for _ in range(SENSORS)]
+    position = BLOCK_HEADER.size
+    end = position + length
+    for _ in range(count):
+        if position >= end:
+            return
+        tag = block[position]
+        position += 1
+        track = tracks[tag & TAG_SENSOR]
+        step = track[1]
+        ok = True
+        try:
+            if tag & TAG_TIME:
+                field, position = varint(block, position, end)
+                ok = not field & 1
+                step = unzigzag(field >> 1)
+            if ok:
+                temperature, position = delta((tag >> TEMPERATURE_SHIFT) & 3, block, position, end)
+                humidity, position = delta((tag >> HUMIDITY_SHIFT) & 3, block, position, end)
+                track[2] += temperature
+                track[3] += humidity
+        except ValueError:
+            return
+        track[0] = (track[0] + step) & 0xFFFFFFFF
+        track[1] = step
+        yield (track[0], tag & TAG_SENSOR, ok, track[2] if ok else None, track[3] if ok else None)
+
+
+class Archive:
+    def __init__(self, path):
+        self.file = open(path, "rb")
+        magic, version, _, self.block_size, self.start = HEADER.unpack(self.file.read(HEADER.size))
+        if magic != MAGIC or version != VERSION:
+            raise SystemExit(f"{path}: not a version {VERSION} DHT11 archive")
+        self.blocks = max(os.path.getsize(path) // self.block_size - 1, 0)
+        self.last = []
+        index = path + INDEX_SUFFIX
+        if os.path.exists(index):
+            with open(index, "rb") as file:
+                data = file.read()
+            usable = min(len(data) // INDEX_ENTRY.size, self.blocks)
+            self.last = [last for _, last in INDEX_ENTRY.iter_unpack(data[: usable * INDEX_ENTRY.size])]
+
+    def block(self, number):
+        self.file.seek((number + 1) * self.block_size)
+        return self.file.read(self.block_size)
+
+    def samples(self, start=None, stop=None):
+        """Yield the samples from start to stop, seeking through the index."""
+        first = 0 if start is None else bisect.bisect_left(self.last, start)
+        for number in range(first, self.blocks):
+            for sample in decode_block(self.block(number), self.block_size):
+                if stop is not None and sample[0] >= stop:
+                    return
+                if start is None or sample[0] >= start:
+                    yield sample
+
+    def reindex(self, path):
+        """Rewrite the index from the block contents."""
+        with open(path + INDEX_SUFFIX, "wb") as file:
+            first = last = 0
+            for number in range(self.blocks):
+                times = [sample[0] for sample in decode_block(self.block(number), self.block_size)]
+                if times:
+                    first, last = min(times), max(times)
+                file.write(INDEX_ENTRY.pack(first, last))
+
+
+def parse_time(text):
+    if text is None:
+        return None
+    if text.isdigit():
+        return int(text)
+    moment = datetime.datetime.fromisoformat(text)
+    if moment.tzinfo is None:
+        moment = moment.replace(tzinfo=datetime.timezone.utc)
+    return int(moment.timestamp())
+
+
+def tenths(value):
+    if value is None:
+        return ""
+    return f"{'-' if value < 0 else ''}{abs(value) // 10}.{abs(value) % 10}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("path", help="archive file, usually log.arc")
+    parser.add_argument("--from", dest="start", help="start of the range, inclusive")
+    parser.add_argument("--to", dest="stop", help="end of the range, exclusive")
+    parser.add_argument("--sensor", type=int, help="only this sensor index")
+    parser.add_argument("--info", action="store_true", help="print the size and span of the archive")
+    parser.add_argument("--reindex", action="store_true", help="rebuild the index file")
+    args = parser.parse_args()
+
+    archive = Archive(args.path)
+    if args.reindex:
+        archive.reindex(args.path)
+        archive = Archive(args.path)
+
+    if args.info:
+        samples = sum(1 for _ in archive.samples())
+        size = (archive.blocks + 1) * archive.block_size
+        print(f"blocks: {archive.blocks}, indexed: {len(archive.last)}")
+        print(f"samples: {samples}, {size / max(samples, 1):.2f} bytes per sample")
+        return
+
+    out = sys.stdout
+    out.write("timestamp,sensor,ok,temperature,humidity\n")
+    for timestamp, sensor, ok, temperature, humidity in archive.samples(parse_time(args.start), parse_time(args.stop)):
+        if args.sensor is not None and sensor != args.sensor:
+            continue
+        out.write(f"{timestamp},{sensor},{int(ok)},{tenths(temperature)},{tenths(humidity)}\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,388 @@
+/**
+ * @file dht11_replay.c
+ * @brief Host harness replaying waveforms through the polling receiver
+ * 
+ * Runs the device's polling receiver, bit decoder and checksum recovery
+ * on a simulated data line, see host_hal.h. Waveforms are generated from
+ * random readings or taken from a traces.bin capture, distorted with
+ * jitter, pulse-width skew and dropped edges, and every outcome is
+ * checked against the bytes the waveform encodes. Reports the decode
+ * success rate, how often a wrong reading was accepted, and the cost of
+ * each transaction: the simulated receive time and the host time spent
+ * decoding.
+ * 
+ *     make -C tools check
+ *     tools/dht11_replay -n 20000 -j 8 -s -4 -d 2
+ *     tools/dht11_replay -f traces.bin -p 100 -j 6
+ */
+
+#include "host_hal.h"
+#include "timing.h"
+#include "polling.h"
+#include "protocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief Harness options
+ */
+typedef struct {
+    uint32_t count;                 /**< Synthetic transactions */
+    const char* path;               /**< traces.bin to replay instead, or NULL */
+    uint32_t passes;                /**< Replays of every captured record */
+    DHT11WaveformNoise noise;       /**< Distortions */
+    const DHT11Protocol* protocol;  /**< Family for the threshold and range check */
+    uint8_t threshold_us;           /**< Bit threshold */
+    uint8_t margin_us;              /**< Recovery margin around the threshold */
+    uint8_t max_flips;              /**< Recovery limit, 0 for off */
+    uint32_t seed;                  /**< Generator seed */
+    double min_success;             /**< Lowest accepted success rate in percent */
+    double min_recovered;           /**< Lowest accepted recovered-reading rate in percent */
+    double max_wrong;               /**< Highest accepted wrong-reading rate in percent */
+} DHT11ReplayOptions;
+
+/**
+ * @brief Outcome counters of a run
+ */
+typedef struct {
+    uint32_t transactions;                  /**< Waveforms replayed */
+    uint32_t successes;                     /**< Accepted with the right bytes */
+    uint32_t recovered;                     /**< Successes that needed checksum recovery */
+    uint32_t wrong;                         /**< Accepted with the wrong bytes */
+    uint32_t unknown;                       /**< Accepted captures without known bytes */
+    uint32_t failures[DHT11StatusCount];    /**< Rejected transactions by status */
+    uint64_t receive_us;                    /**< Sum of simulated receive times */
+    uint32_t receive_max_us;                /**< Longest simulated receive */
+    uint64_t reads;                         /**< Samples of the line */
+    uint64_t decode_ns;                     /**< Host time spent decoding */
+} DHT11ReplayStats;
+
+/**
+ * @brief Range check for checksum recovery candidates
+ * 
+ * @param context Family the candidate is checked against
+ * @param data Candidate data bytes
+ * @return true if the candidate converts to plausible values
+ */
+static bool dht11_replay_accept(void* context, const uint8_t* data) {
+    int16_t temperature;
+    uint16_t humidity;
+    return dht11_protocol_convert(context, data, &temperature, &humidity);
+}
+
+/**
+ * @brief Host monotonic clock
+ * 
+ * @return Nanoseconds
+ */
+static uint64_t dht11_replay_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+/**
+ * @brief Receive and decode one waveform as the driver would
+ * 
+ * @param options Harness options
+ * @param waveform Distorted waveform
+ * @param stats Counters to update
+ */
+static void dht11_replay_transaction(
+    const DHT11ReplayOptions* options,
+    const DHT11Waveform* waveform,
+    DHT11ReplayStats* stats) {
+    static struct DHT11HostPin pin;
+    DHT11Transfer transfer;
+    uint32_t cycles_per_us = dht11_timing.cycles_per_us;
+    
+    dht11_host_pin_load(&pin, waveform);
+    dht11_decoder_reset(&transfer);
+    
+    // The start pulse itself is not simulated, only its end
+    dht11_hal_pin_drive(&pin);
+    dht11_hal_pin_write(&pin, false);
+    dht11_polling_receive(&pin, true, &transfer);
+    uint32_t receive_us = dht11_host_pin_elapsed(&pin) / cycles_per_us;
+    
+    uint64_t start = dht11_replay_now_ns();
+    dht11_decoder_decode(&transfer, options->threshold_us * cycles_per_us);
+    dht11_decoder_recover(
+        &transfer,
+        options->threshold_us * cycles_per_us,
+        options->margin_us * cycles_per_us,
+        options->max_flips,
+        dht11_replay_accept,
+        (void*)options->protocol);
+    int16_t temperature;
+    uint16_t humidity;
+    if(transfer.status == DHT11StatusOk &&
+       !dht11_protocol_convert(options->protocol, transfer.data, &temperature, &humidity)) {
+        transfer.status = DHT11StatusRange;
+    }
+    stats->decode_ns += dht11_replay_now_ns() - start;
+    
+    stats->transactions++;
+    stats->receive_us += receive_us;
+    stats->receive_max_us = receive_us > stats->receive_max_us ? receive_us : stats->receive_max_us;
+    stats->reads += pin.reads;
+    
+    if(transfer.status != DHT11StatusOk) {
+        stats->failures[transfer.status]++;
+    } else if(!waveform->known) {
+        stats->unknown++;
+    } else if(memcmp(transfer.data, waveform->data, sizeof(transfer.data)) != 0) {
+        stats->wrong++;
+    } else {
+        stats->successes++;
+        stats->recovered += transfer.recovered_bits > 0;
+    }
+}
+
+/**
+ * @brief Replay random readings
+ * 
+ * @param options Harness options
+ * @param stats Counters to update
+ */
+static void dht11_replay_synthetic(const DHT11ReplayOptions* options, DHT11ReplayStats* stats) {
+    uint32_t state = options->seed;
+    DHT11Waveform waveform;
+    uint8_t data[5];
+    
+    for(uint32_t i = 0; i < options->count; i++) {
+        dht11_waveform_random_data(data, options->protocol->high_weight, &state);
+        dht11_waveform_generate(&waveform, data);
+        dht11_waveform_perturb(&waveform, &waveform, &options->noise, &state);
+        dht11_replay_transaction(options, &waveform, stats);
+    }
+}
+
+/**
+ * @brief Replay the records of a traces.bin capture
+ * 
+ * @param options Harness options
+ * @param stats Counters to update
+ * @return false if the file could not be read
+ */
+static bool dht11_replay_capture(const DHT11ReplayOptions* options, DHT11ReplayStats* stats) {
+    FILE* file = fopen(options->path, "rb");
+    uint32_t clock_hz = 0;
+    uint16_t record_size = 0;
+    if(!file || !dht11_waveform_read_header(file, &clock_hz, &record_size)) {
+        fprintf(stderr, "%s: not a trace log\n", options->path);
+        if(file) {
+            fclose(file);
+        }
+        return false;
+    }
+    
+    uint32_t state = options->seed;
+    DHT11Waveform captured;
+    DHT11Waveform waveform;
+    while(dht11_waveform_read_record(file, clock_hz, record_size, options->threshold_us, &captured)) {
+        for(uint32_t pass = 0; pass < options->passes; pass++) {
+            dht11_waveform_perturb(&captured, &waveform, &options->noise, &state);
+            dht11_replay_transaction(options, &waveform, stats);
+        }
+    }
+    
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Percentage of a count
+ * 
+ * @param count Part
+ * @param total Whole
+ * @return Percent, 0 for an empty whole
+ */
+static double dht11_replay_percent(uint64_t count, uint64_t total) {
+    return total ? 100.0 * count / total : 0.0;
+}
+
+/**
+ * @brief Print the report of a run
+ * 
+ * @param options Harness options
+ * @param stats Counters of the run
+ */
+static void dht11_replay_report(const DHT11ReplayOptions* options, const DHT11ReplayStats* stats) {
+    uint32_t total = stats->transactions;
+    uint32_t divisor = total ? total : 1;
+    
+    printf(
+        "%s, threshold %uus, recovery %u flip(s) within %uus; jitter %uus, skew %dus, drops %u/1000 edges\n",
+        options->protocol->name,
+        options->threshold_us,
+        options->max_flips,
+        options->margin_us,
+        options->noise.jitter_us,
+        options->noise.skew_us,
+        options->noise.drop_permille);
+    printf("transactions: %u\n", total);
+    printf("success:      %u (%.2f%%)\n", stats->successes, dht11_replay_percent(stats->successes, total));
+    printf("recovered:    %u (%.2f%%)\n", stats->recovered, dht11_replay_percent(stats->recovered, total));
+    printf("wrong:        %u (%.2f%%)\n", stats->wrong, dht11_replay_percent(stats->wrong, total));
+    if(stats->unknown) {
+        printf("unverified:   %u (%.2f%%)\n", stats->unknown, dht11_replay_percent(stats->unknown, total));
+    }
+    for(uint8_t i = DHT11StatusOk + 1; i < DHT11StatusCount; i++) {
+        if(stats->failures[i]) {
+            printf(
+                "failed:       %u (%.2f%%) %s\n",
+                stats->failures[i],
+                dht11_replay_percent(stats->failures[i], total),
+                dht11_decoder_status_name(i));
+        }
+    }
+    printf(
+        "receive:      mean %lluus, max %uus, %llu line samples\n",
+        (unsigned long long)(stats->receive_us / divisor),
+        stats->receive_max_us,
+        (unsigned long long)(stats->reads / divisor));
+    printf("decode:       mean %lluns\n", (unsigned long long)(stats->decode_ns / divisor));
+}
+
+/**
+ * @brief Look up a family by part name
+ * 
+ * @param name Part name, case does not matter
+ * @return Descriptor, NULL if unknown
+ */
+static const DHT11Protocol* dht11_replay_family(const char* name) {
+    for(uint8_t i = 0; i < DHT11ProtocolCount; i++) {
+        if(strcasecmp(name, dht11_protocols[i].name) == 0) {
+            return &dht11_protocols[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Print the command line help
+ * 
+ * @param program Program name
+ */
+static void dht11_replay_usage(const char* program) {
+    fprintf(
+        stderr,
+        "usage: %s [options]\n"
+        "  -n COUNT   synthetic transactions (10000)\n"
+        "  -f FILE    replay the records of a traces.bin capture instead\n"
+        "  -p PASSES  replays of every captured record (1)\n"
+        "  -j US      jitter of every phase, either way (0)\n"
+        "  -s US      pulse-width skew, added to highs and taken from lows (0)\n"
+        "  -d N       dropped edges per 1000 (0)\n"
+        "  -F FAMILY  DHT11, DHT22 or DHT21 (DHT11)\n"
+        "  -t US      bit threshold (the family's)\n"
+        "  -M US      recovery margin around the threshold (%u)\n"
+        "  -r FLIPS   most bits flipped by recovery, 0 for off (%u)\n"
+        "  -S SEED    generator seed (1)\n"
+        "  -m PCT     fail below this success rate\n"
+        "  -R PCT     fail below this recovered-reading rate\n"
+        "  -w PCT     fail above this wrong-reading rate\n",
+        program,
+        DHT11_RECOVERY_MARGIN_US,
+        DHT11_RECOVERY_MAX_FLIPS);
+}
+
+int main(int argc, char** argv) {
+    DHT11ReplayOptions options = {
+        .count = 10000,
+        .passes = 1,
+        .protocol = &dht11_protocols[DHT11ProtocolDht11],
+        .margin_us = DHT11_RECOVERY_MARGIN_US,
+        .max_flips = DHT11_RECOVERY_MAX_FLIPS,
+        .seed = 1,
+        .min_success = -1.0,
+        .min_recovered = -1.0,
+        .max_wrong = 101.0,
+    };
+    int threshold_us = -1;
+    int option;
+    
+    while((option = getopt(argc, argv, "n:f:p:j:s:d:F:t:M:r:S:m:R:w:h")) != -1) {
+        switch(option) {
+        case 'n':
+            options.count = strtoul(optarg, NULL, 0);
+            break;
+        case 'f':
+            options.path = optarg;
+            break;
+        case 'p':
+            options.passes = strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            options.noise.jitter_us = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            options.noise.skew_us = strtol(optarg, NULL, 0);
+            break;
+        case 'd':
+            options.noise.drop_permille = strtoul(optarg, NULL, 0);
+            break;
+        case 'F':
+            options.protocol = dht11_replay_family(optarg);
+            if(!options.protocol) {
+                fprintf(stderr, "unknown family %s\n", optarg);
+                return 2;
+            }
+            break;
+        case 't':
+            threshold_us = strtol(optarg, NULL, 0);
+            break;
+        case 'M':
+            options.margin_us = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            options.max_flips = strtoul(optarg, NULL, 0);
+            break;
+        case 'S':
+            options.seed = strtoul(optarg, NULL, 0);
+            options.seed = options.seed ? options.seed : 1;
+            break;
+        case 'm':
+            options.min_success = strtod(optarg, NULL);
+            break;
+        case 'R':
+            options.min_recovered = strtod(optarg, NULL);
+            break;
+        case 'w':
+            options.max_wrong = strtod(optarg, NULL);
+            break;
+        default:
+            dht11_replay_usage(argv[0]);
+            return 2;
+        }
+    }
+    options.threshold_us = threshold_us > 0 ? threshold_us : options.protocol->threshold_us;
+    
+    dht11_timing_init();
+    DHT11ReplayStats stats = {0};
+    if(options.path) {
+        if(!dht11_replay_capture(&options, &stats)) {
+            return 2;
+        }
+    } else {
+        dht11_replay_synthetic(&options, &stats);
+    }
+    dht11_replay_report(&options, &stats);
+    
+    // Limits for regression runs
+    double success = dht11_replay_percent(stats.successes, stats.transactions);
+    double recovered = dht11_replay_percent(stats.recovered, stats.transactions);
+    double wrong = dht11_replay_percent(stats.wrong, stats.transactions);
+    if(success < options.min_success || recovered < options.min_recovered || wrong > options.max_wrong) {
+        printf("FAIL: success %.2f%% (at least %.2f%%), recovered %.2f%% (at least %.2f%%), "
+               "wrong %.2f%% (at most %.2f%%)\n",
+               success, options.min_success, recovered, options.min_recovered, wrong, options.max_wrong);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file host_hal.c
+ * @brief Simulated data line and cycle counter implementation
+ */
+
+#include "host_hal.h"
+
+/** @brief Simulated cycle counter, never wrapping within a run */
+static uint64_t dht11_host_cycles;
+
+void dht11_host_pin_load(struct DHT11HostPin* pin, const DHT11Waveform* waveform) {
+    pin->waveform = waveform;
+    pin->released = false;
+    pin->driven = true;
+    pin->release = 0;
+    pin->end = 0;
+    pin->phase = 0;
+    pin->reads = 0;
+}
+
+uint64_t dht11_host_pin_elapsed(const struct DHT11HostPin* pin) {
+    return pin->released ? dht11_host_cycles - pin->release : 0;
+}
+
+void dht11_hal_clock_init(void) {
+    dht11_host_cycles = 0;
+}
+
+uint32_t dht11_hal_clock_hz(void) {
+    return DHT11_WAVEFORM_CLOCK_HZ;
+}
+
+uint32_t dht11_hal_cycles(void) {
+    dht11_host_cycles += DHT11_HOST_POLL_CYCLES;
+    return (uint32_t)dht11_host_cycles;
+}
+
+bool dht11_hal_pin_read(DHT11HalPin pin) {
+    // The handle is const for the receiver; playback state is the harness's
+    struct DHT11HostPin* line = (struct DHT11HostPin*)pin;
+    line->reads++;
+    if(!line->released) {
+        return line->driven;
+    }
+    
+    const DHT11Waveform* waveform = line->waveform;
+    while(line->phase < waveform->count && dht11_host_cycles >= line->end) {
+        line->phase++;
+        if(line->phase < waveform->count) {
+            line->end += waveform->phases[line->phase];
+        }
+    }
+    
+    // Phases alternate starting high; after the last one the pull-up wins
+    return line->phase >= waveform->count || line->phase % 2 == 0;
+}
+
+void dht11_hal_pin_write(DHT11HalPin pin, bool level) {
+    ((struct DHT11HostPin*)pin)->driven = level;
+}
+
+void dht11_hal_pin_drive(DHT11HalPin pin) {
+    ((struct DHT11HostPin*)pin)->released = false;
+}
+
+void dht11_hal_pin_release(DHT11HalPin pin, bool pull_up) {
+    (void)pull_up;
+    struct DHT11HostPin* line = (struct DHT11HostPin*)pin;
+    line->released = true;
+    line->release = dht11_host_cycles;
+    line->phase = 0;
+    line->end = dht11_host_cycles + (line->waveform->count > 0 ? line->waveform->phases[0] : 0);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file host_hal.h
+ * @brief Simulated data line and cycle counter behind hal.h
+ * 
+ * Implements the DHT11_HAL_HOST side of hal.h for the host harness. The
+ * cycle counter is simulated rather than read from the host clock: every
+ * read of it advances time by DHT11_HOST_POLL_CYCLES, roughly one pass of
+ * a wait loop on the device, so a replay takes the same course on any
+ * machine. Once the receiver releases the line, it plays back the loaded
+ * waveform against that clock.
+ */
+
+#pragma once
+
+#include "hal.h"
+#include "waveform.h"
+
+/** @brief Simulated cycles per read of the cycle counter */
+#define DHT11_HOST_POLL_CYCLES 12
+
+/**
+ * @brief Simulated data line
+ */
+struct DHT11HostPin {
+    const DHT11Waveform* waveform;  /**< Phases played back after the release */
+    bool released;                  /**< The host released the line */
+    bool driven;                    /**< Level the host drives before the release */
+    uint64_t release;               /**< Cycle count at the release */
+    uint64_t end;                   /**< Cycle count at the end of the current phase */
+    uint8_t phase;                  /**< Phase being played back */
+    uint32_t reads;                 /**< Samples of the line since loading */
+};
+
+/**
+ * @brief Load a waveform for the next transaction
+ * 
+ * The waveform must stay valid until the next load.
+ * 
+ * @param pin Simulated line
+ * @param waveform Phases to play back
+ */
+void dht11_host_pin_load(struct DHT11HostPin* pin, const DHT11Waveform* waveform);
+
+/**
+ * @brief Simulated cycles since the line was released
+ * 
+ * @param pin Simulated line
+ * @return Elapsed cycles, 0 before the release
+ */
+uint64_t dht11_host_pin_elapsed(const struct DHT11HostPin* pin);
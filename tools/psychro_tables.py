@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Generate the psychrometric lookup tables used by psychro.c.
+
+The DHT11 reports whole degrees from 0 to 50 C and whole percent from
+20 to 90 %RH, so every derived value can be computed ahead of time.
+Run from the repository root after changing a formula or range:
+
+    python3 tools/psychro_tables.py
+
+Writes psychro_tables.h and psychro_tables.c; both are committed.
+"""
+
+import math
+import os
+
+TEMP_MIN = 0
+TEMP_MAX = 50
+HUMIDITY_MIN = 20
+HUMIDITY_MAX = 90
+
+# NOAA only applies the regression at 80 F and 40 %RH or more
+HEAT_INDEX_TEMP_MIN = 27
+HEAT_INDEX_HUMIDITY_MIN = 40
+
+# Dew point depression is stored in steps of 1/DEW_POINT_SCALE degree
+DEW_POINT_SCALE = 4
+
+# Magnus coefficients over water (Sonntag 1990)
+MAGNUS_A = 17.62
+MAGNUS_B = 243.12
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+
+def heat_index(temp_c, humidity):
+    """NOAA Rothfusz regression, in degrees Celsius."""
+    t = temp_c * 9.0 / 5.0 + 32.0
+    rh = float(humidity)
+    hi = (-42.379 + 2.04901523 * t + 10.14333127 * rh
+          - 0.22475541 * t * rh - 6.83783e-3 * t * t
+          - 5.481717e-2 * rh * rh + 1.22874e-3 * t * t * rh
+          + 8.5282e-4 * t * rh * rh - 1.99e-6 * t * t * rh * rh)
+    return (hi - 32.0) * 5.0 / 9.0
+
+
+def dew_point(temp_c, humidity):
+    """Magnus approximation, in degrees Celsius."""
+    gamma = math.log(humidity / 100.0) + MAGNUS_A * temp_c / (MAGNUS_B + temp_c)
+    return MAGNUS_B * gamma / (MAGNUS_A - gamma)
+
+
+def saturation_density(temp_c):
+    """Water vapour density of saturated air, in g/m^3."""
+    pressure = 6.112 * math.exp(MAGNUS_A * temp_c / (MAGNUS_B + temp_c))
+    return pressure * 100.0 * 2.1674 / (273.15 + temp_c)
+
+
+def rows(values, per_line, indent):
+    """Format a flat list of integers as C initializer lines."""
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append(indent + ", ".join("%d" % v for v in chunk) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    temps = range(TEMP_MIN, TEMP_MAX + 1)
+    humidities = range(HUMIDITY_MIN, HUMIDITY_MAX + 1)
+
+    heat_rows = []
+    for t in range(HEAT_INDEX_TEMP_MIN, TEMP_MAX + 1):
+        heat_rows.append([round(heat_index(t, rh) * 10)
+                          for rh in range(HEAT_INDEX_HUMIDITY_MIN, HUMIDITY_MAX + 1)])
+
+    dew_rows = []
+    for t in temps:
+        row = []
+        for rh in humidities:
+            depression = round((t - dew_point(t, rh)) * DEW_POINT_SCALE)
+            assert 0 <= depression <= 255
+            row.append(depression)
+        dew_rows.append(row)
+
+    density = [round(saturation_density(t) * 100) for t in temps]
+    assert max(density) <= 0xFFFF
+    assert max(max(r) for r in heat_rows) <= 0xFFFF
+
+    header = """/**
+ * @file psychro_tables.h
+ * @brief Precomputed psychrometric tables
+ * 
+ * Generated by tools/psychro_tables.py, do not edit.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define DHT11_PSYCHRO_TEMP_MIN {temp_min}
+#define DHT11_PSYCHRO_TEMP_MAX {temp_max}
+#define DHT11_PSYCHRO_HUMIDITY_MIN {humidity_min}
+#define DHT11_PSYCHRO_HUMIDITY_MAX {humidity_max}
+#define DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN {hi_temp_min}
+#define DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN {hi_humidity_min}
+#define DHT11_PSYCHRO_DEW_POINT_SCALE {dew_scale}
+
+#define DHT11_PSYCHRO_TEMPS (DHT11_PSYCHRO_TEMP_MAX - DHT11_PSYCHRO_TEMP_MIN + 1)
+#define DHT11_PSYCHRO_HUMIDITIES (DHT11_PSYCHRO_HUMIDITY_MAX - DHT11_PSYCHRO_HUMIDITY_MIN + 1)
+#define DHT11_PSYCHRO_HEAT_INDEX_TEMPS (DHT11_PSYCHRO_TEMP_MAX - DHT11_PSYCHRO_HEAT_INDEX_TEMP_MIN + 1)
+#define DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES (DHT11_PSYCHRO_HUMIDITY_MAX - DHT11_PSYCHRO_HEAT_INDEX_HUMIDITY_MIN + 1)
+
+/** @brief Heat index in tenths of a degree Celsius, where NOAA applies */
+extern const uint16_t dht11_psychro_heat_index[DHT11_PSYCHRO_HEAT_INDEX_TEMPS][DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES];
+
+/** @brief Temperature minus dew point, in steps of 1/DHT11_PSYCHRO_DEW_POINT_SCALE degree */
+extern const uint8_t dht11_psychro_dew_point_depression[DHT11_PSYCHRO_TEMPS][DHT11_PSYCHRO_HUMIDITIES];
+
+/** @brief Saturation vapour density in hundredths of g/m^3 */
+extern const uint16_t dht11_psychro_saturation_density[DHT11_PSYCHRO_TEMPS];
+""".format(
+        temp_min=TEMP_MIN,
+        temp_max=TEMP_MAX,
+        humidity_min=HUMIDITY_MIN,
+        humidity_max=HUMIDITY_MAX,
+        hi_temp_min=HEAT_INDEX_TEMP_MIN,
+        hi_humidity_min=HEAT_INDEX_HUMIDITY_MIN,
+        dew_scale=DEW_POINT_SCALE)
+
+    source = ["""/**
+ * @file psychro_tables.c
+ * @brief Precomputed psychrometric tables
+ * 
+ * Generated by tools/psychro_tables.py, do not edit.
+ */
+
+#include "psychro_tables.h"
+"""]
+
+    source.append("const uint16_t dht11_psychro_heat_index[DHT11_PSYCHRO_HEAT_INDEX_TEMPS]"
+                  "[DHT11_PSYCHRO_HEAT_INDEX_HUMIDITIES] = {")
+    for t, row in zip(range(HEAT_INDEX_TEMP_MIN, TEMP_MAX + 1), heat_rows):
+        source.append("    // %d C" % t)
+        source.append("    {\n" + rows(row, 12, "        ") + "\n    },")
+    source.append("};\n")
+
+    source.append("const uint8_t dht11_psychro_dew_point_depression[DHT11_PSYCHRO_TEMPS]"
+                  "[DHT11_PSYCHRO_HUMIDITIES] = {")
+    for t, row in zip(temps, dew_rows):
+        source.append("    // %d C" % t)
+        source.append("    {\n" + rows(row, 16, "        ") + "\n    },")
+    source.append("};\n")
+
+    source.append("const uint16_t dht11_psychro_saturation_density[DHT11_PSYCHRO_TEMPS] = {")
+    source.append(rows(density, 12, "    "))
+    source.append("};")
+
+    with open(os.path.join(ROOT, "psychro_tables.h"), "w") as f:
+        f.write(header)
+    with open(os.path.join(ROOT, "psychro_tables.c"), "w") as f:
+        f.write("\n".join(source) + "\n")
+
+
+if __name__ == "__main__":
+    main()
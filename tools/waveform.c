@@ -0,0 +1,149 @@
+/**
+ * @file waveform.c
+ * @brief Synthetic and captured DHT waveforms implementation
+ */
+
+#include "waveform.h"
+#include <string.h>
+
+/** @brief traces.bin magic, DHT11_TRACE_LOG_MAGIC in trace_log.h */
+#define DHT11_WAVEFORM_TRACE_MAGIC "DHTT"
+
+/** @brief Supported traces.bin version */
+#define DHT11_WAVEFORM_TRACE_VERSION 2
+
+/** @brief Bytes of a traces.bin record before its trace */
+#define DHT11_WAVEFORM_RECORD_PREFIX 8
+
+/** @brief Cycles per microsecond on the simulated line */
+#define DHT11_WAVEFORM_CYCLES_PER_US (DHT11_WAVEFORM_CLOCK_HZ / 1000000)
+
+/**
+ * @brief traces.bin header, DHT11TraceLogHeader in trace_log.h
+ */
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint8_t version;
+    uint8_t trace_length;
+    uint16_t record_size;
+    uint32_t clock_hz;
+    uint8_t reserved[4];
+} DHT11WaveformTraceHeader;
+
+uint32_t dht11_waveform_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void dht11_waveform_generate(DHT11Waveform* waveform, const uint8_t* data) {
+    uint8_t n = 0;
+    waveform->phases[n++] = DHT11_WAVEFORM_WAIT_US * DHT11_WAVEFORM_CYCLES_PER_US;
+    waveform->phases[n++] = DHT11_WAVEFORM_RESPONSE_US * DHT11_WAVEFORM_CYCLES_PER_US;
+    waveform->phases[n++] = DHT11_WAVEFORM_RESPONSE_US * DHT11_WAVEFORM_CYCLES_PER_US;
+    
+    for(uint8_t i = 0; i < DHT11_BIT_COUNT; i++) {
+        bool one = data[i / 8] & (1 << (7 - (i % 8)));
+        waveform->phases[n++] = DHT11_WAVEFORM_BIT_LOW_US * DHT11_WAVEFORM_CYCLES_PER_US;
+        waveform->phases[n++] = (one ? DHT11_WAVEFORM_ONE_US : DHT11_WAVEFORM_ZERO_US) * DHT11_WAVEFORM_CYCLES_PER_US;
+    }
+    
+    waveform->phases[n++] = DHT11_WAVEFORM_BIT_LOW_US * DHT11_WAVEFORM_CYCLES_PER_US;
+    waveform->count = n;
+    waveform->known = true;
+    memcpy(waveform->data, data, sizeof(waveform->data));
+}
+
+void dht11_waveform_random_data(uint8_t* data, uint16_t high_weight, uint32_t* state) {
+    uint16_t humidity = 200 + dht11_waveform_random(state) % 701;
+    uint16_t temperature = dht11_waveform_random(state) % 501;
+    data[0] = humidity / high_weight;
+    data[1] = humidity % high_weight;
+    data[2] = temperature / high_weight;
+    data[3] = temperature % high_weight;
+    data[4] = data[0] + data[1] + data[2] + data[3];
+}
+
+void dht11_waveform_perturb(
+    const DHT11Waveform* in,
+    DHT11Waveform* out,
+    const DHT11WaveformNoise* noise,
+    uint32_t* state) {
+    const int64_t min = DHT11_WAVEFORM_CYCLES_PER_US;
+    int64_t jitter = (int64_t)noise->jitter_us * DHT11_WAVEFORM_CYCLES_PER_US;
+    int64_t skew = (int64_t)noise->skew_us * DHT11_WAVEFORM_CYCLES_PER_US;
+    DHT11Waveform result = *in;
+    
+    for(uint8_t i = 0; i < result.count; i++) {
+        int64_t length = result.phases[i];
+        length += (i % 2 == 0) ? skew : -skew;
+        if(jitter > 0) {
+            length += (int64_t)(dht11_waveform_random(state) % (2 * jitter + 1)) - jitter;
+        }
+        result.phases[i] = length < min ? min : length;
+    }
+    
+    // Edge i ends phase i; losing it and the next one merges three phases
+    for(uint8_t i = 0; noise->drop_permille > 0 && i + 2 < result.count; i++) {
+        if(dht11_waveform_random(state) % 1000 < noise->drop_permille) {
+            result.phases[i] += result.phases[i + 1] + result.phases[i + 2];
+            memmove(&result.phases[i + 1], &result.phases[i + 3], (result.count - i - 3) * sizeof(uint32_t));
+            result.count -= 2;
+        }
+    }
+    
+    *out = result;
+}
+
+bool dht11_waveform_read_header(FILE* file, uint32_t* clock_hz, uint16_t* record_size) {
+    DHT11WaveformTraceHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, DHT11_WAVEFORM_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != DHT11_WAVEFORM_TRACE_VERSION || header.trace_length != DHT11_TRACE_LENGTH ||
+       header.record_size < DHT11_WAVEFORM_RECORD_PREFIX + DHT11_TRACE_LENGTH * sizeof(uint16_t) ||
+       header.clock_hz < 1000000) {
+        return false;
+    }
+    
+    *clock_hz = header.clock_hz;
+    *record_size = header.record_size;
+    return true;
+}
+
+bool dht11_waveform_read_record(
+    FILE* file,
+    uint32_t clock_hz,
+    uint16_t record_size,
+    uint8_t threshold_us,
+    DHT11Waveform* waveform) {
+    uint8_t record[512];
+    if(record_size > sizeof(record)) {
+        return false;
+    }
+    
+    while(fread(record, record_size, 1, file) == 1) {
+        DHT11Transfer transfer = {0};
+        transfer.trace_length = record[5];
+        memcpy(transfer.trace, record + DHT11_WAVEFORM_RECORD_PREFIX, sizeof(transfer.trace));
+        if(transfer.trace_length < DHT11_TRACE_LENGTH) {
+            continue;
+        }
+        
+        // Ground truth, if the capture itself was a good read
+        dht11_decoder_decode(&transfer, threshold_us * (clock_hz / 1000000));
+        waveform->known = transfer.status == DHT11StatusOk;
+        memcpy(waveform->data, transfer.data, sizeof(waveform->data));
+        
+        for(uint8_t i = 0; i < DHT11_TRACE_LENGTH; i++) {
+            waveform->phases[i] = (uint64_t)transfer.trace[i] * DHT11_WAVEFORM_CLOCK_HZ / clock_hz;
+        }
+        waveform->phases[DHT11_TRACE_LENGTH] = DHT11_WAVEFORM_BIT_LOW_US * DHT11_WAVEFORM_CYCLES_PER_US;
+        waveform->count = DHT11_WAVEFORM_PHASES;
+        return true;
+    }
+    
+    return false;
+}
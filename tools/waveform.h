@@ -0,0 +1,136 @@
+/**
+ * @file waveform.h
+ * @brief Synthetic and captured DHT waveforms for the host harness
+ * 
+ * A waveform is the list of phases the data line goes through after the
+ * host releases it, as cycle counts at DHT11_WAVEFORM_CLOCK_HZ: the wait
+ * for the response, the response low and high phases, a low and a high
+ * phase per data bit and the final low phase before the sensor lets go.
+ * Phases alternate between high and low, starting high. Waveforms are
+ * either generated from five data bytes or taken from the records of a
+ * traces.bin file, and can then be distorted the way long cables, weak
+ * pull-ups and interference distort them on the bench.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "decoder.h"
+
+/** @brief Cycle counter frequency of the simulated line, the Flipper's core clock */
+#define DHT11_WAVEFORM_CLOCK_HZ 64000000
+
+/** @brief Most phases in a waveform: every traced phase and the final low */
+#define DHT11_WAVEFORM_PHASES (DHT11_TRACE_LENGTH + 1)
+
+/** @brief Nominal wait from the release of the line to the response */
+#define DHT11_WAVEFORM_WAIT_US 30
+
+/** @brief Nominal response low and high phases */
+#define DHT11_WAVEFORM_RESPONSE_US 80
+
+/** @brief Nominal low phase before every bit and at the end */
+#define DHT11_WAVEFORM_BIT_LOW_US 50
+
+/** @brief Nominal high phase of a '0' bit */
+#define DHT11_WAVEFORM_ZERO_US 27
+
+/** @brief Nominal high phase of a '1' bit */
+#define DHT11_WAVEFORM_ONE_US 70
+
+/**
+ * @brief Phases of one transaction
+ */
+typedef struct {
+    uint32_t phases[DHT11_WAVEFORM_PHASES]; /**< Cycle length of each phase, the first one high */
+    uint8_t count;                          /**< Number of phases */
+    bool known;                             /**< data holds what the waveform encodes */
+    uint8_t data[5];                        /**< Encoded bytes, checksum last, valid if known */
+} DHT11Waveform;
+
+/**
+ * @brief Distortions applied to a waveform
+ */
+typedef struct {
+    uint32_t jitter_us;         /**< Each phase moves by up to this much either way */
+    int32_t skew_us;            /**< Added to every high phase and taken from every low one */
+    uint32_t drop_permille;     /**< Chance per edge, in thousandths, that a pulse is missed */
+} DHT11WaveformNoise;
+
+/**
+ * @brief Next value of a xorshift generator, so runs repeat for a seed
+ * 
+ * @param state Generator state, never 0
+ * @return Pseudo-random value
+ */
+uint32_t dht11_waveform_random(uint32_t* state);
+
+/**
+ * @brief Build the nominal waveform of five data bytes
+ * 
+ * @param waveform Output waveform
+ * @param data Bytes to encode, the last one is sent as is
+ */
+void dht11_waveform_generate(DHT11Waveform* waveform, const uint8_t* data);
+
+/**
+ * @brief Pick random plausible readings with a matching checksum
+ * 
+ * Humidity is 20-90% and temperature 0-50C, both in tenths.
+ * 
+ * @param data Output for five data bytes
+ * @param high_weight Weight of a value's high byte in tenths, from the family
+ * @param state Generator state
+ */
+void dht11_waveform_random_data(uint8_t* data, uint16_t high_weight, uint32_t* state);
+
+/**
+ * @brief Distort a waveform
+ * 
+ * A dropped edge takes the following one with it, as when a short pulse
+ * is lost: the phases on either side merge, so the line levels after it
+ * stay in step. No phase is made shorter than 1us.
+ * 
+ * @param in Waveform to distort
+ * @param out Output waveform, may be in
+ * @param noise Distortions to apply
+ * @param state Generator state
+ */
+void dht11_waveform_perturb(
+    const DHT11Waveform* in,
+    DHT11Waveform* out,
+    const DHT11WaveformNoise* noise,
+    uint32_t* state);
+
+/**
+ * @brief Check the header of a traces.bin file
+ * 
+ * @param file File positioned at its start
+ * @param clock_hz Output for the cycle counter frequency of the capture
+ * @param record_size Output for the size of one record
+ * @return false if the file is not a supported trace log
+ */
+bool dht11_waveform_read_header(FILE* file, uint32_t* clock_hz, uint16_t* record_size);
+
+/**
+ * @brief Read the next complete transaction of a traces.bin file
+ * 
+ * Records of transactions that did not receive all 40 bits are skipped.
+ * Phases are rescaled to DHT11_WAVEFORM_CLOCK_HZ. The bytes are known if
+ * the recorded trace decodes with a matching checksum at threshold_us.
+ * 
+ * @param file File positioned after the header or a record
+ * @param clock_hz Cycle counter frequency of the capture
+ * @param record_size Size of one record
+ * @param threshold_us Threshold the recorded trace is decoded with
+ * @param waveform Output waveform
+ * @return false at the end of the file
+ */
+bool dht11_waveform_read_record(
+    FILE* file,
+    uint32_t clock_hz,
+    uint16_t record_size,
+    uint8_t threshold_us,
+    DHT11Waveform* waveform);
@@ -0,0 +1,63 @@
+/**
+ * @file trace_log.c
+ * @brief Binary edge-timing trace export implementation
+ */
+
+#include "trace_log.h"
+#include <furi_hal.h>
+
+DHT11TraceLog* dht11_trace_log_open(const char* path) {
+    DHT11TraceLog* log = malloc(sizeof(DHT11TraceLog));
+    log->storage = furi_record_open(RECORD_STORAGE);
+    log->file = storage_file_alloc(log->storage);
+    log->records = 0;
+    
+    bool ok = storage_file_open(log->file, path, FSAM_WRITE, FSOM_OPEN_APPEND);
+    
+    if(ok && storage_file_size(log->file) == 0) {
+        DHT11TraceLogHeader header = {0};
+        memcpy(header.magic, DHT11_TRACE_LOG_MAGIC, sizeof(header.magic));
+        header.version = DHT11_TRACE_LOG_VERSION;
+        header.trace_length = DHT11_TRACE_LENGTH;
+        header.record_size = sizeof(DHT11TraceLogRecord);
+        header.clock_hz = SystemCoreClock;
+        ok = storage_file_write(log->file, &header, sizeof(header)) == sizeof(header);
+    }
+    
+    if(!ok) {
+        FURI_LOG_E("DHT11", "Failed to open trace log %s", path);
+        dht11_trace_log_close(log);
+        return NULL;
+    }
+    
+    return log;
+}
+
+void dht11_trace_log_close(DHT11TraceLog* log) {
+    furi_assert(log);
+    storage_file_close(log->file);
+    storage_file_free(log->file);
+    furi_record_close(RECORD_STORAGE);
+    free(log);
+}
+
+bool dht11_trace_log_append(
+    DHT11TraceLog* log,
+    uint32_t tick,
+    const char* pin_name,
+    const DHT11Transfer* transfer) {
+    furi_assert(log);
+    
+    DHT11TraceLogRecord record;
+    record.tick = tick;
+    record.status = transfer->status;
+    record.trace_length = transfer->trace_length;
+    memcpy(record.pin, pin_name, sizeof(record.pin));
+    memcpy(record.trace, transfer->trace, sizeof(record.trace));
+    
+    if(storage_file_write(log->file, &record, sizeof(record)) != sizeof(record)) {
+        return false;
+    }
+    log->records++;
+    return true;
+}
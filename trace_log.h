@@ -0,0 +1,87 @@
+/**
+ * @file trace_log.h
+ * @brief Binary edge-timing trace export to the SD card
+ * 
+ * Appends the raw cycle deltas of every transaction to a compact binary
+ * file for offline waveform analysis. The file starts with a single
+ * header followed by fixed-size records.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include "decoder.h"
+
+/** @brief Default trace file location */
+#define DHT11_TRACE_LOG_PATH APP_DATA_PATH("traces.bin")
+
+/** @brief File format magic */
+#define DHT11_TRACE_LOG_MAGIC "DHTT"
+
+/** @brief File format version */
+#define DHT11_TRACE_LOG_VERSION 2
+
+/**
+ * @brief Trace file header, written once at the start of the file
+ */
+typedef struct FURI_PACKED {
+    char magic[4];                  /**< DHT11_TRACE_LOG_MAGIC */
+    uint8_t version;                /**< DHT11_TRACE_LOG_VERSION */
+    uint8_t trace_length;           /**< Cycle deltas per record */
+    uint16_t record_size;           /**< Size of one record in bytes */
+    uint32_t clock_hz;              /**< Cycle counter frequency */
+    uint8_t reserved[4];            /**< Zero */
+} DHT11TraceLogHeader;
+
+/**
+ * @brief One recorded transaction
+ */
+typedef struct FURI_PACKED {
+    uint32_t tick;                          /**< System tick at the start of the transaction */
+    uint8_t status;                         /**< DHT11Status of the transaction */
+    uint8_t trace_length;                   /**< Number of valid entries in trace */
+    char pin[2];                            /**< Name of the sensor's data pin */
+    uint16_t trace[DHT11_TRACE_LENGTH];     /**< Cycle delta of each phase */
+} DHT11TraceLogRecord;
+
+/**
+ * @brief Open trace file
+ */
+typedef struct {
+    Storage* storage;       /**< Storage service */
+    File* file;             /**< Trace file, open for appending */
+    uint32_t records;       /**< Records written since the file was opened */
+} DHT11TraceLog;
+
+/**
+ * @brief Open or create a trace file for appending
+ * 
+ * Writes the header if the file is new.
+ * 
+ * @param path File path
+ * @return Pointer to the trace log, or NULL if the file could not be opened
+ */
+DHT11TraceLog* dht11_trace_log_open(const char* path);
+
+/**
+ * @brief Close the trace file
+ * 
+ * @param log Pointer to the trace log
+ */
+void dht11_trace_log_close(DHT11TraceLog* log);
+
+/**
+ * @brief Append one transaction
+ * 
+ * @param log Pointer to the trace log
+ * @param tick System tick at the start of the transaction
+ * @param pin_name Name of the data pin the transaction ran on
+ * @param transfer Transfer record to store
+ * @return true if the record was written
+ */
+bool dht11_trace_log_append(
+    DHT11TraceLog* log,
+    uint32_t tick,
+    const char* pin_name,
+    const DHT11Transfer* transfer);
@@ -0,0 +1,181 @@
+/**
+ * @file usb_stream.c
+ * @brief Binary transaction streaming implementation
+ */
+
+#include "usb_stream.h"
+#include "timing.h"
+
+#define DHT11_USB_STREAM_STACK_SIZE 1024
+
+/** @brief Longest wait for a frame before the stop flag is checked again */
+#define DHT11_USB_STREAM_POLL_MS 100
+
+/** @brief Worker thread flags */
+typedef enum {
+    DHT11UsbStreamFlagStop = (1 << 0),      /**< Exit the worker */
+    DHT11UsbStreamFlagTxDone = (1 << 1),    /**< The host took the last packet */
+} DHT11UsbStreamFlag;
+
+/**
+ * @brief CDC transmit complete, called from the USB interrupt
+ * 
+ * @param context Pointer to the stream
+ */
+static void dht11_usb_stream_tx_callback(void* context) {
+    DHT11UsbStream* stream = context;
+    furi_thread_flags_set(furi_thread_get_id(stream->thread), DHT11UsbStreamFlagTxDone);
+}
+
+/**
+ * @brief Track whether a host has opened the port
+ * 
+ * @param context Pointer to the stream
+ * @param ctrl_lines Control line state set by the host
+ */
+static void dht11_usb_stream_ctrl_line_callback(void* context, CdcCtrlLine ctrl_lines) {
+    DHT11UsbStream* stream = context;
+    stream->connected = (ctrl_lines & CdcCtrlLineDTR) != 0;
+}
+
+static CdcCallbacks dht11_usb_stream_callbacks = {
+    .tx_ep_callback = dht11_usb_stream_tx_callback,
+    .rx_ep_callback = NULL,
+    .state_callback = NULL,
+    .ctrl_line_callback = dht11_usb_stream_ctrl_line_callback,
+    .config_callback = NULL,
+};
+
+/**
+ * @brief Send one frame, one USB packet at a time
+ * 
+ * A frame the host stops taking halfway is abandoned; the host finds the
+ * next frame by its sync word.
+ * 
+ * @param frame Frame to send
+ * @return true if the whole frame was taken by the host
+ */
+static bool dht11_usb_stream_send(DHT11UsbStreamFrame* frame) {
+    uint8_t* data = (uint8_t*)frame;
+    size_t length = frame->header.size;
+    
+    for(size_t offset = 0; offset < length; offset += CDC_DATA_SZ) {
+        furi_thread_flags_clear(DHT11UsbStreamFlagTxDone);
+        furi_hal_cdc_send(DHT11_USB_STREAM_INTERFACE, data + offset, MIN(length - offset, (size_t)CDC_DATA_SZ));
+        
+        uint32_t flags = furi_thread_flags_wait(
+            DHT11UsbStreamFlagTxDone, FuriFlagWaitAny, furi_ms_to_ticks(DHT11_USB_STREAM_TX_TIMEOUT_MS));
+        if(flags & FuriFlagError) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Worker thread, the only place that waits for the host
+ * 
+ * @param context Pointer to the stream
+ * @return Thread exit code
+ */
+static int32_t dht11_usb_stream_worker(void* context) {
+    DHT11UsbStream* stream = context;
+    DHT11UsbStreamFrame frame;
+    
+    while(!(furi_thread_flags_get() & DHT11UsbStreamFlagStop)) {
+        if(furi_message_queue_get(stream->queue, &frame, furi_ms_to_ticks(DHT11_USB_STREAM_POLL_MS)) !=
+           FuriStatusOk) {
+            continue;
+        }
+        
+        // Without a host nothing would ever complete; drop instead of timing out per frame
+        if(stream->connected && dht11_usb_stream_send(&frame)) {
+            stream->sent++;
+        } else {
+            stream->unsent++;
+        }
+    }
+    
+    return 0;
+}
+
+DHT11UsbStream* dht11_usb_stream_open(DHT11UsbStreamMode mode) {
+    furi_assert(mode != DHT11UsbStreamModeOff);
+    
+    DHT11UsbStream* stream = malloc(sizeof(DHT11UsbStream));
+    stream->mode = mode;
+    stream->connected = false;
+    stream->sequence = 0;
+    stream->overflowed = 0;
+    stream->sent = 0;
+    stream->unsent = 0;
+    
+    // Keep the CLI on the first interface and stream on the second
+    stream->usb_previous = furi_hal_usb_get_config();
+    furi_hal_usb_unlock();
+    if(!furi_hal_usb_set_config(&usb_cdc_dual, NULL)) {
+        FURI_LOG_E("DHT11", "Failed to switch USB to dual CDC");
+        free(stream);
+        return NULL;
+    }
+    
+    stream->queue = furi_message_queue_alloc(DHT11_USB_STREAM_QUEUE_LENGTH, sizeof(DHT11UsbStreamFrame));
+    stream->thread = furi_thread_alloc_ex(
+        "Dht11UsbStream", DHT11_USB_STREAM_STACK_SIZE, dht11_usb_stream_worker, stream);
+    
+    // The callbacks need the thread id, so they go in after allocation
+    furi_thread_start(stream->thread);
+    furi_hal_cdc_set_callbacks(DHT11_USB_STREAM_INTERFACE, &dht11_usb_stream_callbacks, stream);
+    
+    return stream;
+}
+
+void dht11_usb_stream_close(DHT11UsbStream* stream) {
+    furi_assert(stream);
+    
+    furi_hal_cdc_set_callbacks(DHT11_USB_STREAM_INTERFACE, NULL, NULL);
+    furi_thread_flags_set(furi_thread_get_id(stream->thread), DHT11UsbStreamFlagStop);
+    furi_thread_join(stream->thread);
+    furi_thread_free(stream->thread);
+    furi_message_queue_free(stream->queue);
+    
+    furi_hal_usb_set_config(stream->usb_previous, NULL);
+    free(stream);
+}
+
+bool dht11_usb_stream_push(
+    DHT11UsbStream* stream,
+    uint32_t tick,
+    uint8_t sensor,
+    uint8_t protocol,
+    const DHT11Transfer* transfer) {
+    furi_assert(stream);
+    
+    DHT11UsbStreamFrame frame;
+    DHT11UsbStreamHeader* header = &frame.header;
+    bool timings = stream->mode == DHT11UsbStreamModeTimings;
+    
+    header->sync = DHT11_USB_STREAM_SYNC;
+    header->version = DHT11_USB_STREAM_VERSION;
+    header->size = timings ? sizeof(DHT11UsbStreamFrame) : sizeof(DHT11UsbStreamHeader);
+    header->sequence = stream->sequence++;
+    header->tick = tick;
+    header->sensor = sensor;
+    header->protocol = protocol;
+    header->status = transfer->status;
+    header->trace_length = timings ? transfer->trace_length : 0;
+    header->cycles_per_us = dht11_timing.cycles_per_us;
+    memcpy(header->data, transfer->data, sizeof(header->data));
+    if(timings) {
+        memcpy(frame.trace, transfer->trace, sizeof(frame.trace));
+    }
+    
+    // Never wait here: this runs on the read path
+    if(furi_message_queue_put(stream->queue, &frame, 0) != FuriStatusOk) {
+        stream->overflowed++;
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file usb_stream.h
+ * @brief Binary transaction streaming over USB CDC
+ * 
+ * Every transaction, normal or debug, is packed into a fixed-size binary
+ * frame and queued from the read path without waiting. A worker thread
+ * sends the queued frames on the second CDC interface of the dual-port
+ * USB configuration, leaving the CLI on the first. The reader never
+ * blocks: when the host does not keep up, the queue fills and new frames
+ * are dropped and counted, showing up on the host as sequence gaps.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal.h>
+#include "decoder.h"
+
+/** @brief CDC interface the frames are sent on */
+#define DHT11_USB_STREAM_INTERFACE 1
+
+/** @brief Frames buffered between the read path and the worker */
+#define DHT11_USB_STREAM_QUEUE_LENGTH 16
+
+/** @brief Time the host is given to take one USB packet before the frame is dropped */
+#define DHT11_USB_STREAM_TX_TIMEOUT_MS 50
+
+/** @brief Frame sync word, sent little-endian as A5 D7 */
+#define DHT11_USB_STREAM_SYNC 0xD7A5
+
+/** @brief Frame format version */
+#define DHT11_USB_STREAM_VERSION 1
+
+/**
+ * @brief What each frame carries
+ */
+typedef enum {
+    DHT11UsbStreamModeOff,          /**< Not streaming */
+    DHT11UsbStreamModeData,         /**< Header with the raw data bytes only */
+    DHT11UsbStreamModeTimings,      /**< Header followed by the full edge trace */
+} DHT11UsbStreamMode;
+
+/**
+ * @brief Frame header, all a frame holds in DHT11UsbStreamModeData
+ */
+typedef struct FURI_PACKED {
+    uint16_t sync;                  /**< DHT11_USB_STREAM_SYNC */
+    uint8_t version;                /**< DHT11_USB_STREAM_VERSION */
+    uint8_t size;                   /**< Frame size in bytes, header included */
+    uint32_t sequence;              /**< Transactions streamed since start, dropped ones included */
+    uint32_t tick;                  /**< System tick at the start of the transaction */
+    uint8_t sensor;                 /**< Sensor index */
+    uint8_t protocol;               /**< DHT11ProtocolType of the sensor */
+    uint8_t status;                 /**< DHT11Status of the transaction */
+    uint8_t trace_length;           /**< Cycle deltas following the header, 0 without timings */
+    uint8_t cycles_per_us;          /**< Cycle counter ticks per microsecond */
+    uint8_t data[5];                /**< Received bytes, checksum last */
+} DHT11UsbStreamHeader;
+
+/**
+ * @brief A frame with timings
+ */
+typedef struct FURI_PACKED {
+    DHT11UsbStreamHeader header;            /**< Frame header */
+    uint16_t trace[DHT11_TRACE_LENGTH];     /**< Cycle delta of each phase */
+} DHT11UsbStreamFrame;
+
+/**
+ * @brief Running stream
+ */
+typedef struct {
+    FuriThread* thread;                 /**< Worker sending the frames */
+    FuriMessageQueue* queue;            /**< Frames waiting to be sent */
+    FuriHalUsbInterface* usb_previous;  /**< USB configuration to restore on close */
+    DHT11UsbStreamMode mode;            /**< Frame contents */
+    volatile bool connected;            /**< Host has the port open (DTR set) */
+    volatile uint32_t sequence;         /**< Frames offered so far, read path only */
+    volatile uint32_t overflowed;       /**< Frames dropped on a full queue, read path only */
+    volatile uint32_t sent;             /**< Frames completely sent, worker only */
+    volatile uint32_t unsent;           /**< Frames dropped by the worker: slow host or no host */
+} DHT11UsbStream;
+
+/**
+ * @brief Switch the USB port to dual CDC and start streaming
+ * 
+ * @param mode Frame contents, not DHT11UsbStreamModeOff
+ * @return Pointer to the stream, or NULL if the USB configuration could not be changed
+ */
+DHT11UsbStream* dht11_usb_stream_open(DHT11UsbStreamMode mode);
+
+/**
+ * @brief Stop streaming and restore the previous USB configuration
+ * 
+ * Frames still queued are discarded.
+ * 
+ * @param stream Pointer to the stream
+ */
+void dht11_usb_stream_close(DHT11UsbStream* stream);
+
+/**
+ * @brief Queue one transaction for sending
+ * 
+ * Never blocks; if the queue is full the frame is dropped and counted.
+ * 
+ * @param stream Pointer to the stream
+ * @param tick System tick at the start of the transaction
+ * @param sensor Sensor index
+ * @param protocol DHT11ProtocolType of the sensor
+ * @param transfer Decoded transfer record
+ * @return true if the frame was queued
+ */
+bool dht11_usb_stream_push(
+    DHT11UsbStream* stream,
+    uint32_t tick,
+    uint8_t sensor,
+    uint8_t protocol,
+    const DHT11Transfer* transfer);